@@ -19,6 +19,27 @@ if( LIBAKRYPT_HAVE_BUILTIN_MULQ_GCC )
     set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DLIBAKRYPT_HAVE_BUILTIN_MULQ_GCC" )
 endif()
 
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <sys/types.h>
+  int main( void ) {
+    #if defined( __x86_64__ )
+      u_int64_t lo, hi, u = 1, v = 2;
+      __builtin_cpu_init();
+      if( __builtin_cpu_supports( \"bmi2\" ) && __builtin_cpu_supports( \"adx\" ))
+        __asm__ (\"movq %2, %%rdx; xorl %k1, %k1; mulxq %3, %0, %1; adcxq %0, %1; adoxq %0, %1\"
+                 : \"=&r\" (lo), \"=&r\" (hi) : \"r\" (u), \"rm\" (v) : \"rdx\", \"cc\" );
+      return 0;
+    #else
+      #error Unsupported architecture
+    #endif
+  }" LIBAKRYPT_HAVE_BUILTIN_MULX_ADX )
+
+if( LIBAKRYPT_HAVE_BUILTIN_MULX_ADX )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DLIBAKRYPT_HAVE_BUILTIN_MULX_ADX" )
+endif()
+
 # -------------------------------------------------------------------------------------------------- #
 # -------------------------------------------------------------------------------------------------- #
 check_c_source_compiles("
@@ -34,3 +55,40 @@ check_c_source_compiles("
 if( LIBAKRYPT_HAVE_BUILTIN_CLMULEPI64 )
     set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DLIBAKRYPT_HAVE_BUILTIN_CLMULEPI64" )
 endif()
+
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <immintrin.h>
+  __attribute__(( target( \"avx512f,avx512ifma\" )))
+  static long long madd( long long x ) {
+   __m512i a = _mm512_set1_epi64( x ), b = _mm512_set1_epi64( 3 );
+   a = _mm512_madd52hi_epu64( _mm512_madd52lo_epu64( a, a, b ), a, b );
+  return _mm512_reduce_add_epi64( _mm512_srai_epi64( a, 52 ));
+  }
+  int main( void ) {
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports( \"avx512ifma\" )) return ( int ) madd( 5 );
+  return 0;
+ }" LIBAKRYPT_HAVE_BUILTIN_MADD52 )
+
+if( LIBAKRYPT_HAVE_BUILTIN_MADD52 )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DLIBAKRYPT_HAVE_BUILTIN_MADD52" )
+endif()
+
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  int main( void ) {
+   long value = 8, expected = 8;
+   long long option = 0;
+
+    __atomic_compare_exchange_n( &value, &expected, 4, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED );
+    __atomic_fetch_add( &value, 1, __ATOMIC_ACQ_REL );
+    __atomic_store_n( &option, 5, __ATOMIC_RELAXED );
+  return ( int ) __atomic_load_n( &value, __ATOMIC_ACQUIRE ) - ( int ) __atomic_load_n( &option, __ATOMIC_RELAXED );
+ }" LIBAKRYPT_HAVE_BUILTIN_ATOMIC_GCC )
+
+if( LIBAKRYPT_HAVE_BUILTIN_ATOMIC_GCC )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DLIBAKRYPT_HAVE_BUILTIN_ATOMIC_GCC" )
+endif()
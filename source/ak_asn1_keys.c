@@ -74,8 +74,8 @@
     ak_asn1_context_delete( content );
     return ak_error_message( error, __func__, "incorrect adding data storage identifier" );
   }
-  if(( error = ak_asn1_context_add_uint32( content,
-                  ( ak_uint32 )ak_libakrypt_get_option( "openssl_compability" ))) != ak_error_ok ) {
+  if(( error = ak_asn1_context_add_uint32( content, ( ak_uint32 )
+                        ak_libakrypt_get_option_by_index( ak_option_openssl_compability ) )) != ak_error_ok ) {
     ak_asn1_context_delete( content );
     return ak_error_message( error, __func__, "incorrect adding data storage identifier" );
   }
@@ -194,7 +194,7 @@
                   pass_size,                                 /* размер пароля */
                   salt,                           /* инициализационный вектор */
                   sizeof( salt ),        /* размер инициализационного вектора */
-                  (size_t) ak_libakrypt_get_option( "pbkdf2_iteration_count" ),
+                  (size_t) ak_libakrypt_get_option_by_index( ak_option_pbkdf2_iteration_count ),
                   64,                         /* размер вырабатываемого ключа */
                   derived_key                   /* массив для хранения данных */
      )) != ak_error_ok ) {
@@ -228,8 +228,8 @@
    }
    ak_asn1_context_add_oid( asn3, ak_oid_context_find_by_name( "hmac-streebog512" )->id );
    ak_asn1_context_add_octet_string( asn3, salt, sizeof( salt ));
-   ak_asn1_context_add_uint32( asn3,
-                                 ( ak_uint32 )ak_libakrypt_get_option( "pbkdf2_iteration_count" ));
+   ak_asn1_context_add_uint32( asn3, ( ak_uint32 )
+                                ak_libakrypt_get_option_by_index( ak_option_pbkdf2_iteration_count ));
 
    if(( ak_asn1_context_create( asn2 = malloc( sizeof( struct asn1 )))) != ak_error_ok ) {
      ak_bckey_context_destroy( ikey );
@@ -1195,7 +1195,7 @@
    if(( DATA_STRUCTURE( asn->current->tag ) != PRIMITIVE ) ||
             ( TAG_NUMBER( asn->current->tag ) != TINTEGER )) return ak_error_invalid_asn1_tag;
    ak_tlv_context_get_uint32( asn->current, &u32 );  /* теперь u32 содержит флаг совместимости с openssl */
-   if( u32 !=  (oc = ( ak_uint32 )ak_libakrypt_get_option( "openssl_compability" ))) /* текущее значение */
+   if( u32 != ( oc = ( ak_uint32 )ak_libakrypt_get_option_by_index( ak_option_openssl_compability ) ))
      ak_libakrypt_set_openssl_compability( u32 );
 
   /* расшифровываем и проверяем имитовставку */
@@ -1751,15 +1751,19 @@
   ak_mpzn_set_little_endian( vkey->qpoint.x, val, ptr, val64, ak_false );
   ak_mpzn_set_little_endian( vkey->qpoint.y, val, ((ak_uint8*)ptr)+val64, val64, ak_false );
   ak_mpzn_set_ui( vkey->qpoint.z, val, 1 );
-  if( ak_wpoint_is_ok( &vkey->qpoint, vkey->wc ) != ak_true ) {
-    ak_error_message_fmt( error = ak_error_curve_point, __func__ ,
-                                                  "the public key isn't on given elliptic curve" );
+ /* проверка порядка точки выполняется один раз для каждого ключа, результат хранится в кэше */
+  vkey->flags = ak_key_flag_set_key;
+  if(( error = ak_verifykey_context_validate( vkey )) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "the public key isn't valid point of given elliptic curve" );
+    goto lab1;
+  }
+ /* вычисляем таблицу нечетных кратных, используемую при проверке подписи */
+  if(( error = ak_verifykey_context_precompute_table( vkey )) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "incorrect computation of public key table" );
     goto lab1;
   }
 
- /* устанавливаем флаг и выходим */
-  vkey->flags = ak_key_flag_set_key;
-
+ /* выходим */
   if( asnl1 != NULL ) ak_asn1_context_delete( asnl1 );
  return ak_error_ok;
 
@@ -19,6 +19,12 @@
 #else
  #error Library cannot be compiled without string.h header
 #endif
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+ #include <pthread.h>
+#endif
+#ifdef LIBAKRYPT_HAVE_SYSMMAN_H
+ #include <sys/mman.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция устанавливает параметры алгоритма блочного шифрования, передаваемые в качестве
@@ -29,6 +35,7 @@
     - bkey.decrypt -- алгоритм расшифрования одного блока
     - bkey.shedule_keys -- алгоритм развертки ключа и генерации раундовых ключей
     - bkey.delete_keys -- функция удаления раундовых ключей
+    - bkey.clone_keys -- функция копирования раундовых ключей
 
     Следующие поля принимают значения по-умолчанию
     - bkey.key.data -- указатель на служебную область памяти
@@ -68,6 +75,7 @@
   bkey->decrypt =       NULL;
   bkey->schedule_keys = NULL;
   bkey->delete_keys =   NULL;
+  bkey->clone_keys =    NULL;
 
  return ak_error_ok;
 }
@@ -102,6 +110,7 @@
   bkey->decrypt =       NULL;
   bkey->schedule_keys = NULL;
   bkey->delete_keys =   NULL;
+  bkey->clone_keys =    NULL;
 
  return error;
 }
@@ -182,7 +191,7 @@
                                        "using a constant value for secret key with wrong length" );
 
  /* дополнительный переворот ключа для алгоритма Магма (в режиме совместимости с openssl) */
-  if(( ak_libakrypt_get_option( "openssl_compability" ) == 1 ) &&
+  if(( ak_libakrypt_get_option_by_index( ak_option_openssl_compability ) == 1 ) &&
                                         ( strncmp( bkey->key.oid->names[0], "magma", 5 ) == 0 )) {
     int i = 0;
     ak_uint8 revkey[32];
@@ -328,6 +337,408 @@
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция создает в контексте `dst` копию ключа `src`, не выполняя процедуру развертки ключа.
+    Копируются маскированное значение ключа, развернутые раундовые ключи, текущее значение
+    синхропосылки, ресурс и методы ключа. Маски ключа и развернутых ключей у копии
+    сменяются на новые.
+
+    Функция предназначена для быстрого получения рабочих контекстов из заранее подготовленного
+    шаблона. Копия получает собственный счетчик ресурса, равный текущему значению ресурса
+    исходного ключа; для совместного использования ресурса несколькими потоками
+    следует применять функцию ak_bckey_context_clone_shared().
+
+    @param dst Контекст ключа, в который помещается копия. Контекст не должен быть
+    инициализирован ранее.
+    @param src Контекст копируемого ключа; ключу должно быть присвоено значение.
+    @return Функция возвращает код ошибки. В случае успеха возвращается \ref ak_error_ok (ноль).   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_context_clone( ak_bckey dst, ak_bckey src )
+{
+  int error = ak_error_ok;
+
+  if( dst == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                      "using a null pointer to destination block cipher context" );
+  if( src == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                           "using a null pointer to source block cipher context" );
+  if( !(( src->key.flags )&ak_key_flag_set_key )) return ak_error_message( ak_error_key_value,
+                                             __func__ , "using source key with unassigned value" );
+  if( src->key.check_icode( &src->key ) != ak_true )
+    return ak_error_message( ak_error_wrong_key_icode,
+                                         __func__, "using source key with wrong integrity code" );
+ /* копируем секретный ключ */
+  if(( error = ak_skey_context_clone( &dst->key, &src->key )) != ak_error_ok )
+    return ak_error_message( error, __func__, "wrong cloning of secret key" );
+
+  memcpy( dst->ivector, src->ivector, sizeof( dst->ivector ));
+  dst->ivector_size =  src->ivector_size;
+  dst->bsize =         src->bsize;
+  dst->encrypt =       src->encrypt;
+  dst->decrypt =       src->decrypt;
+  dst->schedule_keys = src->schedule_keys;
+  dst->delete_keys =   src->delete_keys;
+  dst->clone_keys =    src->clone_keys;
+
+ /* копируем развернутые ключи; если алгоритм не поддерживает копирование,
+    то выполняем развертку ключа заново */
+  if( src->key.data != NULL ) {
+    if( dst->clone_keys != NULL ) error = dst->clone_keys( &dst->key, &src->key );
+      else if( dst->schedule_keys != NULL ) error = dst->schedule_keys( &dst->key );
+    if( error != ak_error_ok ) {
+      ak_error_message( error, __func__, "wrong copying of round keys" );
+      ak_bckey_context_destroy( dst );
+    }
+  }
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция инициализирует контекст `bkey` значением ключа `source`. Для этого используется
+    функция ak_bckey_context_clone(), то есть развертка ключа не производится, а маски
+    ключевой информации сменяются.
+
+    @param bkey Контекст создаваемого ключа алгоритма блочного шифрования.
+    @param source Контекст ключа, значение которого присваивается.
+    @return Функция возвращает код ошибки. В случае успеха возвращается \ref ak_error_ok (ноль).   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_context_create_and_set_bckey( ak_bckey bkey, ak_bckey source )
+{
+  int error = ak_error_ok;
+
+  if(( error = ak_bckey_context_clone( bkey, source )) != ak_error_ok )
+    ak_error_message( error, __func__, "incorrect initialization of block cipher key context" );
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \details Функция создает рабочую копию ключа, предназначенную для использования в отдельном
+    потоке выполнения. Рабочая копия создается с помощью функции ak_bckey_context_clone(),
+    после чего ее ресурс связывается с ресурсом ключа `src` (см. ak_skey_context_share_resource()).
+
+    \b Многопоточный режим использования ключа. Контекст ключа блочного шифрования не является
+    потокобезопасным: в ходе зашифрования изменяются маски ключа и развернутых ключей, а также
+    внутреннее значение синхропосылки. Для того, чтобы один долговременный ключ мог использоваться
+    одновременно несколькими потоками без блокировки при каждом вызове, рекомендуется
+    следующая схема.
+
+    - Основной поток создает ключ `src` и присваивает ему значение. Далее этот ключ
+      используется только как источник копий и не применяется для шифрования.
+    - Каждый поток получает собственную рабочую копию вызовом ak_bckey_context_clone_shared()
+      и использует ее в любых режимах шифрования. Все изменяемые данные (маски, синхропосылка,
+      квота ресурса) принадлежат копии, поэтому синхронизация не требуется.
+    - Ресурс ключа остается общим: рабочая копия резервирует из общего счетчика ключа `src`
+      порции по `bckey_resource_quota` блоков с помощью атомарных операций и расходует их
+      локально. Суммарное количество зашифрованных всеми копиями блоков не превышает
+      ресурса ключа `src`.
+    - Перед уничтожением ключа `src` все рабочие копии должны быть уничтожены; неиспользованная
+      часть квоты при этом возвращается в общий счетчик.
+
+    Функции ak_bckey_context_clone_shared() и ak_bckey_context_clone() могут вызываться
+    для одного и того же ключа `src` одновременно из нескольких потоков.
+
+    @param dst Контекст рабочей копии ключа. Контекст не должен быть инициализирован ранее.
+    @param src Контекст ключа-родителя; ключу должно быть присвоено значение.
+    @return Функция возвращает код ошибки. В случае успеха возвращается \ref ak_error_ok (ноль).   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_context_clone_shared( ak_bckey dst, ak_bckey src )
+{
+  int error = ak_error_ok;
+
+  if(( error = ak_bckey_context_clone( dst, src )) != ak_error_ok )
+    return ak_error_message( error, __func__, "wrong cloning of block cipher key" );
+  if(( error = ak_skey_context_share_resource( &dst->key, &src->key )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "wrong sharing of block cipher key resource" );
+    ak_bckey_context_destroy( dst );
+  }
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                          кэш развернутых раундовых ключей                                       */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Максимально возможное количество элементов кэша развернутых раундовых ключей. */
+ #define ak_bckey_schedule_cache_max_size   (64)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Элемент кэша развернутых раундовых ключей.
+    \details Элемент идентифицируется номером секретного ключа, OID алгоритма блочного шифрования
+    и значением самого секретного ключа, которое хранится под собственной маской элемента.
+    Развернутые ключи хранятся вместе со своими масками, то есть в том же виде,
+    в котором они хранятся в контексте секретного ключа. */
+ struct schedule_cache_entry {
+  /*! \brief Уникальный номер секретного ключа. */
+   ak_uint8 number[32];
+  /*! \brief OID алгоритма блочного шифрования. */
+   ak_oid oid;
+  /*! \brief Значение секретного ключа, на которое наложена маска, и сама маска. */
+   ak_uint8 key[64];
+  /*! \brief Размер секретного ключа в октетах. */
+   size_t key_size;
+  /*! \brief Значение опции `openssl_compability`, при котором выполнялась развертка ключа. */
+   ak_int64 oc;
+  /*! \brief Размер развернутых ключей в октетах (нулевое значение соответствует пустому элементу). */
+   size_t size;
+  /*! \brief Развернутые раундовые ключи и их маски. */
+   ak_uint64 data[80];
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Кэш развернутых раундовых ключей (память выделяется при первом добавлении ключей). */
+ static struct schedule_cache_entry *schedule_cache = NULL;
+/*! \brief Индекс элемента кэша, замещаемого при добавлении новых развернутых ключей. */
+ static size_t schedule_cache_next = 0;
+/*! \brief Флаг невозможности размещения кэша в защищенной памяти. */
+ static bool_t schedule_cache_disabled = ak_false;
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+ static pthread_mutex_t schedule_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция возвращает количество используемых элементов кэша. */
+/* ----------------------------------------------------------------------------------------------- */
+ static size_t ak_bckey_schedule_cache_size( void )
+{
+  ak_int64 count = ak_libakrypt_get_option_by_index( ak_option_bckey_schedule_cache_size );
+
+  if( count <= 0 ) return 0;
+ return ak_min( (size_t) count, ak_bckey_schedule_cache_max_size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция выделяет память под кэш развернутых раундовых ключей.
+    \details Память блокируется от выгрузки на диск. Если блокировка невозможна,
+    то кэш не используется. Функция вызывается при заблокированном мьютексе кэша.
+    @return В случае успеха функция возвращает \ref ak_error_ok (ноль). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_schedule_cache_alloc( void )
+{
+  const size_t size = ak_bckey_schedule_cache_max_size*sizeof( struct schedule_cache_entry );
+
+  if( schedule_cache != NULL ) return ak_error_ok;
+
+  if(( schedule_cache = ( struct schedule_cache_entry * ) malloc( size )) == NULL ) {
+    schedule_cache_disabled = ak_true;
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                                 "incorrect memory allocation for schedule cache" );
+  }
+#ifdef LIBAKRYPT_HAVE_SYSMMAN_H
+  if( mlock( schedule_cache, size ) != 0 ) {
+    free( schedule_cache );
+    schedule_cache = NULL;
+    schedule_cache_disabled = ak_true;
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                                      "incorrect locking of schedule cache memory" );
+  }
+#endif
+  memset( schedule_cache, 0, size );
+  schedule_cache_next = 0;
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция сравнивает значение секретного ключа со значением, хранящимся в элементе кэша.
+    \details На время сравнения с ключа снимается маска, после чего накладывается новая маска.
+    @return Функция возвращает \ref ak_true, если значения ключей совпадают.                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_bckey_schedule_cache_is_equal( ak_skey skey, struct schedule_cache_entry *entry )
+{
+  size_t idx = 0;
+  ak_uint8 diff = 0;
+
+  if( entry->key_size != skey->key_size ) return ak_false;
+  if( skey->unmask( skey ) != ak_error_ok ) return ak_false;
+  for( idx = 0; idx < skey->key_size; idx++ )
+     diff |= skey->key[idx]^entry->key[idx]^entry->key[idx+skey->key_size];
+  if( skey->set_mask( skey ) != ak_error_ok ) {
+    ak_error_message( ak_error_get_value(), __func__, "wrong secret key masking" );
+    return ak_false;
+  }
+
+ return ( diff == 0 ) ? ak_true : ak_false;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция помещает в элемент кэша значение секретного ключа под новой маской.
+    @return В случае успеха функция возвращает \ref ak_error_ok (ноль). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_schedule_cache_set_key( ak_skey skey, struct schedule_cache_entry *entry )
+{
+  size_t idx = 0;
+  int error = ak_error_ok;
+
+  if(( error = ak_random_context_random( &skey->generator,
+                                      entry->key + skey->key_size, skey->key_size )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect generation of secret key mask" );
+  if(( error = skey->unmask( skey )) != ak_error_ok )
+    return ak_error_message( error, __func__, "wrong secret key unmasking" );
+  for( idx = 0; idx < skey->key_size; idx++ )
+     entry->key[idx] = skey->key[idx]^entry->key[idx+skey->key_size];
+  entry->key_size = skey->key_size;
+  if(( error = skey->set_mask( skey )) != ak_error_ok )
+    return ak_error_message( error, __func__, "wrong secret key masking" );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция ищет в кэше развернутые раундовые ключи, выработанные ранее для секретного ключа
+    с тем же номером, тем же значением и того же алгоритма блочного шифрования.
+    Поскольку номер ключа может быть присвоен произвольно, совпадение номеров подтверждается
+    сравнением значений секретных ключей. В случае успешного поиска развернутые ключи
+    (вместе со своими масками) копируются в заданную область памяти. После копирования
+    вызывающая функция обязана сменить маски скопированных ключей.
+
+    Поиск производится только для ключей, у которых установлен флаг \ref ak_key_flag_schedule_cache.
+
+    @param skey Контекст секретного ключа.
+    @param data Область памяти, в которую помещаются развернутые ключи.
+    @param size Размер развернутых ключей (в октетах).
+    @return Функция возвращает \ref ak_true, если развернутые ключи найдены и скопированы.
+    В противном случае возвращается \ref ak_false.                                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_bckey_schedule_cache_find( ak_skey skey, ak_pointer data, const size_t size )
+{
+  size_t idx = 0, count = 0;
+  bool_t result = ak_false;
+  ak_int64 oc = ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
+
+  if(( skey == NULL ) || ( data == NULL )) return ak_false;
+  if(( skey->flags&ak_key_flag_schedule_cache ) == 0 ) return ak_false;
+  if(( count = ak_bckey_schedule_cache_size()) == 0 ) return ak_false;
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &schedule_cache_mutex );
+#endif
+  if( schedule_cache != NULL ) {
+    for( idx = 0; idx < count; idx++ ) {
+       struct schedule_cache_entry *entry = schedule_cache + idx;
+       if(( entry->size != size ) || ( entry->oid != skey->oid ) || ( entry->oc != oc )) continue;
+       if( memcmp( entry->number, skey->number, sizeof( entry->number )) != 0 ) continue;
+       if( ak_bckey_schedule_cache_is_equal( skey, entry ) != ak_true ) continue;
+
+       memcpy( data, entry->data, size );
+       result = ak_true;
+       break;
+    }
+  }
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &schedule_cache_mutex );
+#endif
+
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция помещает развернутые раундовые ключи в кэш. Если кэш уже содержит ключи, выработанные
+    для секретного ключа с тем же номером, то они замещаются новыми значениями. В противном случае
+    новые значения замещают элементы кэша по кругу.
+
+    Для ключей, у которых не установлен флаг \ref ak_key_flag_schedule_cache, функция
+    ничего не делает.
+
+    @param skey Контекст секретного ключа.
+    @param data Область памяти, содержащая развернутые ключи и их маски.
+    @param size Размер развернутых ключей (в октетах).
+    @return В случае успеха функция возвращает \ref ak_error_ok (ноль). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_schedule_cache_add( ak_skey skey, const ak_pointer data, const size_t size )
+{
+  size_t idx = 0, count = 0;
+  int error = ak_error_ok;
+  struct schedule_cache_entry *entry = NULL;
+
+  if( skey == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using a null pointer to secret key" );
+  if( data == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                           "using a null pointer to round keys" );
+  if(( size == 0 ) || ( size > sizeof( entry->data )))
+    return ak_error_message( ak_error_wrong_length, __func__,
+                                                          "using wrong length of round keys" );
+  if(( skey->flags&ak_key_flag_schedule_cache ) == 0 ) return ak_error_ok;
+  if(( skey->key_size == 0 ) || ( 2*skey->key_size > sizeof( entry->key ))) return ak_error_ok;
+  if(( count = ak_bckey_schedule_cache_size()) == 0 ) return ak_error_ok;
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &schedule_cache_mutex );
+#endif
+  if( schedule_cache_disabled ) goto exit;
+  if(( error = ak_bckey_schedule_cache_alloc()) != ak_error_ok ) goto exit;
+  for( idx = 0; idx < count; idx++ ) {
+     if(( schedule_cache[idx].oid == skey->oid ) &&
+        ( memcmp( schedule_cache[idx].number, skey->number, sizeof( skey->number )) == 0 )) {
+       entry = schedule_cache + idx;
+       break;
+     }
+  }
+  if( entry == NULL ) {
+    entry = schedule_cache + ( schedule_cache_next%count );
+    schedule_cache_next = ( schedule_cache_next + 1 )%count;
+  }
+
+  entry->size = 0;
+  if(( error = ak_bckey_schedule_cache_set_key( skey, entry )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "incorrect caching of secret key value" );
+    goto exit;
+  }
+  memcpy( entry->number, skey->number, sizeof( entry->number ));
+  entry->oid = skey->oid;
+  entry->oc = ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
+  entry->size = size;
+  memcpy( entry->data, data, size );
+
+  exit:
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &schedule_cache_mutex );
+#endif
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция уничтожает все хранящиеся в кэше развернутые раундовые ключи и освобождает
+    занимаемую кэшем память. Вызывается при завершении работы с библиотекой.
+
+    @return В случае успеха функция возвращает \ref ak_error_ok (ноль). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_schedule_cache_clear( void )
+{
+  struct random generator;
+  int error = ak_error_ok;
+  const size_t size = ak_bckey_schedule_cache_max_size*sizeof( struct schedule_cache_entry );
+
+  if(( error = ak_random_context_create_lcg( &generator )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect creation of random generator" );
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &schedule_cache_mutex );
+#endif
+  if( schedule_cache != NULL ) {
+    if( ak_ptr_context_wipe( schedule_cache, size, &generator ) != ak_error_ok )
+      memset( schedule_cache, 0, size );
+   #ifdef LIBAKRYPT_HAVE_SYSMMAN_H
+    munlock( schedule_cache, size );
+   #endif
+    free( schedule_cache );
+    schedule_cache = NULL;
+  }
+  schedule_cache_next = 0;
+  schedule_cache_disabled = ak_false;
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &schedule_cache_mutex );
+#endif
+
+  ak_random_context_destroy( &generator );
+ return error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*                             теперь реализация режимов шифрования                                */
 /* ----------------------------------------------------------------------------------------------- */
@@ -358,10 +769,9 @@
                                         __func__, "incorrect integrity code of secret key value" );
  /* уменьшаем значение ресурса ключа */
   blocks = size/bkey->bsize;
-  if( bkey->key.resource.value.counter < (ssize_t)blocks )
+  if( ak_skey_context_use_resource( &bkey->key, ( ssize_t )blocks ) != ak_error_ok )
     return ak_error_message( ak_error_low_key_resource,
                                                    __func__ , "low resource of block cipher key" );
-   else bkey->key.resource.value.counter -= blocks;
 
  /* теперь приступаем к зашифрованию данных */
   switch( bkey->bsize ) {
@@ -415,10 +825,9 @@
                                         __func__, "incorrect integrity code of secret key value" );
  /* уменьшаем значение ресурса ключа */
   blocks = size/bkey->bsize;
-  if( bkey->key.resource.value.counter < (ssize_t) blocks )
+  if( ak_skey_context_use_resource( &bkey->key, ( ssize_t )blocks ) != ak_error_ok )
     return ak_error_message( ak_error_low_key_resource,
                                                    __func__ , "low resource of block cipher key" );
-   else bkey->key.resource.value.counter -= blocks;
 
  /* теперь приступаем к расшифрованию данных */
   switch( bkey->bsize ) {
@@ -499,7 +908,8 @@
   ak_int64 blocks = (ak_int64)( size/bkey->bsize ),
              tail = (ak_int64)( size%bkey->bsize );
   ak_uint64 x, yaout[2], *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out;
-  int error = ak_error_ok, oc = (int) ak_libakrypt_get_option( "openssl_compability" );
+  int error = ak_error_ok,
+      oc = (int) ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
 
   if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
                                                 "wrong value for \"openssl_compability\" option" );
@@ -508,10 +918,10 @@
     return ak_error_message( ak_error_wrong_key_icode, __func__,
                                                    "incorrect integrity code of secret key value" );
  /* уменьшаем значение ресурса ключа */
-  if( bkey->key.resource.value.counter < ( blocks + ( tail > 0 )))
+  if( ak_skey_context_use_resource( &bkey->key,
+                                           ( ssize_t )( blocks + ( tail > 0 ))) != ak_error_ok )
     return ak_error_message( ak_error_low_key_resource,
                                                     __func__ , "low resource of block cipher key" );
-   else bkey->key.resource.value.counter -= ( blocks + ( tail > 0 ));
 
  /* выбираем, как вычислять синхропосылку проверяем флаг
     флаг поднимается при вызове функции с заданным значением синхропосылки и
@@ -626,7 +1036,8 @@
    ak_int64 blocks = 0;
    ak_uint64 yaout[2], z = iv_size / bkey->bsize;
    ak_uint64 *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out, *ivector = (ak_uint64 *)bkey->ivector;
-   int error = ak_error_ok, oc = (int) ak_libakrypt_get_option( "openssl_compability" );
+   int error = ak_error_ok,
+       oc = (int) ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
 
    if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
                                                  "wrong value for \"openssl_compability\" option" );
@@ -642,10 +1053,9 @@
                                          __func__, "incorrect integrity code of secret key value" );
   /* уменьшаем значение ресурса ключа */
    blocks = (ak_int64 ) (size/bkey->bsize);
-   if( bkey->key.resource.value.counter < blocks )
+   if( ak_skey_context_use_resource( &bkey->key, ( ssize_t )blocks ) != ak_error_ok )
      return ak_error_message( ak_error_low_key_resource,
                                                     __func__ , "low resource of block cipher key" );
-    else bkey->key.resource.value.counter -= blocks;
 
   /* проверяем длину синхропосылки */
    if(( iv_size < bkey->bsize ) ||                              /* если меньше  блока */
@@ -700,7 +1110,8 @@
   ak_int64 blocks = 0;
   ak_uint64 yaout[2], z = iv_size / bkey->bsize;
   ak_uint64 *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out, *ivector = (ak_uint64 *)bkey->ivector;
-  int error = ak_error_ok, oc = (int) ak_libakrypt_get_option( "openssl_compability" );
+  int error = ak_error_ok,
+      oc = (int) ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
 
   if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
                                                 "wrong value for \"openssl_compability\" option" );
@@ -716,10 +1127,9 @@
                                         __func__, "incorrect integrity code of secret key value" );
  /* уменьшаем значение ресурса ключа */
   blocks = (ak_int64 ) (size/bkey->bsize);
-  if( bkey->key.resource.value.counter < blocks )
+  if( ak_skey_context_use_resource( &bkey->key, ( ssize_t )blocks ) != ak_error_ok )
     return ak_error_message( ak_error_low_key_resource,
                                                    __func__ , "low resource of block cipher key" );
-   else bkey->key.resource.value.counter -= blocks;
 
  /* проверяем длину синхропосылки */
   if(( iv_size < bkey->bsize ) ||                              /* если меньше  блока */
@@ -788,7 +1198,7 @@
  int ak_bckey_context_cmac( ak_bckey bkey, ak_pointer in,
                                           const size_t size, ak_pointer out, const size_t out_size )
 {
-  ak_int64 i = 0, oc = (int) ak_libakrypt_get_option( "openssl_compability" ),
+  ak_int64 i = 0, oc = (int) ak_libakrypt_get_option_by_index( ak_option_openssl_compability ),
         #ifdef LIBAKRYPT_LITTLE_ENDIAN
            one64[2] = { 0x02, 0x00 },
         #else
@@ -812,10 +1222,10 @@
                                                   "incorrect integrity code of secret key value" );
 
  /* уменьшаем значение ресурса ключа */
-  if( bkey->key.resource.value.counter < ( blocks + ( tail > 0 )))
+  if( ak_skey_context_use_resource( &bkey->key,
+                                           ( ssize_t )( blocks + ( tail > 0 ))) != ak_error_ok )
     return ak_error_message( ak_error_low_key_resource, __func__ ,
                                                               "low resource of block cipher key" );
-   else bkey->key.resource.value.counter -= ( blocks + ( tail > 0 )); /* уменьшаем ресурс ключа */
 
   memset( akey, 0, sizeof( akey ));
   memset( yaout, 0, sizeof( yaout ));
@@ -898,6 +1308,8 @@
 /*! \example test-bckey01.c                                                                        */
 /*! \example test-bckey02.c                                                                        */
 /*! \example test-bckey03.c                                                                        */
+/*! \example test-bckey05.c                                                                        */
+/*! \example test-bckey06.c                                                                        */
 /* ----------------------------------------------------------------------------------------------- */
 /*                                                                                     ak_bckey.c  */
 /* ----------------------------------------------------------------------------------------------- */
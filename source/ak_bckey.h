@@ -44,6 +44,8 @@
    ak_function_skey *schedule_keys;
   /*! \brief Функция уничтожения развернутых ключей. */
    ak_function_skey *delete_keys;
+  /*! \brief Функция копирования развернутых ключей со сменой их масок. */
+   ak_function_skey_clone *clone_keys;
 };
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -73,10 +75,22 @@
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Инициализация ключа алгоритма блочного шифрования значением другого ключа */
  int ak_bckey_context_create_and_set_bckey( ak_bckey , ak_bckey );
+/*! \brief Создание копии ключа алгоритма блочного шифрования вместе с развернутыми ключами. */
+ int ak_bckey_context_clone( ak_bckey , ak_bckey );
+/*! \brief Создание рабочей копии ключа с общим ресурсом для использования в отдельном потоке. */
+ int ak_bckey_context_clone_shared( ak_bckey , ak_bckey );
 /*! \brief Процедура вычисления производного ключа в соответствии с алгоритмом ACPKM
     из рекомендаций Р 1323565.1.012-2018. */
  int ak_bckey_context_next_acpkm_key( ak_bckey );
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Поиск в кэше развернутых раундовых ключей, соответствующих заданному секретному ключу. */
+ bool_t ak_bckey_schedule_cache_find( ak_skey , ak_pointer , const size_t );
+/*! \brief Помещение развернутых раундовых ключей в кэш. */
+ int ak_bckey_schedule_cache_add( ak_skey , const ak_pointer , const size_t );
+/*! \brief Очистка кэша развернутых раундовых ключей. */
+ int ak_bckey_schedule_cache_clear( void );
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Зашифрование данных в режиме простой замены (electronic codebook, ecb). */
  int ak_bckey_context_encrypt_ecb( ak_bckey , ak_pointer , ak_pointer , size_t );
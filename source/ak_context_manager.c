@@ -207,8 +207,11 @@
 #endif
 
  /* инициализируем указатели контекстов */
-  if(( manager->size = ( size_t )ak_libakrypt_get_option("context_manager_size")) == 0 )
+  if(( manager->size = ( size_t )
+                  ak_libakrypt_get_option_by_index( ak_option_context_manager_size )) == 0 )
     manager->size = 32;
+  manager->max_size = ( size_t )
+                  ak_libakrypt_get_option_by_index( ak_option_context_manager_max_size );
 
   if(( manager->array = malloc( manager->size*sizeof( ak_pointer ))) == NULL ) {
     ak_context_manager_destroy( manager );
@@ -252,7 +255,7 @@
            free( manager->array );
            manager->array = NULL;
   }
-  manager->size = 0;
+  manager->size = manager->max_size = 0;
 
  /* удаляем генератор ключей */
   if(( error = ak_random_context_destroy( &manager->key_generator )) != ak_error_ok )
@@ -278,14 +281,14 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_context_manager_morealloc( ak_context_manager manager )
 {
-  size_t idx, newsize , msize = ( size_t )ak_libakrypt_get_option("context_manager_max_size");
+  size_t idx, newsize;
 
   if( manager == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
                                             "using a null pointer to context manager structure" );
   if(( newsize = ( manager->size << 1 )) <= manager->size )
     return ak_error_message( ak_error_context_manager_size, __func__ ,
                                       "unexpected value of new value of context manager's size" );
-  if( newsize > msize ) return ak_error_message( ak_error_context_manager_max_size, __func__,
+  if( newsize > manager->max_size ) return ak_error_message( ak_error_context_manager_max_size, __func__,
                                    "current size of context manager exceeds permissible bounds" );
 
   if(( manager->array = realloc( manager->array, sizeof( ak_pointer )*newsize )) == NULL )
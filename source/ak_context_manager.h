@@ -59,6 +59,9 @@
    ak_context_node *array;
   /*! \brief общее количество выделенной по структуры управления памяти */
    size_t size;
+  /*! \brief максимально допустимое количество контекстов
+      (значение опции, считанное при создании структуры) */
+   size_t max_size;
   /*! \brief генератор, используемый для выработки ключей */
    struct random key_generator;
 } *ak_context_manager;
@@ -4,6 +4,7 @@
 /*  Файл ak_curves.с                                                                               */
 /*  - содержит реализацию функций для работы с эллиптическими кривыми.                             */
 /* ----------------------------------------------------------------------------------------------- */
+ #include <ak_tools.h>
  #include <ak_parameters.h>
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -15,6 +16,115 @@
 #ifdef LIBAKRYPT_HAVE_STRINGS_H
  #include <strings.h>
 #endif
+#ifdef LIBAKRYPT_HAVE_STDLIB_H
+ #include <stdlib.h>
+#else
+ #error Library cannot be compiled without stdlib.h header
+#endif
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+ #include <pthread.h>
+#endif
+#ifdef LIBAKRYPT_HAVE_TIME_H
+ #include <time.h>
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                   функции, реализующие арифметику в конечном поле кривой                        */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение вычетов в представлении Монтгомери по модулю произвольного вида.
+    \details Функция выбирает развернутую реализацию умножения в зависимости от размера
+    параметров кривой; для нестандартных размеров используется функция ak_mpzn_mul_montgomery(). */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wcurve_montgomery_mul( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y, ak_wcurve ec )
+{
+  switch( ec->size ) {
+    case ak_mpzn256_size: ak_mpzn_mul_montgomery_256( z, x, y, ec->p, ec->n );
+                          break;
+    case ak_mpzn512_size: ak_mpzn_mul_montgomery_512( z, x, y, ec->p, ec->n );
+                          break;
+    default: ak_mpzn_mul_montgomery( z, x, y, ec->p, ec->n, ec->size );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Возведение в квадрат в представлении Монтгомери по модулю произвольного вида.
+    \details Для кривых длины 256 и 512 бит развернутые реализации умножения работают быстрее,
+    чем возведение в квадрат методом SOS, поэтому используются именно они.                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wcurve_montgomery_sqr( ak_uint64 *z, ak_uint64 *x, ak_wcurve ec )
+{
+  switch( ec->size ) {
+    case ak_mpzn256_size: ak_mpzn_mul_montgomery_256( z, x, x, ec->p, ec->n );
+                          break;
+    case ak_mpzn512_size: ak_mpzn_mul_montgomery_512( z, x, x, ec->p, ec->n );
+                          break;
+    default: ak_mpzn_sqr_montgomery( z, x, ec->p, ec->n, ec->size );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Сложение вычетов по модулю произвольного вида.                                         */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wcurve_montgomery_add( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y, ak_wcurve ec )
+{
+  ak_mpzn_add_montgomery( z, x, y, ec->p, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычитание вычетов по модулю произвольного вида.                                        */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wcurve_montgomery_sub( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y, ak_wcurve ec )
+{
+  ak_mpzn_sub_montgomery( z, x, y, ec->p, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение вычетов по модулю вида \f$ 2^{64n} - c \f$.                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wcurve_pseudo_mersenne_mul( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y, ak_wcurve ec )
+{
+  ak_mpzn_mul_montgomery_pm( z, x, y, ec->p, ec->n, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Возведение в квадрат по модулю вида \f$ 2^{64n} - c \f$.                              */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wcurve_pseudo_mersenne_sqr( ak_uint64 *z, ak_uint64 *x, ak_wcurve ec )
+{
+  ak_mpzn_sqr_montgomery_pm( z, x, ec->p, ec->n, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Сложение вычетов по модулю вида \f$ 2^{64n} - c \f$.                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wcurve_pseudo_mersenne_add( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y, ak_wcurve ec )
+{
+  ak_mpzn_add_pm( z, x, y, ec->p, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычитание вычетов по модулю вида \f$ 2^{64n} - c \f$.                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wcurve_pseudo_mersenne_sub( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y, ak_wcurve ec )
+{
+  ak_mpzn_sub_pm( z, x, y, ec->p, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ const struct wcurve_arithmetic wcurve_arithmetic_montgomery = {
+   ak_wcurve_montgomery_mul,
+   ak_wcurve_montgomery_sqr,
+   ak_wcurve_montgomery_add,
+   ak_wcurve_montgomery_sub
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+ const struct wcurve_arithmetic wcurve_arithmetic_pseudo_mersenne = {
+   ak_wcurve_pseudo_mersenne_mul,
+   ak_wcurve_pseudo_mersenne_sqr,
+   ak_wcurve_pseudo_mersenne_add,
+   ak_wcurve_pseudo_mersenne_sub
+ };
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция вычисляет величину \f$\Delta \equiv -16(4a^3 + 27b^2) \pmod{p} \f$, зависящую
@@ -30,27 +140,27 @@
  /* определяем константы 4 и 27 в представлении Монтгомери */
   ak_mpzn_set_ui( d, ec->size, 4 );
   ak_mpzn_set_ui( s, ak_mpznmax_size, 27 );
-  ak_mpzn_mul_montgomery( d, d, ec->r2, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( s, s, ec->r2, ec->p, ec->n, ec->size );
+  ak_wcurve_mul( d, d, ec->r2, ec );
+  ak_wcurve_mul( s, s, ec->r2, ec );
 
  /* вычисляем 4a^3 (mod p) значение в представлении Монтгомери */
-  ak_mpzn_mul_montgomery( d, d, ec->a, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( d, d, ec->a, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( d, d, ec->a, ec->p, ec->n, ec->size );
+  ak_wcurve_mul( d, d, ec->a, ec );
+  ak_wcurve_mul( d, d, ec->a, ec );
+  ak_wcurve_mul( d, d, ec->a, ec );
 
  /* вычисляем значение 4a^3 + 27b^2 (mod p) в представлении Монтгомери */
-  ak_mpzn_mul_montgomery( s, s, ec->b, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( s, s, ec->b, ec->p, ec->n, ec->size );
+  ak_wcurve_mul( s, s, ec->b, ec );
+  ak_wcurve_mul( s, s, ec->b, ec );
   ak_mpzn_add_montgomery( d, d, s, ec->p, ec->size );
 
  /* определяем константу -16 в представлении Монтгомери и вычисляем D = -16(4a^3+27b^2) (mod p) */
   ak_mpzn_set_ui( s, ec->size, 16 );
   ak_mpzn_sub( s, ec->p, s, ec->size );
-  ak_mpzn_mul_montgomery( s, s, ec->r2, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( d, d, s, ec->p, ec->n, ec->size );
+  ak_wcurve_mul( s, s, ec->r2, ec );
+  ak_wcurve_mul( d, d, s, ec );
 
  /* возвращаем результат (в обычном представлении) */
-  ak_mpzn_mul_montgomery( d, d, one, ec->p, ec->n, ec->size );
+  ak_wcurve_mul( d, d, one, ec );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -70,10 +180,102 @@
    else return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет выполнимость сравнения \f$ 2^{m-1} \equiv 1 \pmod{m} \f$
+    (тест Ферма по основанию 2) для модуля \f$ m \f$ с заданными константами Монтгомери.
+    \details Показатель степени \f$ m-1 \f$ является открытым значением, поэтому для
+    возведения в степень используется функция ak_mpzn_modpow_montgomery_vartime().
+
+    @return Функция возвращает \ref ak_true, если сравнение выполнено.                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_wcurve_fermat_test( ak_uint64 *m, ak_uint64 *r2, ak_uint64 n0, const size_t size )
+{
+  ak_mpzn512 a, k, one;
+
+  ak_mpzn_set_ui( one, size, 1 );
+  ak_mpzn_set_ui( a, size, 2 );
+  ak_mpzn_mul_montgomery( a, a, r2, m, n0, size );
+  ak_mpzn_sub( k, m, one, size );
+  ak_mpzn_modpow_montgomery_vartime( a, a, k, m, n0, size );
+  ak_mpzn_mul_montgomery( a, a, one, m, n0, size );
+ return ak_mpzn_cmp_ui( a, size, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет, что коэффициент \f$ a \f$ кривой равен \f$ -3 \pmod{p} \f$.      */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_wcurve_a_is_minus3( ak_wcurve ec )
+{
+  ak_mpznmax u, v;
+
+  ak_mpzn_set_ui( u, ec->size, 1 );
+  ak_wcurve_mul( u, u, ec->a, ec );
+  ak_mpzn_set_ui( v, ec->size, 3 );
+  ak_mpzn_sub( v, ec->p, v, ec->size );
+ return ( ak_mpzn_cmp( u, v, ec->size ) == 0 ) ? ak_true : ak_false;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет корректность параметров эквивалентной кривой Эдвардса.
+    \details Проверяется выполнимость равенств \f$ a = s^2 - 3t^2 \f$, \f$ b = 2t^3 - ts^2 \f$,
+    \f$ 3t + 2s = 1 \f$ и \f$ d = 3t - 2s \f$, а также то, что величина \f$ d \f$ не является
+    квадратом в поле \f$ \mathbb F_p \f$ (критерий Эйлера).
+
+    @return Функция возвращает \ref ak_true, если все проверки выполнены, либо параметры
+    кривой Эдвардса не определены.                                                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_wcurve_edwards_is_ok( ak_wcurve ec )
+{
+  size_t l;
+  ak_mpznmax s2, t2, u, v, k;
+  ak_uint64 *s = NULL, *t = NULL, *d = NULL;
+
+  if( ec->edwards == NULL ) return ak_true;
+  s = ( ak_uint64 * )ec->edwards->s;
+  t = ( ak_uint64 * )ec->edwards->t;
+  d = ( ak_uint64 * )ec->edwards->d;
+
+ /* a = s^2 - 3t^2 */
+  ak_wcurve_sqr( s2, s, ec );
+  ak_wcurve_sqr( t2, t, ec );
+  ak_wcurve_add( u, t2, t2, ec );
+  ak_wcurve_add( u, u, t2, ec );
+  ak_wcurve_sub( u, s2, u, ec );
+  if( ak_mpzn_cmp( u, ec->a, ec->size ) != 0 ) return ak_false;
+
+ /* b = 2t^3 - ts^2 */
+  ak_wcurve_mul( u, t2, t, ec );
+  ak_wcurve_add( u, u, u, ec );
+  ak_wcurve_mul( v, t, s2, ec );
+  ak_wcurve_sub( u, u, v, ec );
+  if( ak_mpzn_cmp( u, ec->b, ec->size ) != 0 ) return ak_false;
+
+ /* d = 3t - 2s и 3t + 2s = 1 */
+  ak_wcurve_add( u, t, t, ec );
+  ak_wcurve_add( u, u, t, ec );
+  ak_wcurve_add( v, s, s, ec );
+  ak_wcurve_sub( t2, u, v, ec );
+  if( ak_mpzn_cmp( t2, d, ec->size ) != 0 ) return ak_false;
+  ak_wcurve_add( u, u, v, ec );
+  ak_mpzn_set_ui( v, ec->size, 1 );
+  ak_wcurve_mul( u, u, v, ec );
+  if( ak_mpzn_cmp_ui( u, ec->size, 1 ) != ak_true ) return ak_false;
+
+ /* d^{(p-1)/2} = -1 */
+  for( l = 0; l < ec->size; l++ )
+     k[l] = ( ec->p[l] >> 1 )|( l+1 < ec->size ? ec->p[l+1] << 63 : 0 );
+  ak_mpzn_modpow_montgomery_vartime( u, d, k, ec->p, ec->n, ec->size );
+  ak_wcurve_mul( u, u, v, ec );
+  ak_mpzn_sub( v, ec->p, v, ec->size );
+  if( ak_mpzn_cmp( u, v, ec->size ) != 0 ) return ak_false;
+
+ return ak_true;
+}
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! Для проведения проверки функция вырабатывает случайное число \f$ t \pmod{q} \f$ и проверяет
-    выполнимость равенства \f$ t \cdot t^{-1} \equiv 1 \pmod{q}\f$.
+    выполнимость равенства \f$ t \cdot t^{-1} \equiv 1 \pmod{q}\f$, а также выполнимость
+    сравнения \f$ 2^{q-1} \equiv 1 \pmod{q}\f$.
 
     @param ec Контекст эллиптической кривой.
 
@@ -82,7 +284,7 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_wcurve_check_order_parameters( ak_wcurve ec )
 {
-  ak_mpzn512 r, s, t;
+  ak_mpzn512 s, t;
   struct random generator;
 
   ak_random_context_create_lcg( &generator );
@@ -90,16 +292,115 @@
   ak_mpzn_rem( t, t, ec->q, ec->size );
   ak_random_context_destroy( &generator );
 
-  ak_mpzn_set_ui( r, ec->size, 2 );
-  ak_mpzn_sub( r, ec->q, r, ec->size );
-  ak_mpzn_modpow_montgomery( s, t, r, ec->q, ec->nq, ec->size );
+  ak_mpzn_inverse_montgomery( s, t, ec->q, ec->nq, ec->r2q, ec->size );
   ak_mpzn_mul_montgomery( t, s, t, ec->q, ec->nq, ec->size );
 
   ak_mpzn_mul_montgomery( t, t, ec->r2q, ec->q, ec->nq, ec->size );
   ak_mpzn_mul_montgomery( t, t, ec->point.z, ec->q, ec->nq, ec->size );
   ak_mpzn_mul_montgomery( t, t, ec->point.z, ec->q, ec->nq, ec->size );
-  if( ak_mpzn_cmp_ui( t, ec->size, 1 )) return ak_error_ok;
-   else return ak_error_curve_order_parameters;
+  if( ak_mpzn_cmp_ui( t, ec->size, 1 ) != ak_true ) return ak_error_curve_order_parameters;
+
+ /* порядок подгруппы должен быть простым числом */
+  if( ak_wcurve_fermat_test( ec->q, ec->r2q, ec->nq, ec->size ) != ak_true )
+    return ak_error_curve_order_parameters;
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет, что для кофактора \f$ h \f$ выполнена граница Хассе
+    \f$ |p + 1 - hq| \leq 2\sqrt{p} \f$, а порядок подгруппы удовлетворяет неравенству
+    \f$ q > 4\sqrt{p} \f$.
+    \details Если для простого \f$ q \f$ выполнено равенство \f$ [q]P = \mathcal O \f$, то
+    выполнение указанных неравенств означает, что порядок группы точек кривой равен \f$ hq \f$.
+    В частности, при \f$ h = 1 \f$ любая отличная от \f$ \mathcal O \f$ точка кривой имеет
+    порядок \f$ q \f$, что позволяет не проверять порядок точек открытых ключей.
+    @return Функция возвращает \ref ak_true, если все проверки выполнены. В противном случае
+    возвращается \ref ak_false.                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_wcurve_cofactor_is_ok( ak_wcurve ec )
+{
+  const size_t n = ec->size + 1; /* вычисления выполняются с дополнительным машинным словом */
+  ak_mpznmax d = ak_mpznmax_zero, hq = ak_mpznmax_zero,
+             u = ak_mpznmax_zero, v = ak_mpznmax_zero;
+
+  if( ec->cofactor == 0 ) return ak_false;
+
+ /* вычисляем d = |p + 1 - hq| */
+  ak_mpzn_set( d, ec->p, ec->size );
+  ak_mpzn_set_ui( u, n, 1 );
+  ak_mpzn_add( d, d, u, n );
+  hq[ec->size] = ak_mpzn_mul_ui( hq, ec->q, ec->size, ec->cofactor );
+  if( ak_mpzn_cmp( d, hq, n ) >= 0 ) ak_mpzn_sub( d, d, hq, n );
+   else ak_mpzn_sub( d, hq, d, n );
+
+ /* проверяем неравенство d^2 <= 4p */
+  ak_mpzn_mul( u, d, d, n );
+  v[ec->size] = ak_mpzn_mul_ui( v, ec->p, ec->size, 4 );
+  if( ak_mpzn_cmp( u, v, 2*n ) > 0 ) return ak_false;
+
+ /* проверяем неравенство q^2 > 16p */
+  memset( d, 0, sizeof( d ));
+  ak_mpzn_set( d, ec->q, ec->size );
+  ak_mpzn_mul( u, d, d, n );
+  v[ec->size] = ak_mpzn_mul_ui( v, ec->p, ec->size, 16 );
+  if( ak_mpzn_cmp( u, v, 2*n ) <= 0 ) return ak_false;
+
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Максимальное количество кривых, результаты проверки которых хранятся в кэше. */
+ #define ak_wcurve_check_cache_max_size   (32)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Кэш идентификаторов кривых, параметры которых успешно прошли проверку. */
+ static ak_oid wcurve_check_cache[ ak_wcurve_check_cache_max_size ];
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+ static pthread_mutex_t wcurve_check_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция ищет кривую в кэше проверенных кривых, либо добавляет ее в кэш.
+    \details Добавляются только кривые, имеющие идентификатор (константные параметры,
+    доступные через механизм OID); для кривых, определенных пользователем, кэш не используется.
+    @param ec Эллиптическая кривая.
+    @param add Если значение истинно, то кривая добавляется в кэш.
+    @return Функция возвращает истину, если кривая содержится в кэше.                              */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_wcurve_check_cache_lookup( ak_wcurve ec, bool_t add )
+{
+  size_t idx = 0;
+  ak_oid oid = NULL;
+  bool_t result = ak_false;
+  int error = ak_error_get_value();
+
+  if( add ) { /* поиск идентификатора изменяет код ошибки, если кривая его не имеет */
+    oid = ak_oid_context_find_by_data( ec );
+    ak_error_set_value( error );
+    if(( oid == NULL ) || ( oid->mode != wcurve_params )) return ak_false;
+  }
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &wcurve_check_cache_mutex );
+#endif
+  for( idx = 0; idx < ak_wcurve_check_cache_max_size; idx++ ) {
+     if( wcurve_check_cache[idx] == NULL ) {
+       if( add ) {
+         wcurve_check_cache[idx] = oid;
+         result = ak_true;
+       }
+       break;
+     }
+     if( wcurve_check_cache[idx]->data == ec ) {
+       result = ak_true;
+       break;
+     }
+  }
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &wcurve_check_cache_mutex );
+#endif
+
+ return result;
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -109,16 +410,22 @@
      - проверяется, что модуль кривой (простое число \f$ p \f$) удовлетворяет неравенству
        \f$ 2^{n-32} < p < 2^n \f$, где \f$ n \f$ это либо 256, либо 512 в зависимости от
        параметров кривой,
+     - для модуля кривой выполняется тест Ферма по основанию 2,
      - проверяется, что дискриминант кривой отличен от нуля по модулю \f$ p \f$,
      - проверяется, что фиксированная точка кривой, содержащаяся в контексте эллиптической кривой,
        действительно принадлежит эллиптической кривой,
      - проверяется, что порядок этой точки кривой равен простому числу \f$ q \f$,
-       содержащемуся в контексте эллиптической кривой.
+       содержащемуся в контексте эллиптической кривой,
+     - проверяется, что порядок группы точек кривой равен произведению \f$ q \f$ на кофактор.
 
      @param ec контекст структуры эллиптической кривой, содержащий в себе значения параметров.
      Константные значения структур, которые могут быть использованы библиотекой,
      задаются в файле \ref ak_parameters.h
 
+     Поскольку проверка порядка точки требует вычисления кратной точки, для кривых, имеющих
+     идентификатор, результат успешной проверки сохраняется в кэше, и повторные вызовы функции
+     (например, при создании ключей) проверки не выполняют.
+
      @return В случае успеха, функция возвращает \ref ak_error_ok. В противном случае,
      возвращается код ошибки.                                                                      */
 /* ----------------------------------------------------------------------------------------------- */
@@ -129,6 +436,9 @@
   const char *str = NULL;
   int error = ak_error_ok;
 
+ /* параметры, имеющие идентификатор, проверяются один раз */
+  if( ak_wcurve_check_cache_lookup( ec, ak_false )) return ak_error_ok;
+
  /* создали кривую и проверяем веоичину старшего коэффициента ее молуля */
   if( ec->p[ ec->size-1 ] < 0x100000000LL )
     return ak_error_message( ak_error_curve_prime_modulo, __func__ ,
@@ -150,10 +460,26 @@
   if( ak_mpzn_cmp( temp, ec->p, ec->size ) != 0 )
     return ak_error_message( ak_error_wrong_endian, __func__,
                                                "incorrect convertation string to mpzn integer" );
+ /* проверяем, что выбранная арифметика конечного поля применима к модулю кривой */
+  if(( ec->arithmetic == &wcurve_arithmetic_pseudo_mersenne ) &&
+                                        !ak_mpzn_is_pseudo_mersenne( ec->p, ec->size ))
+    return ak_error_message( ak_error_curve_prime_modulo, __func__,
+                                  "using pseudo-mersenne arithmetic with unsupported prime modulo" );
+ /* проверяем, что модуль кривой является простым числом */
+  if( ak_wcurve_fermat_test( ec->p, ec->r2, ec->n, ec->size ) != ak_true )
+    return ak_error_message( ak_error_curve_prime_modulo, __func__,
+                                          "using elliptic curve parameters with composite module" );
  /* проверяем, что дискриминант кривой отличен от нуля */
   if(( error = ak_wcurve_discriminant_is_ok( ec )) != ak_error_ok )
     return ak_error_message( ak_error_curve_discriminant, __func__ ,
                                        "using elliptic curve parameters with zero discriminant" );
+ /* проверяем соответствие формул удвоения и параметров кривой Эдвардса коэффициентам кривой */
+  if(( ec->point_double == ak_wpoint_double_minus3 ) && ( ak_wcurve_a_is_minus3( ec ) != ak_true ))
+    return ak_error_message( ak_error_curve_order_parameters, __func__ ,
+                                    "using doubling formulas for a = -3 with unsupported curve" );
+  if( ak_wcurve_edwards_is_ok( ec ) != ak_true )
+    return ak_error_message( ak_error_curve_order_parameters, __func__ ,
+                                      "using elliptic curve with wrong twisted edwards parameters" );
  /* теперь проверяем принадлежность точки кривой */
   if(( error = ak_wpoint_set( &wp, ec )) != ak_error_ok )
     return ak_error_message( error, __func__, "incorect asiigning a temporary point" );
@@ -163,10 +489,15 @@
   if( ak_wpoint_check_order( &wp, ec ) != ak_true )
     return ak_error_message( ak_error_curve_point_order, __func__ ,
                                                          "elliptic curve point has wrong order" );
+  if( ak_wcurve_cofactor_is_ok( ec ) != ak_true )
+    return ak_error_message( ak_error_curve_order_parameters, __func__ ,
+                                                        "elliptic curve has wrong cofactor value" );
  /* тестируем параметры порядка группы точек, используемые для выработки и проверки электронной подписи */
   if(( error = ak_wcurve_check_order_parameters( ec )) != ak_error_ok )
     return ak_error_message( error, __func__ ,
                   "elliptic curve has wrong parameters for calculation in prime field modulo q" );
+
+  ak_wcurve_check_cache_lookup( ec, ak_true );
  return error;
 }
 
@@ -181,9 +512,9 @@
   if( oid != NULL ) {
     ak_error_message_fmt( error, __func__, "elliptic curve: %s (oid: %s)", oid->names[0], oid->id );
 
-    ak_mpzn_mul_montgomery( tmp, ec->a, one, ec->p, ec->n, ec->size );
+    ak_wcurve_mul( tmp, ec->a, one, ec );
     ak_error_message_fmt( error, __func__, " a = %s", ak_mpzn_to_hexstr( tmp, ec->size ));
-    ak_mpzn_mul_montgomery( tmp, ec->b, one, ec->p, ec->n, ec->size );
+    ak_wcurve_mul( tmp, ec->b, one, ec );
     ak_error_message_fmt( error, __func__, " b = %s", ak_mpzn_to_hexstr( tmp, ec->size ));
     ak_error_message_fmt( error, __func__, " b = %s", ak_mpzn_to_hexstr( ec->b, ec->size ));
     ak_error_message_fmt( error, __func__, " p = %s", ak_mpzn_to_hexstr( ec->p, ec->size ));
@@ -216,9 +547,9 @@
   ec = oid->data;
   fprintf( fp, "elliptic curve: %s (oid: %s)\n\n", oid->names[0], oid->id );
 
-  ak_mpzn_mul_montgomery( tmp, ec->a, one, ec->p, ec->n, ec->size );
+  ak_wcurve_mul( tmp, ec->a, one, ec );
   fprintf( fp, "  a = %s\n", ak_mpzn_to_hexstr( tmp, ec->size ));
-  ak_mpzn_mul_montgomery( tmp, ec->b, one, ec->p, ec->n, ec->size );
+  ak_wcurve_mul( tmp, ec->b, one, ec );
   fprintf( fp, "  b = %s\n", ak_mpzn_to_hexstr( tmp, ec->size ));
 
   fprintf( fp, "  p = %s\n", ak_mpzn_to_hexstr( ec->p, ec->size ));
@@ -376,28 +707,54 @@
 
  /* Проверяем принадлежность точки заданной кривой */
   ak_mpzn_set( t, ec->a, ec->size );
-  ak_mpzn_mul_montgomery( t, t, wp->x, ec->p, ec->n, ec->size );
+  ak_wcurve_mul( t, t, wp->x, ec );
   ak_mpzn_set( s, ec->b, ec->size );
-  ak_mpzn_mul_montgomery( s, s, wp->z, ec->p, ec->n, ec->size );
-  ak_mpzn_add_montgomery( t, t, s, ec->p, ec->size ); // теперь в t величина (ax+bz)
+  ak_wcurve_mul( s, s, wp->z, ec );
+  ak_wcurve_add( t, t, s, ec ); // теперь в t величина (ax+bz)
 
   ak_mpzn_set( s, wp->z, ec->size );
-  ak_mpzn_mul_montgomery( s, s, s, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( t, t, s, ec->p, ec->n, ec->size ); // теперь в t величина (ax+bz)z^2
+  ak_wcurve_sqr( s, s, ec );
+  ak_wcurve_mul( t, t, s, ec ); // теперь в t величина (ax+bz)z^2
 
   ak_mpzn_set( s, wp->x, ec->size );
-  ak_mpzn_mul_montgomery( s, s, s, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( s, s, wp->x, ec->p, ec->n, ec->size );
-  ak_mpzn_add_montgomery( t, t, s, ec->p, ec->size ); // теперь в t величина x^3 + (ax+bz)z^2
+  ak_wcurve_sqr( s, s, ec );
+  ak_wcurve_mul( s, s, wp->x, ec );
+  ak_wcurve_add( t, t, s, ec ); // теперь в t величина x^3 + (ax+bz)z^2
 
   ak_mpzn_set( s, wp->y, ec->size );
-  ak_mpzn_mul_montgomery( s, s, s, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( s, s, wp->z, ec->p, ec->n, ec->size ); // теперь в s величина x^3 + (ax+bz)z^2
+  ak_wcurve_sqr( s, s, ec );
+  ak_wcurve_mul( s, s, wp->z, ec ); // теперь в s величина x^3 + (ax+bz)z^2
 
   if( ak_mpzn_cmp( t, s, ec->size )) return ak_false;
  return ak_true;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция завершает удвоение точки по известному значению \f$ w = az^2 + 3x^2 \f$.
+    \details Используются соотношения dbl-2007-bl, приведенные в описании функции
+    ak_wpoint_double().                                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_wpoint_double_with_w( ak_wpoint wp, ak_uint64 *u3, ak_wcurve ec )
+{
+ ak_mpznmax u1, u2, u4, u5, u6, u7;
+
+ ak_wcurve_mul( u4, wp->y, wp->z, ec );
+ ak_wcurve_add( u4, u4, u4, ec );   // u4 = 2yz
+ ak_wcurve_mul( u5, wp->y, u4, ec ); // u5 = 2y^2z
+ ak_wcurve_add( u6, u5, u5, ec ); // u6 = 2u5
+ ak_wcurve_mul( u7, u6, wp->x, ec ); // u7 = 8xy^2z
+ ak_wcurve_add( u1, u7, u7, ec );
+ ak_wcurve_sqr( u2, u3, ec );
+ ak_wcurve_sub( u2, u2, u1, ec ); // u2 = u3^2 - 2u7
+ ak_wcurve_mul( wp->x, u2, u4, ec );
+ ak_wcurve_mul( u6, u6, u5, ec );
+ ak_wcurve_sub( u2, u7, u2, ec );
+ ak_wcurve_mul( wp->y, u2, u3, ec );
+ ak_wcurve_sub( wp->y, wp->y, u6, ec );
+ ak_wcurve_sqr( wp->z, u4, ec );
+ ak_wcurve_mul( wp->z, wp->z, u4, ec );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Точка эллиптической кривой \f$ P = (x:y:z) \f$ заменяется значением \f$ 2P  = (x_3:y_3:z_3)\f$,
     то есть складывается сама с собой (удваивается).
@@ -421,43 +778,62 @@
       Z3 = sss
     \endcode
 
+    Если для кривой определена функция удвоения, учитывающая вид коэффициента \f$ a \f$
+    (поле point_double), то вычисления выполняются этой функцией.
+
     @param wp удваиваемая точка \f$ P \f$ эллиптической кривой.
     @param ec эллиптическая кривая, которой принадлежит точка \f$P\f$.                             */
 /* ----------------------------------------------------------------------------------------------- */
  void ak_wpoint_double( ak_wpoint wp, ak_wcurve ec )
 {
- ak_mpznmax u1, u2, u3, u4, u5, u6, u7;
+ ak_mpznmax u1, u2, u3;
 
+ if( ec->point_double != NULL ) {
+   ec->point_double( wp, ec );
+   return;
+ }
  if( ak_mpzn_cmp_ui( wp->z, ec->size, 0 ) == ak_true ) return;
  if( ak_mpzn_cmp_ui( wp->y, ec->size, 0 ) == ak_true ) {
    ak_wpoint_set_as_unit( wp, ec );
    return;
  }
  // dbl-2007-bl
- ak_mpzn_mul_montgomery( u1, wp->x, wp->x, ec->p, ec->n, ec->size );
- ak_mpzn_mul_montgomery( u2, wp->z, wp->z, ec->p, ec->n, ec->size );
- ak_mpzn_lshift_montgomery( u4, u1, ec->p, ec->size );
- ak_mpzn_add_montgomery( u4, u4, u1, ec->p, ec->size );
- ak_mpzn_mul_montgomery( u3, u2, ec->a, ec->p, ec->n, ec->size );
- ak_mpzn_add_montgomery( u3, u3, u4, ec->p, ec->size );  // u3 = az^2 + 3x^2
- ak_mpzn_mul_montgomery( u4, wp->y, wp->z, ec->p, ec->n, ec->size );
- ak_mpzn_lshift_montgomery( u4, u4, ec->p, ec->size );   // u4 = 2yz
- ak_mpzn_mul_montgomery( u5, wp->y, u4, ec->p, ec->n, ec->size ); // u5 = 2y^2z
- ak_mpzn_lshift_montgomery( u6, u5, ec->p, ec->size ); // u6 = 2u5
- ak_mpzn_mul_montgomery( u7, u6, wp->x, ec->p, ec->n, ec->size ); // u7 = 8xy^2z
- ak_mpzn_lshift_montgomery( u1, u7, ec->p, ec->size );
- ak_mpzn_sub( u1, ec->p, u1, ec->size );
- ak_mpzn_mul_montgomery( u2, u3, u3, ec->p, ec->n, ec->size );
- ak_mpzn_add_montgomery( u2, u2, u1, ec->p, ec->size );
- ak_mpzn_mul_montgomery( wp->x, u2, u4, ec->p, ec->n, ec->size );
- ak_mpzn_mul_montgomery( u6, u6, u5, ec->p, ec->n, ec->size );
- ak_mpzn_sub( u6, ec->p, u6, ec->size );
- ak_mpzn_sub( u2, ec->p, u2, ec->size );
- ak_mpzn_add_montgomery( u2, u2, u7, ec->p, ec->size );
- ak_mpzn_mul_montgomery( wp->y, u2, u3, ec->p, ec->n, ec->size );
- ak_mpzn_add_montgomery( wp->y, wp->y, u6, ec->p, ec->size );
- ak_mpzn_mul_montgomery( wp->z, u4, u4, ec->p, ec->n, ec->size );
- ak_mpzn_mul_montgomery( wp->z, wp->z, u4, ec->p, ec->n, ec->size );
+ ak_wcurve_sqr( u1, wp->x, ec );
+ ak_wcurve_sqr( u2, wp->z, ec );
+ ak_wcurve_add( u3, u1, u1, ec );
+ ak_wcurve_add( u1, u3, u1, ec );
+ ak_wcurve_mul( u3, u2, ec->a, ec );
+ ak_wcurve_add( u3, u3, u1, ec );  // u3 = az^2 + 3x^2
+ ak_wpoint_double_with_w( wp, u3, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет то же значение, что и функция ak_wpoint_double(), для кривых
+    с коэффициентом \f$ a = -3 \f$. В этом случае величина \f$ w = az^2 + 3x^2 \f$ вычисляется
+    как \f$ w = 3(x-z)(x+z) \f$, что требует одного умножения вместо двух возведений в квадрат
+    и умножения на коэффициент \f$ a \f$.
+
+    Функция указывается в поле point_double параметров кривой; соответствие коэффициента
+    \f$ a \f$ кривой проверяется функцией ak_wcurve_is_ok().
+
+    @param wp удваиваемая точка \f$ P \f$ эллиптической кривой.
+    @param ec эллиптическая кривая, которой принадлежит точка \f$P\f$.                             */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_double_minus3( ak_wpoint wp, ak_wcurve ec )
+{
+ ak_mpznmax u1, u2;
+
+ if( ak_mpzn_cmp_ui( wp->z, ec->size, 0 ) == ak_true ) return;
+ if( ak_mpzn_cmp_ui( wp->y, ec->size, 0 ) == ak_true ) {
+   ak_wpoint_set_as_unit( wp, ec );
+   return;
+ }
+ ak_wcurve_sub( u1, wp->x, wp->z, ec );
+ ak_wcurve_add( u2, wp->x, wp->z, ec );
+ ak_wcurve_mul( u1, u1, u2, ec );
+ ak_wcurve_add( u2, u1, u1, ec );
+ ak_wcurve_add( u1, u2, u1, ec );  // u1 = 3(x-z)(x+z)
+ ak_wpoint_double_with_w( wp, u1, ec );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -504,12 +880,12 @@
     return;
   }
   // поскольку удвоение точки с помощью формул сложения дает бесконечно удаленную точку,
-  // необходимо выполнить проверку
-  ak_mpzn_mul_montgomery( u1, wp1->x, wp2->z, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( u2, wp2->x, wp1->z, ec->p, ec->n, ec->size );
+  // необходимо выполнить проверку; вычисленные произведения используются далее
+  ak_wcurve_mul( u1, wp1->x, wp2->z, ec ); // X1Z2
+  ak_wcurve_mul( u2, wp2->x, wp1->z, ec ); // X2*Z1
   if( ak_mpzn_cmp( u1, u2, ec->size ) == 0 ) { // случай совпадения х-координат точки
-    ak_mpzn_mul_montgomery( u1, wp1->y, wp2->z, ec->p, ec->n, ec->size );
-    ak_mpzn_mul_montgomery( u2, wp2->y, wp1->z, ec->p, ec->n, ec->size );
+    ak_wcurve_mul( u1, wp1->y, wp2->z, ec );
+    ak_wcurve_mul( u2, wp2->y, wp1->z, ec );
     if( ak_mpzn_cmp( u1, u2, ec->size ) == 0 ) // случай полного совпадения точек
       ak_wpoint_double( wp1, ec );
      else ak_wpoint_set_as_unit( wp1, ec );
@@ -517,66 +893,417 @@
   }
 
   //add-1998-cmo-2
-  ak_mpzn_mul_montgomery( u1, wp1->x, wp2->z, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( u2, wp1->y, wp2->z, ec->p, ec->n, ec->size );
-  ak_mpzn_sub( u2, ec->p, u2, ec->size );
-  ak_mpzn_mul_montgomery( u3, wp1->z, wp2->z, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( u4, wp2->y, wp1->z, ec->p, ec->n, ec->size );
-  ak_mpzn_add_montgomery( u4, u4, u2, ec->p, ec->size );
-  ak_mpzn_mul_montgomery( u5, u4, u4, ec->p, ec->n, ec->size );
-  ak_mpzn_sub( u7, ec->p, u1, ec->size );
-  ak_mpzn_mul_montgomery( wp1->x, wp2->x, wp1->z, ec->p, ec->n, ec->size );
-  ak_mpzn_add_montgomery( wp1->x, wp1->x, u7, ec->p, ec->size );
-  ak_mpzn_mul_montgomery( u7, wp1->x, wp1->x, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( u6, u7, wp1->x, ec->p, ec->n, ec->size);
-  ak_mpzn_mul_montgomery( u1, u7, u1, ec->p, ec->n, ec->size );
-  ak_mpzn_lshift_montgomery( u7, u1, ec->p, ec->size );
-  ak_mpzn_add_montgomery( u7, u7, u6, ec->p, ec->size );
-  ak_mpzn_sub( u7, ec->p, u7, ec->size );
-  ak_mpzn_mul_montgomery( u5, u5, u3, ec->p, ec->n, ec->size );
-  ak_mpzn_add_montgomery( u5, u5, u7, ec->p, ec->size );
-  ak_mpzn_mul_montgomery( wp1->x, wp1->x, u5, ec->p, ec->n, ec->size );
-  ak_mpzn_mul_montgomery( u2, u2, u6, ec->p, ec->n, ec->size );
-  ak_mpzn_sub( u5, ec->p, u5, ec->size );
-  ak_mpzn_add_montgomery( u1, u1, u5, ec->p, ec->size );
-  ak_mpzn_mul_montgomery( wp1->y, u4, u1, ec->p, ec->n, ec->size );
-  ak_mpzn_add_montgomery( wp1->y, wp1->y, u2, ec->p, ec->size );
-  ak_mpzn_mul_montgomery( wp1->z, u6, u3, ec->p, ec->n, ec->size );
+  ak_wcurve_sub( wp1->x, u2, u1, ec ); // v = X2*Z1-X1Z2
+  ak_wcurve_mul( u2, wp1->y, wp2->z, ec );
+  ak_wcurve_mul( u3, wp1->z, wp2->z, ec );
+  ak_wcurve_mul( u4, wp2->y, wp1->z, ec );
+  ak_wcurve_sub( u4, u4, u2, ec ); // u = Y2*Z1-Y1Z2
+  ak_wcurve_sqr( u5, u4, ec );
+  ak_wcurve_sqr( u7, wp1->x, ec );
+  ak_wcurve_mul( u6, u7, wp1->x, ec );
+  ak_wcurve_mul( u1, u7, u1, ec );
+  ak_wcurve_add( u7, u1, u1, ec );
+  ak_wcurve_add( u7, u7, u6, ec );
+  ak_wcurve_mul( u5, u5, u3, ec );
+  ak_wcurve_sub( u5, u5, u7, ec ); // A = uu*Z1Z2-vvv-2*R
+  ak_wcurve_mul( wp1->x, wp1->x, u5, ec );
+  ak_wcurve_mul( u2, u2, u6, ec );
+  ak_wcurve_sub( u1, u1, u5, ec );
+  ak_wcurve_mul( wp1->y, u4, u1, ec );
+  ak_wcurve_sub( wp1->y, wp1->y, u2, ec );
+  ak_wcurve_mul( wp1->z, u6, u3, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет то же значение, что и функция ak_wpoint_add(), в случае, когда
+    точка \f$ Q \f$ задана в аффинной форме и ее координаты представлены в форме Монтгомери,
+    то есть \f$ z_2 \equiv r \pmod{p} \f$ (единица в представлении Монтгомери). Такие точки
+    вырабатываются функцией ak_wpoint_odd_multiples() при истинном значении параметра reduce.
+
+    Подстановка \f$ Z_2 = 1 \f$ в соотношения add-1998-cmo-2 позволяет выполнить
+    9 умножений и 2 возведения в квадрат вместо 12 умножений и 2 возведений в квадрат.
+
+    \code
+      u = Y2*Z1-Y1
+      v = X2*Z1-X1
+      R = v^2*X1
+      A = u^2*Z1-v^3-2*R
+      X3 = v*A
+      Y3 = u*(R-A)-v^3*Y1
+      Z3 = v^3*Z1
+    \endcode
+
+    @param wp1 Точка \f$ P \f$, в которую помещается результат операции сложения; первое слагаемое
+    @param wp2 Точка \f$ Q \f$ в аффинной форме, второе слагаемое
+    @param ec Эллиптическая кривая, которой принадлежат складываемые точки                         */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_add_affine( ak_wpoint wp1, ak_wpoint wp2, ak_wcurve ec )
+{
+  ak_mpznmax u1, u4, u5, u6, u7;
+
+  if( ak_mpzn_cmp_ui( wp1->z, ec->size, 0 ) == ak_true ) {
+    ak_wpoint_set_wpoint( wp1, wp2, ec );
+    return;
+  }
+  ak_wcurve_mul( u1, wp2->x, wp1->z, ec );
+  ak_wcurve_sub( u1, u1, wp1->x, ec ); // v = X2*Z1-X1
+  ak_wcurve_mul( u4, wp2->y, wp1->z, ec );
+  ak_wcurve_sub( u4, u4, wp1->y, ec ); // u = Y2*Z1-Y1
+  if( ak_mpzn_cmp_ui( u1, ec->size, 0 ) == ak_true ) { // случай совпадения х-координат точки
+    if( ak_mpzn_cmp_ui( u4, ec->size, 0 ) == ak_true ) ak_wpoint_double( wp1, ec );
+     else ak_wpoint_set_as_unit( wp1, ec );
+    return;
+  }
+
+  ak_wcurve_sqr( u5, u4, ec );
+  ak_wcurve_sqr( u7, u1, ec );
+  ak_wcurve_mul( u6, u7, u1, ec );       // vvv = v^3
+  ak_wcurve_mul( u7, u7, wp1->x, ec );   // R = v^2*X1
+  ak_wcurve_mul( u5, u5, wp1->z, ec );
+  ak_wcurve_sub( u5, u5, u6, ec );
+  ak_wcurve_sub( u5, u5, u7, ec );
+  ak_wcurve_sub( u5, u5, u7, ec );       // A = u^2*Z1-vvv-2*R
+  ak_wcurve_mul( wp1->x, u1, u5, ec );
+  ak_wcurve_sub( u7, u7, u5, ec );
+  ak_wcurve_mul( u7, u4, u7, ec );
+  ak_wcurve_mul( u5, u6, wp1->y, ec );
+  ak_wcurve_sub( wp1->y, u7, u5, ec );
+  ak_wcurve_mul( wp1->z, u6, wp1->z, ec );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! Для точки \f$ P = (x:y:z) \f$ функция вычисляет аффинное представление,
     задаваемое следующим вектором \f$ P = \left( \frac{x}{z} \pmod{p}, \frac{y}{z} \pmod{p}, 1\right) \f$,
-    где \f$ p \f$ модуль эллиптической кривой.
+    где \f$ p \f$ модуль эллиптической кривой. Обращение \f$ z \f$ выполняется
+    за постоянное время функцией ak_mpzn_inverse().
 
     @param wp Точка кривой, которая приводится к аффинной форме
     @param ec Эллиптическая кривая, которой принадлежит точка                                      */
 /* ----------------------------------------------------------------------------------------------- */
  void ak_wpoint_reduce( ak_wpoint wp, ak_wcurve ec )
 {
- ak_mpznmax u, one = ak_mpznmax_one;
+ ak_mpznmax u;
  if( ak_mpzn_cmp_ui( wp->z, ec->size, 0 ) == ak_true ) {
    ak_wpoint_set_as_unit( wp, ec );
    return;
  }
 
- ak_mpzn_set_ui( u, ec->size, 2 );
- ak_mpzn_sub( u, ec->p, u, ec->size );
- ak_mpzn_modpow_montgomery( u, wp->z, u, ec->p, ec->n, ec->size ); // u <- z^{p-2} (mod p)
- ak_mpzn_mul_montgomery( u, u, one, ec->p, ec->n, ec->size );
+ ak_mpzn_inverse( u, wp->z, ec->p, ec->n, ec->size ); // u <- z^{-1} (mod p)
+ ak_wcurve_mul( u, u, ec->r2, ec );
 
- ak_mpzn_mul_montgomery( wp->x, wp->x, u, ec->p, ec->n, ec->size );
- ak_mpzn_mul_montgomery( wp->y, wp->y, u, ec->p, ec->n, ec->size );
+ ak_wcurve_mul( wp->x, wp->x, u, ec );
+ ak_wcurve_mul( wp->y, wp->y, u, ec );
  ak_mpzn_set_ui( wp->z, ec->size, 1 );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция приводит к аффинной форме массив точек \f$ P_0, \ldots, P_{m-1} \f$, используя
+    метод Монтгомери одновременного обращения: вычисляются произведения
+    \f$ w_i = z_0z_1\cdots z_i \f$, обращается только последнее произведение, после чего
+    обратные значения \f$ z_i^{-1} = w_i^{-1}w_{i-1} \f$ и \f$ w_{i-1}^{-1} = w_i^{-1}z_i \f$
+    вычисляются в обратном порядке. Таким образом, вместо \f$ m \f$ обращений
+    выполняется одно обращение и \f$ 3(m-1) \f$ умножений.
+
+    Бесконечно удаленные точки (с нулевой \f$ z \f$-координатой) в вычислениях не участвуют
+    и заменяются каноническим представлением бесконечно удаленной точки.
+    Если память для промежуточных значений не может быть выделена, то каждая точка приводится
+    к аффинной форме функцией ak_wpoint_reduce().
+
+    @param wp Массив точек кривой, которые приводятся к аффинной форме
+    @param count Количество точек в массиве
+    @param ec Эллиптическая кривая, которой принадлежат точки                                      */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_reduce_batch( ak_wpoint wp, size_t count, ak_wcurve ec )
+{
+  size_t i, start = count;
+  ak_uint64 *w = NULL;
+  ak_mpznmax u, t;
+
+  if( count == 0 ) return;
+  if(( count == 1 ) || (( w = malloc( count*sizeof( ak_mpznmax ))) == NULL )) {
+    for( i = 0; i < count; i++ ) ak_wpoint_reduce( wp+i, ec );
+    return;
+  }
+
+ /* вычисляем произведения w_i = z_0z_1...z_i, пропуская бесконечно удаленные точки */
+  for( i = 0; i < count; i++ ) {
+     ak_uint64 *wi = w + i*ak_mpznmax_size;
+     if( ak_mpzn_cmp_ui( wp[i].z, ec->size, 0 ) == ak_true ) {
+       ak_wpoint_set_as_unit( wp+i, ec );
+       if( start < i ) ak_mpzn_set( wi, wi - ak_mpznmax_size, ec->size );
+       continue;
+     }
+     if( start < i ) ak_wcurve_mul( wi, wi - ak_mpznmax_size, wp[i].z, ec );
+      else { ak_mpzn_set( wi, wp[i].z, ec->size ); start = i; }
+  }
+  if( start == count ) { /* все точки бесконечно удаленные */
+    free( w );
+    return;
+  }
+
+ /* обращаем произведение всех z-координат */
+  ak_mpzn_inverse( u, w + ( count-1 )*ak_mpznmax_size, ec->p, ec->n, ec->size );
+  ak_wcurve_mul( u, u, ec->r2, ec );
+
+ /* вычисляем обратные значения в обратном порядке */
+  for( i = count; i > start; i-- ) {
+     ak_wpoint pt = wp+i-1;
+     if( ak_mpzn_cmp_ui( pt->z, ec->size, 0 ) == ak_true ) continue;
+     if( i-1 > start ) {
+       ak_wcurve_mul( t, u, w + ( i-2 )*ak_mpznmax_size, ec ); /* t = z_i^{-1} */
+       ak_wcurve_mul( u, u, pt->z, ec );                       /* u = w_{i-1}^{-1} */
+     } else ak_mpzn_set( t, u, ec->size );
+
+     ak_wcurve_mul( pt->x, pt->x, t, ec );
+     ak_wcurve_mul( pt->y, pt->y, t, ec );
+     ak_mpzn_set_ui( pt->z, ec->size, 1 );
+  }
+  free( w );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция переводит координаты точки, приведенной к аффинной форме, в представление
+    Монтгомери.
+    \details Все координаты точки умножаются на \f$ r \f$, поэтому точка не изменяется,
+    а ее \f$ z \f$-координата становится равной единице в представлении Монтгомери. Такая
+    точка может использоваться в качестве второго слагаемого функции ak_wpoint_add_affine().    */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wpoint_set_montgomery_affine( ak_wpoint wp, ak_wcurve ec )
+{
+  if( ak_mpzn_cmp_ui( wp->z, ec->size, 0 ) == ak_true ) return;
+  ak_wcurve_mul( wp->x, wp->x, ec->r2, ec );
+  ak_wcurve_mul( wp->y, wp->y, ec->r2, ec );
+  ak_wcurve_mul( wp->z, wp->z, ec->r2, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                   вычисления на кривой Эдвардса, эквивалентной заданной кривой                  */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Точка кривой Эдвардса \f$ u^2 + v^2 = 1 + du^2v^2 \f$ в расширенных координатах.
+    \details Точка \f$ (u, v) \f$ представляется вектором \f$ (X:Y:T:Z) \f$, где
+    \f$ u = X/Z, v = Y/Z \f$ и \f$ T = XY/Z \f$. Нейтральным элементом группы точек
+    является точка \f$ (0:1:0:1) \f$.                                                              */
+ struct epoint {
+  /*! \brief Координата \f$ X \f$ точки. */
+   ak_uint64 x[ak_mpzn512_size];
+  /*! \brief Координата \f$ Y \f$ точки. */
+   ak_uint64 y[ak_mpzn512_size];
+  /*! \brief Координата \f$ T \f$ точки. */
+   ak_uint64 t[ak_mpzn512_size];
+  /*! \brief Координата \f$ Z \f$ точки. */
+   ak_uint64 z[ak_mpzn512_size];
+ };
+/*! \brief Контекст точки кривой Эдвардса. */
+ typedef struct epoint *ak_epoint;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция присваивает точке кривой Эдвардса значение нейтрального элемента.               */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_set_as_unit( ak_epoint ep, ak_wcurve ec )
+{
+  ak_mpzn_set_ui( ep->x, ec->size, 0 );
+  ak_mpzn_set_ui( ep->y, ec->size, 1 );
+  ak_mpzn_set_ui( ep->t, ec->size, 0 );
+  ak_mpzn_set_ui( ep->z, ec->size, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция отображает точку кривой в форме Вейерштрасса в точку кривой Эдвардса.
+    \details Для точки \f$ (x:y:z) \f$ вычисляются величины \f$ \alpha = x - tz \f$,
+    \f$ \beta = \alpha - sz \f$, \f$ \gamma = \alpha + sz \f$, после чего
+    \f$ (X:Y:T:Z) = (\alpha\gamma : \beta y : \alpha\beta : y\gamma) \f$.
+    Бесконечно удаленная точка переходит в нейтральный элемент, а точка второго
+    порядка \f$ (t, 0) \f$ в точку \f$ (0, -1) \f$.                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_set_wpoint( ak_epoint ep, ak_wpoint wp, ak_wcurve ec )
+{
+  ak_mpznmax alpha, beta, gamma, u;
+
+  if( ak_mpzn_cmp_ui( wp->z, ec->size, 0 ) == ak_true ) {
+    ak_epoint_set_as_unit( ep, ec );
+    return;
+  }
+  if( ak_mpzn_cmp_ui( wp->y, ec->size, 0 ) == ak_true ) {
+    ak_epoint_set_as_unit( ep, ec );
+    ak_mpzn_sub( ep->y, ec->p, ep->y, ec->size );
+    return;
+  }
+
+  ak_wcurve_mul( u, ( ak_uint64 * )ec->edwards->t, wp->z, ec );
+  ak_wcurve_sub( alpha, wp->x, u, ec );
+  ak_wcurve_mul( u, ( ak_uint64 * )ec->edwards->s, wp->z, ec );
+  ak_wcurve_sub( beta, alpha, u, ec );
+  ak_wcurve_add( gamma, alpha, u, ec );
+
+  ak_wcurve_mul( ep->x, alpha, gamma, ec );
+  ak_wcurve_mul( ep->y, beta, wp->y, ec );
+  ak_wcurve_mul( ep->t, alpha, beta, ec );
+  ak_wcurve_mul( ep->z, wp->y, gamma, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция отображает точку кривой Эдвардса в точку кривой в форме Вейерштрасса.
+    \details Для точки \f$ (X:Y:T:Z) \f$ вычисляется точка
+    \f$ (x:y:z) = ((s(Z+Y) + t(Z-Y))X : s(Z+Y)Z : (Z-Y)X) \f$. Нейтральный элемент переходит
+    в бесконечно удаленную точку, точка \f$ (0, -1) \f$ обрабатывается отдельно.                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wpoint_set_epoint( ak_wpoint wp, ak_epoint ep, ak_wcurve ec )
+{
+  ak_mpznmax u, v;
+
+  ak_wcurve_add( u, ep->z, ep->y, ec );
+  if( ak_mpzn_cmp_ui( u, ec->size, 0 ) == ak_true ) { /* точка второго порядка (t, 0) */
+    ak_mpzn_set_ui( u, ec->size, 1 );
+    ak_wcurve_mul( wp->z, u, ec->r2, ec );
+    ak_mpzn_set( wp->x, ( ak_uint64 * )ec->edwards->t, ec->size );
+    ak_mpzn_set_ui( wp->y, ec->size, 0 );
+    return;
+  }
+
+  ak_wcurve_sub( v, ep->z, ep->y, ec );
+  ak_wcurve_mul( u, u, ( ak_uint64 * )ec->edwards->s, ec ); /* u = s(Z+Y) */
+  ak_wcurve_mul( wp->y, u, ep->z, ec );
+  ak_wcurve_mul( wp->z, v, ep->x, ec );
+  ak_wcurve_mul( v, v, ( ak_uint64 * )ec->edwards->t, ec );
+  ak_wcurve_add( v, v, u, ec );
+  ak_wcurve_mul( wp->x, v, ep->x, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Удвоение точки кривой Эдвардса в расширенных координатах (4 умножения и 4 возведения
+    в квадрат).                                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_double( ak_epoint ep, ak_wcurve ec )
+{
+  ak_mpznmax a, b, c, e, g;
+
+  ak_wcurve_sqr( a, ep->x, ec );
+  ak_wcurve_sqr( b, ep->y, ec );
+  ak_wcurve_sqr( c, ep->z, ec );
+  ak_wcurve_add( c, c, c, ec );     /* c = 2Z^2 */
+  ak_wcurve_add( e, ep->x, ep->y, ec );
+  ak_wcurve_sqr( e, e, ec );
+  ak_wcurve_sub( e, e, a, ec );
+  ak_wcurve_sub( e, e, b, ec );     /* e = (X+Y)^2 - X^2 - Y^2 */
+  ak_wcurve_add( g, a, b, ec );     /* g = X^2 + Y^2 */
+  ak_wcurve_sub( a, a, b, ec );     /* h = X^2 - Y^2 */
+  ak_wcurve_sub( c, g, c, ec );     /* f = g - 2Z^2 */
+
+  ak_wcurve_mul( ep->x, e, c, ec );
+  ak_wcurve_mul( ep->y, g, a, ec );
+  ak_wcurve_mul( ep->t, e, a, ec );
+  ak_wcurve_mul( ep->z, c, g, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Прибавление к точке кривой Эдвардса точки, заданной своими координатами.
+    \details Используются полные (не имеющие исключительных случаев) формулы сложения.
+    Вместо координаты \f$ T_2 \f$ прибавляемой точки передается величина \f$ dT_2 \f$.
+    Если координата \f$ Z_2 \f$ не определена (равна NULL), то она считается равной единице.
+
+    @param ep Точка, к которой прибавляется значение; в нее же помещается результат.
+    @param x2 Координата \f$ X_2 \f$ прибавляемой точки.
+    @param y2 Координата \f$ Y_2 \f$ прибавляемой точки.
+    @param dt2 Величина \f$ dT_2 \f$.
+    @param z2 Координата \f$ Z_2 \f$ прибавляемой точки или NULL.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_add_values( ak_epoint ep, ak_uint64 *x2, ak_uint64 *y2,
+                                               ak_uint64 *dt2, ak_uint64 *z2, ak_wcurve ec )
+{
+  ak_mpznmax a, b, c, d, e, f;
+
+  ak_wcurve_mul( a, ep->x, x2, ec );
+  ak_wcurve_mul( b, ep->y, y2, ec );
+  ak_wcurve_mul( c, ep->t, dt2, ec );
+  if( z2 == NULL ) ak_mpzn_set( d, ep->z, ec->size );
+   else ak_wcurve_mul( d, ep->z, z2, ec );
+  ak_wcurve_add( e, ep->x, ep->y, ec );
+  ak_wcurve_add( f, x2, y2, ec );
+  ak_wcurve_mul( e, e, f, ec );
+  ak_wcurve_sub( e, e, a, ec );
+  ak_wcurve_sub( e, e, b, ec );     /* e = X1Y2 + Y1X2 */
+  ak_wcurve_sub( f, d, c, ec );     /* f = Z1Z2 - dT1T2 */
+  ak_wcurve_add( d, d, c, ec );     /* g = Z1Z2 + dT1T2 */
+  ak_wcurve_sub( b, b, a, ec );     /* h = Y1Y2 - X1X2 */
+
+  ak_wcurve_mul( ep->x, e, f, ec );
+  ak_wcurve_mul( ep->y, d, b, ec );
+  ak_wcurve_mul( ep->t, e, b, ec );
+  ak_wcurve_mul( ep->z, f, d, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Прибавление к одной точке кривой Эдвардса значения другой точки.                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_add( ak_epoint ep1, ak_epoint ep2, ak_wcurve ec )
+{
+  ak_mpznmax dt;
+
+  ak_wcurve_mul( dt, ep2->t, ( ak_uint64 * )ec->edwards->d, ec );
+  ak_epoint_add_values( ep1, ep2->x, ep2->y, dt, ep2->z, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция меняет местами значения двух точек, если маска равна \f$ 2^{64}-1 \f$, и
+    оставляет их без изменения, если маска равна нулю.                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_swap( ak_epoint ep1, ak_epoint ep2, ak_uint64 mask, ak_wcurve ec )
+{
+  size_t l;
+  ak_uint64 w;
+
+  for( l = 0; l < ec->size; l++ ) {
+     w = ( ep1->x[l]^ep2->x[l] )&mask; ep1->x[l] ^= w; ep2->x[l] ^= w;
+     w = ( ep1->y[l]^ep2->y[l] )&mask; ep1->y[l] ^= w; ep2->y[l] ^= w;
+     w = ( ep1->t[l]^ep2->t[l] )&mask; ep1->t[l] ^= w; ep2->t[l] ^= w;
+     w = ( ep1->z[l]^ep2->z[l] )&mask; ep1->z[l] ^= w; ep2->z[l] ^= w;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление кратной точки кривой Эдвардса методом лесенки Монтгомери.
+    \details На каждом шаге выполняется одно сложение и одно удвоение; вместо ветвления
+    точки лесенки меняются местами наложением маски.                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_pow( ak_epoint eq, ak_epoint ep, ak_uint64 *k, size_t size, ak_wcurve ec )
+{
+  long long int i, j;
+  ak_uint64 uk = 0, bit = 0, swap = 0;
+  struct epoint Q, R;
+
+  ak_epoint_set_as_unit( &Q, ec );
+  memcpy( &R, ep, sizeof( struct epoint ));
+
+  for( i = size-1; i >= 0; i-- ) {
+     uk = k[i];
+     for( j = 0; j < 64; j++ ) {
+        bit = uk >> 63;
+        ak_epoint_swap( &Q, &R, 0 - ( bit^swap ), ec );
+        swap = bit;
+        ak_epoint_add( &R, &Q, ec );
+        ak_epoint_double( &Q, ec );
+        uk <<= 1;
+     }
+  }
+  ak_epoint_swap( &Q, &R, 0 - swap, ec );
+
+  memcpy( eq, &Q, sizeof( struct epoint ));
+  memset( &Q, 0, sizeof( struct epoint ));
+  memset( &R, 0, sizeof( struct epoint ));
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Для заданной точки \f$ P = (x:y:z) \f$ и заданного целого числа (вычета) \f$ k \f$
     функция вычисляет кратную точку \f$ Q \f$, удовлетворяющую
     равенству \f$  Q = [k]P = \underbrace{P+ \cdots + P}_{k}\f$.
 
-    При вычислении используется метод `лесенки Монтгомери`, выравнивающий время работы алгоритма
-    вне зависимости от вида числа \f$ k \f$.
+    При вычислении используется метод `лесенки Монтгомери`, выполняющий одно сложение и одно
+    удвоение для каждого(!) бита числа \f$ k \f$ вне зависимости от его значения.
+
+    Если для кривой определены параметры эквивалентной кривой Эдвардса, то точка \f$ P \f$
+    отображается на кривую Эдвардса, вычисления выполняются в расширенных координатах с
+    использованием полных формул сложения, после чего результат отображается обратно.
 
     \b Для \b информации:
      \li Функция не приводит результирующую точку \f$ Q \f$ к аффинной форме.
@@ -590,12 +1317,20 @@
     может приниимать любое неотрицательное значение.
     @param ec Эллиптическая кривая, на которой происходят вычисления                               */
 /* ----------------------------------------------------------------------------------------------- */
- void ak_wpoint_pow( ak_wpoint wq, ak_wpoint wp, ak_uint64 *k, size_t size, ak_wcurve ec )
+ void ak_wpoint_pow_ladder( ak_wpoint wq, ak_wpoint wp, ak_uint64 *k, size_t size, ak_wcurve ec )
 {
   ak_uint64 uk = 0;
   long long int i, j;
   struct wpoint Q, R; /* две точки из лесенки Монтгомери */
 
+  if( ec->edwards != NULL ) {
+    struct epoint E;
+    ak_epoint_set_wpoint( &E, wp, ec );
+    ak_epoint_pow( &E, &E, k, size, ec );
+    ak_wpoint_set_epoint( wq, &E, ec );
+    return;
+  }
+
  /* начальные значения для переменных */
   ak_wpoint_set_as_unit( &Q, ec );
   ak_wpoint_set_wpoint( &R, wp, ec );
@@ -614,27 +1349,1083 @@
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! Для заданной точки \f$ P = (x:y:z) \f$ функция проверяет
-    что порядок точки действительно есть величина \f$ q \f$, заданная в параметрах
-    эллиптической кривой, то есть проверяется выполнимость равенства \f$ [q]P = \mathcal O\f$,
-    где \f$ \mathcal O \f$ - бесконечно удаленная точка (ноль группы точек эллиптической кривой),
-    а \f$ q \f$ порядок подгруппы, в которой реализуются вычисления.
+/*! \brief Функция возвращает \f$ w \f$ битов числа \f$ k \f$, начиная с бита с номером pos. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline ak_uint64 ak_wpoint_window_digit( ak_uint64 *k, size_t size,
+                                                                     size_t pos, size_t width )
+{
+  size_t idx = pos >> 6, shift = pos&0x3f;
+  ak_uint64 d = k[idx] >> shift;
 
-    @param wp точка \f$ P \f$ эллиптической кривой
-    @param ec эллиптическая кривая, на принадлежность которой проверяется точка \f$P\f$.
+  if(( shift + width > 64 ) && ( idx+1 < size )) d ^= k[idx+1] << ( 64 - shift );
+ return d&(( ( ak_uint64 )1 << width ) - 1 );
+}
 
-    @return Функция возвращает \ref ak_true если все проверки выполнены. В противном случае
-    возвращается \ref ak_false.                                                                    */
 /* ----------------------------------------------------------------------------------------------- */
- bool_t ak_wpoint_check_order( ak_wpoint wp, ak_wcurve ec )
+/*! \brief Функция возвращает маску \f$ 2^{64}-1 \f$, если значения равны, и ноль в противном
+    случае; вычисление выполняется без ветвлений.                                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline ak_uint64 ak_wpoint_window_mask( ak_uint64 a, ak_uint64 b )
 {
-  struct wpoint ep;
-
-  ak_wpoint_set_as_unit( &ep, ec );
-  ak_wpoint_pow( &ep, wp, ec->q, ec->size, ec );
-  return ak_mpzn_cmp_ui( ep.z, ec->size, 0 );
+  ak_uint64 x = a^b;
+ return (( x | ( 0 - x )) >> 63 ) - 1;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция помещает точку wp в точку wq, если маска равна \f$ 2^{64}-1 \f$, и оставляет
+    точку wq без изменений, если маска равна нулю; вычисление выполняется без ветвлений.          */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_wpoint_select( ak_wpoint wq, ak_wpoint wp, ak_uint64 mask, ak_wcurve ec )
+{
+  size_t l;
+
+  for( l = 0; l < ec->size; l++ ) {
+     wq->x[l] ^= ( wq->x[l]^wp->x[l] )&mask;
+     wq->y[l] ^= ( wq->y[l]^wp->y[l] )&mask;
+     wq->z[l] ^= ( wq->z[l]^wp->z[l] )&mask;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление кратной точки кривой Эдвардса методом фиксированного окна.
+    \details Точка таблицы выбирается просмотром всех точек таблицы с наложением маски,
+    сложение выполняется по полным формулам, не содержащим ветвлений.                              */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_pow_window( ak_epoint eq, ak_epoint ep, ak_uint64 *k,
+                                                         size_t size, size_t width, ak_wcurve ec )
+{
+  long long int i;
+  size_t j, l, count = ( size_t )1 << width, windows = ( 64*size + width - 1 )/width;
+  struct epoint Q, T, table[ 1 << ak_wpoint_window_max_width ];
+
+  ak_epoint_set_as_unit( table, ec );
+  memcpy( table+1, ep, sizeof( struct epoint ));
+  for( j = 2; j < count; j++ ) {
+     if( j&0x1 ) {
+       memcpy( table+j, table+j-1, sizeof( struct epoint ));
+       ak_epoint_add( table+j, ep, ec );
+     } else {
+         memcpy( table+j, table+(j>>1), sizeof( struct epoint ));
+         ak_epoint_double( table+j, ec );
+       }
+  }
+
+  ak_epoint_set_as_unit( &Q, ec );
+  for( i = ( long long int )windows - 1; i >= 0; i-- ) {
+     ak_uint64 d = ak_wpoint_window_digit( k, size, ( size_t )i*width, width );
+     for( j = 0; j < width; j++ ) ak_epoint_double( &Q, ec );
+     memset( &T, 0, sizeof( struct epoint ));
+     for( j = 0; j < count; j++ ) {
+        ak_uint64 mask = ak_wpoint_window_mask( j, d );
+        for( l = 0; l < ec->size; l++ ) {
+           T.x[l] ^= table[j].x[l]&mask;
+           T.y[l] ^= table[j].y[l]&mask;
+           T.t[l] ^= table[j].t[l]&mask;
+           T.z[l] ^= table[j].z[l]&mask;
+        }
+     }
+     ak_epoint_add( &Q, &T, ec );
+  }
+
+  memcpy( eq, &Q, sizeof( struct epoint ));
+  memset( &Q, 0, sizeof( struct epoint ));
+  memset( &T, 0, sizeof( struct epoint ));
+  memset( table, 0, sizeof( table ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для заданной точки \f$ P \f$ и заданного целого числа \f$ k \f$ функция вычисляет кратную
+    точку \f$ Q = [k]P \f$ методом фиксированного окна ширины \f$ w \f$.
+
+    Предварительно вычисляется таблица точек \f$ P, [2]P, \ldots, [2^w-1]P \f$,
+    после чего для каждого из \f$ \lceil 64n/w \rceil \f$ окон числа \f$ k \f$ выполняется
+    \f$ w \f$ удвоений и одно сложение. Точка таблицы выбирается просмотром всех точек таблицы
+    с наложением маски, что исключает зависимость адресов обращений к памяти от значения \f$ k \f$.
+
+    Формулы сложения и удвоения точек кривой в форме Вейерштрасса не являются полными:
+    функции ak_wpoint_add() и ak_wpoint_double() завершаются досрочно, если одно из слагаемых
+    есть бесконечно удаленная точка \f$ \mathcal O \f$. Поэтому нулевой цифре окна
+    соответствует прибавление точки \f$ P \f$, результат которого отбрасывается наложением маски,
+    а до появления первой ненулевой цифры вместо \f$ \mathcal O \f$ удваивается фиктивная точка
+    \f$ P \f$. Тем самым, операции с точкой \f$ \mathcal O \f$ не выполняются и количество
+    операций не зависит от значения \f$ k \f$ (за исключением пренебрежимо редких случаев
+    совпадения слагаемых). Для кривых, имеющих эквивалентную форму Эдвардса, используются
+    полные формулы сложения.
+
+    По сравнению с лесенкой Монтгомери количество сложений уменьшается примерно в \f$ w \f$ раз
+    ценой вычисления таблицы из \f$ 2^w \f$ точек.
+
+    @param wq Точка \f$ Q \f$, в которую помещается результат.
+    @param wp Точка \f$ P \f$.
+    @param k Степень кратности.
+    @param size Размер степени \f$ k \f$ в машинных словах.
+    @param width Ширина окна \f$ w \f$ (от 1 до \ref ak_wpoint_window_max_width).
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow_window( ak_wpoint wq, ak_wpoint wp, ak_uint64 *k,
+                                                         size_t size, size_t width, ak_wcurve ec )
+{
+  long long int i;
+  ak_uint64 started = 0;
+  size_t j, count, windows;
+  struct wpoint Q, R, T, table[ 1 << ak_wpoint_window_max_width ];
+
+  if( width < 1 ) width = 1;
+  if( width > ak_wpoint_window_max_width ) width = ak_wpoint_window_max_width;
+  if( size == 0 ) {
+    ak_wpoint_set_as_unit( wq, ec );
+    return;
+  }
+  if( ec->edwards != NULL ) {
+    struct epoint E;
+    ak_epoint_set_wpoint( &E, wp, ec );
+    ak_epoint_pow_window( &E, &E, k, size, width, ec );
+    ak_wpoint_set_epoint( wq, &E, ec );
+    return;
+  }
+
+  count = ( size_t )1 << width;
+  windows = ( 64*size + width - 1 )/width;
+  ak_wpoint_set_wpoint( table+1, wp, ec );
+  for( j = 2; j < count; j++ ) {
+     if( j&0x1 ) {
+       ak_wpoint_set_wpoint( table+j, table+j-1, ec );
+       ak_wpoint_add( table+j, wp, ec );
+     } else {
+         ak_wpoint_set_wpoint( table+j, table+(j>>1), ec );
+         ak_wpoint_double( table+j, ec );
+       }
+  }
+
+ /* до появления первой ненулевой цифры точка Q является фиктивной */
+  ak_wpoint_set_wpoint( &Q, wp, ec );
+  for( i = ( long long int )windows - 1; i >= 0; i-- ) {
+     ak_uint64 d = ak_wpoint_window_digit( k, size, ( size_t )i*width, width ),
+               nonzero = ~ak_wpoint_window_mask( d, 0 );
+     for( j = 0; j < width; j++ ) ak_wpoint_double( &Q, ec );
+    /* нулевой цифре соответствует точка P */
+     d |= 1&( ~nonzero );
+     ak_wpoint_set_wpoint( &T, table+1, ec );
+     for( j = 2; j < count; j++ ) ak_wpoint_select( &T, table+j, ak_wpoint_window_mask( j, d ), ec );
+     ak_wpoint_set_wpoint( &R, &Q, ec );
+     ak_wpoint_add( &R, &T, ec );
+    /* Q <- Q + T, если цифра ненулевая, и Q <- T для первой ненулевой цифры */
+     ak_wpoint_select( &Q, &R, nonzero&started, ec );
+     ak_wpoint_select( &Q, &T, nonzero&( ~started ), ec );
+     started |= nonzero;
+  }
+  ak_wpoint_set_as_unit( &T, ec );
+  ak_wpoint_select( &Q, &T, ~started, ec );
+
+  ak_wpoint_set_wpoint( wq, &Q, ec );
+  memset( &Q, 0, sizeof( struct wpoint ));
+  memset( &R, 0, sizeof( struct wpoint ));
+  memset( &T, 0, sizeof( struct wpoint ));
+  memset( table, 0, sizeof( table ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static size_t ak_wpoint_wnaf( ak_int8 * , ak_uint64 * , const size_t , const size_t );
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для заданной точки \f$ P \f$ и заданного целого числа \f$ k \f$ функция вычисляет кратную
+    точку \f$ Q = [k]P \f$ с использованием wNAF представления числа \f$ k \f$ с шириной
+    окна \f$ w \f$: вычисляются нечетные кратные \f$ P, [3]P, \ldots, [2^{w-1}-1]P \f$, после чего
+    выполняется \f$ 64n \f$ удвоений и, в среднем, \f$ 64n/(w+1) \f$ сложений.
+
+    \warning Время работы функции зависит от значения \f$ k \f$, поэтому функция
+    должна использоваться только для открытых данных (например, при проверке порядка точки).
+
+    @param wq Точка \f$ Q \f$, в которую помещается результат.
+    @param wp Точка \f$ P \f$.
+    @param k Степень кратности.
+    @param size Размер степени \f$ k \f$ в машинных словах (не более \ref ak_mpzn512_size).
+    @param width Ширина окна \f$ w \f$ (от 2 до 8).
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow_wnaf( ak_wpoint wq, ak_wpoint wp, ak_uint64 *k,
+                                                         size_t size, size_t width, ak_wcurve ec )
+{
+  size_t len;
+  long long int i;
+  struct wpoint Q, T, table[ 1 << 6 ];
+  ak_int8 naf[ 64*ak_mpzn512_size+1 ];
+
+  if( size > ak_mpzn512_size ) {
+    ak_wpoint_pow_ladder( wq, wp, k, size, ec );
+    return;
+  }
+  if( width < 2 ) width = 2;
+  if( width > 8 ) width = 8;
+
+  ak_wpoint_odd_multiples( table, ( size_t )1 << ( width-2 ), wp, ak_false, ec );
+  len = ak_wpoint_wnaf( naf, k, size, width );
+  ak_wpoint_set_as_unit( &Q, ec );
+  for( i = ( long long int )len - 1; i >= 0; i-- ) {
+     ak_wpoint_double( &Q, ec );
+     if( naf[i] != 0 ) {
+       ak_wpoint_set_wpoint( &T, table + (( naf[i] > 0 ? naf[i] : -naf[i] ) >> 1 ), ec );
+       if(( naf[i] < 0 ) && !ak_mpzn_cmp_ui( T.y, ec->size, 0 ))
+         ak_mpzn_sub( T.y, ec->p, T.y, ec->size );
+       ak_wpoint_add( &Q, &T, ec );
+     }
+  }
+  ak_wpoint_set_wpoint( wq, &Q, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Максимальное количество кривых, для которых хранится индивидуальный способ
+    вычисления кратных точек. */
+ #define ak_wcurve_pow_policy_max_count   (16)
+
+/*! \brief Способ вычисления кратных точек, установленный для конкретной кривой. */
+ struct wcurve_pow_policy_entry {
+  /*! \brief Эллиптическая кривая (NULL соответствует пустому элементу). */
+   ak_wcurve wc;
+  /*! \brief Способ вычисления кратных точек и ширина окна. */
+   struct wcurve_pow_policy policy;
+ };
+
+/*! \brief Массив способов вычисления кратных точек, установленных для конкретных кривых. */
+ static struct wcurve_pow_policy_entry wcurve_pow_policies[ ak_wcurve_pow_policy_max_count ];
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+ static pthread_mutex_t wcurve_pow_policies_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция устанавливает способ вычисления кратных точек и ширину окна, используемые
+    функцией ak_wpoint_pow() для заданной кривой; для остальных кривых того же размера
+    способ вычисления не изменяется.
+
+    @param ec Эллиптическая кривая.
+    @param engine Способ вычисления кратных точек (лесенка Монтгомери или метод
+    фиксированного окна).
+    @param width Ширина окна (от 1 до \ref ak_wpoint_window_max_width).
+    @return В случае успеха функция возвращает \ref ak_error_ok (ноль). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_wcurve_set_pow_policy( ak_wcurve ec, wpoint_pow_engine_t engine, size_t width )
+{
+  size_t idx = 0;
+  int error = ak_error_wrong_index;
+
+  if( ec == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                  "using null pointer to elliptic curve context" );
+  if(( engine != wpoint_pow_ladder_engine ) && ( engine != wpoint_pow_window_engine ))
+    return ak_error_message( ak_error_undefined_value, __func__,
+                                       "using multiplication engine unsuitable for secret values" );
+  if(( width < 1 ) || ( width > ak_wpoint_window_max_width ))
+    return ak_error_message( ak_error_wrong_length, __func__, "using wrong window width" );
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &wcurve_pow_policies_mutex );
+#endif
+  for( idx = 0; idx < ak_wcurve_pow_policy_max_count; idx++ ) {
+     struct wcurve_pow_policy_entry *entry = wcurve_pow_policies + idx;
+     if(( entry->wc == NULL ) || ( entry->wc == ec )) {
+       entry->wc = ec;
+       entry->policy.engine = engine;
+       entry->policy.width = width;
+       error = ak_error_ok;
+       break;
+     }
+  }
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &wcurve_pow_policies_mutex );
+#endif
+
+  if( error != ak_error_ok )
+    return ak_error_message( error, __func__, "too many curves with individual policy" );
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция определяет способ вычисления кратных точек и ширину окна для заданной кривой.
+    Если для кривой способ был установлен функцией ak_wcurve_set_pow_policy()
+    (в частности, подобран функцией ak_wcurve_pow_benchmark()), то используется он.
+    В противном случае значения определяются опциями библиотеки `wcurve256_pow_engine`,
+    `wcurve256_pow_width` (для кривых с параметрами длины 256 бит) и `wcurve512_pow_engine`,
+    `wcurve512_pow_width` (для кривых с параметрами длины 512 бит).
+
+    @param ec Эллиптическая кривая.
+    @param policy Структура, в которую помещаются значения.                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wcurve_get_pow_policy( ak_wcurve ec, ak_wcurve_pow_policy policy )
+{
+  size_t idx = 0;
+  bool_t found = ak_false;
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &wcurve_pow_policies_mutex );
+#endif
+  for( idx = 0; idx < ak_wcurve_pow_policy_max_count; idx++ ) {
+     if( wcurve_pow_policies[idx].wc == NULL ) break;
+     if( wcurve_pow_policies[idx].wc == ec ) {
+       *policy = wcurve_pow_policies[idx].policy;
+       found = ak_true;
+       break;
+     }
+  }
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &wcurve_pow_policies_mutex );
+#endif
+  if( found ) return;
+
+  if( ec->size == ak_mpzn256_size ) {
+    policy->engine = ( wpoint_pow_engine_t )
+                          ak_libakrypt_get_option_by_index( ak_option_wcurve256_pow_engine );
+    policy->width = ( size_t ) ak_libakrypt_get_option_by_index( ak_option_wcurve256_pow_width );
+  } else {
+      policy->engine = ( wpoint_pow_engine_t )
+                          ak_libakrypt_get_option_by_index( ak_option_wcurve512_pow_engine );
+      policy->width = ( size_t ) ak_libakrypt_get_option_by_index( ak_option_wcurve512_pow_width );
+    }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет кратную точку \f$ Q = [k]P \f$ заданным способом.
+    Метод гребенки применим только к образующей точке кривой; для других точек
+    используется метод фиксированного окна.
+
+    @param wq Точка \f$ Q \f$, в которую помещается результат.
+    @param wp Точка \f$ P \f$.
+    @param k Степень кратности.
+    @param size Размер степени \f$ k \f$ в машинных словах.
+    @param engine Способ вычисления кратной точки.
+    @param width Ширина окна (используется методом фиксированного окна и методом wNAF).
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow_engine( ak_wpoint wq, ak_wpoint wp, ak_uint64 *k, size_t size,
+                                      wpoint_pow_engine_t engine, size_t width, ak_wcurve ec )
+{
+  switch( engine ) {
+    case wpoint_pow_comb_engine:
+      if(( ak_mpzn_cmp( wp->x, ec->point.x, ec->size ) == 0 ) &&
+         ( ak_mpzn_cmp( wp->y, ec->point.y, ec->size ) == 0 ) &&
+         ( ak_mpzn_cmp( wp->z, ec->point.z, ec->size ) == 0 )) {
+        ak_wpoint_pow_base( wq, k, size, ec );
+        break;
+      }
+      ak_wpoint_pow_window( wq, wp, k, size, width, ec );
+      break;
+    case wpoint_pow_wnaf_engine:
+      ak_wpoint_pow_wnaf( wq, wp, k, size, width, ec );
+      break;
+    case wpoint_pow_window_engine:
+      ak_wpoint_pow_window( wq, wp, k, size, width, ec );
+      break;
+    default:
+      ak_wpoint_pow_ladder( wq, wp, k, size, ec );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для заданной точки \f$ P \f$ и заданного целого числа (вычета) \f$ k \f$
+    функция вычисляет кратную точку \f$ Q = [k]P \f$ способом, определяемым для данной кривой
+    функцией ak_wcurve_get_pow_policy(): лесенкой Монтгомери (функция ak_wpoint_pow_ladder())
+    или методом фиксированного окна (функция ak_wpoint_pow_window(), используется по-умолчанию).
+    Метод фиксированного окна не выполняет операций с бесконечно удаленной точкой и выбирает
+    точки таблицы с наложением маски, поэтому функция может использоваться для секретных
+    значений степени.
+
+    \b Для \b информации:
+     \li Функция не приводит результирующую точку \f$ Q \f$ к аффинной форме.
+     \li Исходная точка \f$ P \f$ и результирующая точка \f$ Q \f$ могут совпадать.
+
+    @param wq Точка \f$ Q \f$, в которую помещается результат.
+    @param wp Точка \f$ P \f$, которая возводится в степень.
+    @param k Степень кратности.
+    @param size Размер степени \f$ k \f$ в машинных словах.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow( ak_wpoint wq, ak_wpoint wp, ak_uint64 *k, size_t size, ak_wcurve ec )
+{
+  struct wcurve_pow_policy policy;
+
+  ak_wcurve_get_pow_policy( ec, &policy );
+  if( policy.engine == wpoint_pow_window_engine )
+    ak_wpoint_pow_window( wq, wp, k, size, policy.width, ec );
+   else ak_wpoint_pow_ladder( wq, wp, k, size, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция возвращает время вычисления заданного количества кратных точек. */
+/* ----------------------------------------------------------------------------------------------- */
+ static clock_t ak_wcurve_pow_benchmark_engine( ak_wcurve ec, ak_uint64 *k, size_t count,
+                                                       wpoint_pow_engine_t engine, size_t width )
+{
+  size_t i;
+  struct wpoint wp;
+  clock_t tmr = clock();
+
+  ak_wpoint_set( &wp, ec );
+  for( i = 0; i < count; i++ )
+     ak_wpoint_pow_engine( &wp, &wp, k + i*ec->size, ec->size, engine, width, ec );
+ return clock() - tmr;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция измеряет время вычисления кратных точек заданной кривой лесенкой Монтгомери и
+    методом фиксированного окна всех допустимых ширин, после чего устанавливает наиболее быстрый
+    способ для заданной кривой функцией ak_wcurve_set_pow_policy(); способ вычисления
+    кратных точек других кривых не изменяется.
+
+    @param ec Эллиптическая кривая.
+    @param count Количество кратных точек, вычисляемых каждым способом.
+    @return В случае успеха функция возвращает \ref ak_error_ok (ноль). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_wcurve_pow_benchmark( ak_wcurve ec, const size_t count )
+{
+  size_t i = 0, width = 0, best_width = 0;
+  ak_uint64 *k = NULL;
+  struct random generator;
+  clock_t tmr, best = 0;
+  int error = ak_error_ok;
+
+  if( ec == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                  "using null pointer to elliptic curve context" );
+  if( count == 0 ) return ak_error_message( ak_error_zero_length, __func__,
+                                                          "using zero number of multiplications" );
+  if(( k = malloc( count*ec->size*sizeof( ak_uint64 ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+  if(( error = ak_random_context_create_lcg( &generator )) != ak_error_ok ) {
+    free( k );
+    return ak_error_message( error, __func__, "incorrect creation of random generator" );
+  }
+  for( i = 0; i < count; i++ )
+     ak_mpzn_set_random_modulo( k + i*ec->size, ec->q, ec->size, &generator );
+  ak_random_context_destroy( &generator );
+
+ /* нулевая ширина окна соответствует лесенке Монтгомери */
+  best = ak_wcurve_pow_benchmark_engine( ec, k, count, wpoint_pow_ladder_engine, 0 );
+  for( width = 2; width <= ak_wpoint_window_max_width; width++ ) {
+     tmr = ak_wcurve_pow_benchmark_engine( ec, k, count, wpoint_pow_window_engine, width );
+     if( tmr < best ) {
+       best = tmr;
+       best_width = width;
+     }
+  }
+  free( k );
+
+ return ak_wcurve_set_pow_policy( ec, best_width ? wpoint_pow_window_engine :
+                                                 wpoint_pow_ladder_engine, ak_max( best_width, 1 ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                 вычисление кратных точек для образующей точки эллиптической кривой              */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество зубьев гребенки, используемой при вычислении кратной образующей точки. */
+ #define ak_wcurve_comb_width             (8)
+/*! \brief Количество точек, хранящихся в таблице гребенки. */
+ #define ak_wcurve_comb_count             ((1 << ak_wcurve_comb_width ) - 1 )
+/*! \brief Ширина окна wNAF представления, используемого для образующей точки. */
+ #define ak_wcurve_base_wnaf_width        (7)
+/*! \brief Количество нечетных кратных образующей точки, хранящихся в таблице. */
+ #define ak_wcurve_base_wnaf_count        ( 1 << ( ak_wcurve_base_wnaf_width - 2 ))
+/*! \brief Ширина окна wNAF представления, используемого для произвольной точки. */
+ #define ak_wpoint_wnaf_width             (5)
+/*! \brief Количество нечетных кратных произвольной точки, вычисляемых перед умножением. */
+ #define ak_wpoint_wnaf_count             ( 1 << ( ak_wpoint_wnaf_width - 2 ))
+/*! \brief Максимальное количество кривых, для которых хранятся таблицы кратных точек. */
+ #define ak_wcurve_base_cache_max_size    (16)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Таблицы кратных значений образующей точки эллиптической кривой.
+    \details Для образующей точки \f$ P \f$ и величины \f$ d = \lceil 64n/w \rceil \f$,
+    где \f$ n \f$ размер параметров кривой в машинных словах, а \f$ w \f$ количество зубьев
+    гребенки, таблица гребенки содержит \f$ 2^w-1 \f$ точек вида
+    \f$ T_j = \sum_{i=0}^{w-1} j_i[2^{id}]P \f$, где \f$ j = \sum_{i=0}^{w-1} j_i2^i \f$.
+    Кроме того, хранятся нечетные кратные \f$ P, [3]P, [5]P, \ldots \f$, используемые при
+    проверке электронной подписи.
+
+    Точки хранятся в аффинной форме, для каждой точки хранятся только \f$ x \f$ и \f$ y \f$
+    координаты в представлении Монтгомери, что позволяет использовать смешанное сложение
+    ak_wpoint_add_affine(). Если для кривой определены параметры эквивалентной кривой Эдвардса, то
+    для каждой точки хранятся величины \f$ u, v \f$ и \f$ duv \f$ в представлении Монтгомери. */
+ struct wcurve_base_table {
+  /*! \brief Эллиптическая кривая, для образующей точки которой вычислена таблица. */
+   ak_wcurve wc;
+  /*! \brief Количество столбцов гребенки (величина \f$ d \f$). */
+   size_t columns;
+  /*! \brief Координаты точек таблицы гребенки (NULL соответствует пустому элементу). */
+   ak_uint64 *comb;
+  /*! \brief Координаты нечетных кратных образующей точки (размещаются в той же области памяти,
+      что и таблица гребенки). */
+   ak_uint64 *odd;
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Кэш таблиц кратных значений образующих точек. */
+ static struct wcurve_base_table wcurve_base_cache[ ak_wcurve_base_cache_max_size ];
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+ static pthread_mutex_t wcurve_base_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет таблицы кратных значений для образующей точки заданной кривой.
+
+    Для вычисления \f$ 2^w-1 \f$ точек таблицы гребенки требуется \f$ (w-1)d \f$ удвоений
+    и \f$ 2^w \f$ сложений точек; все точки таблиц приводятся к аффинной форме
+    функцией ak_wpoint_reduce_batch().
+
+    @param entry Элемент кэша, в который помещается таблица.
+    @param ec Эллиптическая кривая.
+    @return В случае успеха функция возвращает \ref ak_error_ok (ноль). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_wcurve_base_table_create( struct wcurve_base_table *entry, ak_wcurve ec )
+{
+  size_t i, j, l, columns = ( 64*ec->size + ak_wcurve_comb_width - 1 )/ak_wcurve_comb_width;
+  const size_t total = ak_wcurve_comb_count + ak_wcurve_base_wnaf_count;
+  const size_t step = ( ec->edwards == NULL ? 2 : 3 )*ec->size;
+  struct wpoint base[ ak_wcurve_comb_width ], *points = NULL;
+  ak_uint64 *table = NULL, *ptr = NULL;
+
+  if(( table = malloc( total*step*sizeof( ak_uint64 ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                             "incorrect memory allocation for base point table" );
+  if(( points = malloc( total*sizeof( struct wpoint ))) == NULL ) {
+    free( table );
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                             "incorrect memory allocation for base point table" );
+  }
+
+ /* вычисляем точки [2^{id}]P */
+  ak_wpoint_set( base, ec );
+  for( i = 1; i < ak_wcurve_comb_width; i++ ) {
+     ak_wpoint_set_wpoint( base+i, base+i-1, ec );
+     for( j = 0; j < columns; j++ ) ak_wpoint_double( base+i, ec );
+  }
+
+ /* вычисляем точки таблицы: T_j = T_{j-2^i} + [2^{id}]P, где 2^i младший бит числа j */
+  for( j = 1; j <= ak_wcurve_comb_count; j++ ) {
+     for( i = 0; ( j&( (size_t)1 << i )) == 0; i++ );
+     if( j == ( (size_t)1 << i )) ak_wpoint_set_wpoint( points+j-1, base+i, ec );
+      else {
+        ak_wpoint_set_wpoint( points+j-1, points + j - ( (size_t)1 << i ) - 1, ec );
+        ak_wpoint_add( points+j-1, base+i, ec );
+      }
+  }
+
+ /* вычисляем нечетные кратные: [2j+1]P = [2j-1]P + [2]P */
+  ak_wpoint_odd_multiples( points + ak_wcurve_comb_count,
+                                   ak_wcurve_base_wnaf_count, &ec->point, ak_false, ec );
+
+ /* приводим все точки к аффинной форме одним обращением */
+  ak_wpoint_reduce_batch( points, total, ec );
+  if( ec->edwards == NULL ) {
+    for( j = 0; j < total; j++ ) {
+       ptr = table + step*j;
+       ak_wpoint_set_montgomery_affine( points+j, ec );
+       for( l = 0; l < ec->size; l++ ) {
+          ptr[l] = points[j].x[l];
+          ptr[ec->size + l] = points[j].y[l];
+       }
+    }
+  } else {
+     /* отображаем точки на кривую Эдвардса и снова приводим к аффинной форме */
+      for( j = 0; j < total; j++ ) {
+         struct epoint ep;
+         ak_epoint_set_wpoint( &ep, points+j, ec );
+         ak_mpzn_set( points[j].x, ep.x, ec->size );
+         ak_mpzn_set( points[j].y, ep.y, ec->size );
+         ak_mpzn_set( points[j].z, ep.z, ec->size );
+      }
+      ak_wpoint_reduce_batch( points, total, ec );
+      for( j = 0; j < total; j++ ) {
+         ptr = table + step*j;
+         ak_wcurve_mul( ptr, points[j].x, ec->r2, ec );
+         ak_wcurve_mul( ptr + ec->size, points[j].y, ec->r2, ec );
+         ak_wcurve_mul( ptr + 2*ec->size, ptr, ptr + ec->size, ec );
+         ak_wcurve_mul( ptr + 2*ec->size,
+                                     ptr + 2*ec->size, ( ak_uint64 * )ec->edwards->d, ec );
+      }
+    }
+  free( points );
+
+  entry->wc = ec;
+  entry->columns = columns;
+  entry->comb = table;
+  entry->odd = table + step*ak_wcurve_comb_count;
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция возвращает таблицы кратных значений для образующей точки заданной кривой.
+    \details При первом обращении таблица вычисляется и помещается в кэш; последующие
+    обращения используют вычисленное ранее значение.
+    @return Функция возвращает указатель на элемент кэша. Если таблица не может быть
+    вычислена, то возвращается NULL.                                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ static struct wcurve_base_table *ak_wcurve_base_table_get( ak_wcurve ec )
+{
+  size_t idx = 0;
+  struct wcurve_base_table *entry = NULL;
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &wcurve_base_cache_mutex );
+#endif
+  for( idx = 0; idx < ak_wcurve_base_cache_max_size; idx++ ) {
+     if( wcurve_base_cache[idx].comb == NULL ) {
+       if( ak_wcurve_base_table_create( wcurve_base_cache+idx, ec ) == ak_error_ok )
+         entry = wcurve_base_cache+idx;
+       break;
+     }
+     if( wcurve_base_cache[idx].wc == ec ) {
+       entry = wcurve_base_cache+idx;
+       break;
+     }
+  }
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &wcurve_base_cache_mutex );
+#endif
+
+ return entry;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция уничтожает все вычисленные ранее таблицы кратных значений образующих точек.
+    Вызывается при завершении работы с библиотекой.
+
+    @return Функция возвращает \ref ak_error_ok (ноль).                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_wcurve_base_cache_clear( void )
+{
+  size_t idx = 0;
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &wcurve_base_cache_mutex );
+#endif
+  for( idx = 0; idx < ak_wcurve_base_cache_max_size; idx++ ) {
+     struct wcurve_base_table *entry = wcurve_base_cache + idx;
+     if( entry->comb == NULL ) continue;
+     free( entry->comb );
+     entry->comb = NULL;
+     entry->odd = NULL;
+     entry->wc = NULL;
+     entry->columns = 0;
+  }
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &wcurve_base_cache_mutex );
+#endif
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция возвращает индекс точки таблицы гребенки, составленный из битов
+    столбца \f$ c \f$ числа \f$ k \f$.                                                         */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline ak_uint64 ak_wcurve_comb_index( ak_uint64 *k, size_t size, size_t columns, size_t c )
+{
+  size_t i, bit;
+  ak_uint64 idx = 0;
+
+  for( i = 0; i < ak_wcurve_comb_width; i++ ) {
+     if(( bit = i*columns + c ) >= 64*size ) break;
+     idx |= (( k[bit >> 6] >> ( bit&0x3f ))&0x1 ) << i;
+  }
+ return idx;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление кратной образующей точки методом гребенки на кривой Эдвардса.
+    \details Поскольку формулы сложения точек кривой Эдвардса не имеют исключительных случаев,
+    вычисления начинаются с нейтрального элемента, а нулевому столбцу гребенки соответствует
+    прибавление нейтрального элемента \f$ (0, 1) \f$. Выбор точки таблицы выполняется
+    просмотром всей таблицы с наложением маски; для уменьшения объема просматриваемой памяти
+    выбираются только величины \f$ u, v \f$, а величина \f$ duv \f$ вычисляется заново.      */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wpoint_pow_base_edwards( ak_wpoint wq, ak_uint64 *k, size_t size,
+                                                struct wcurve_base_table *entry, ak_wcurve ec )
+{
+  size_t c, j, l;
+  ak_uint64 idx, mask, *ptr = NULL;
+  ak_mpznmax su, sv, sdt, one;
+  struct epoint Q;
+
+  ak_mpzn_set_ui( one, ec->size, 1 );
+  ak_wcurve_mul( one, one, ec->r2, ec ); /* единица в представлении Монтгомери */
+  ak_epoint_set_as_unit( &Q, ec );
+  for( c = entry->columns; c > 0; c-- ) {
+     ak_epoint_double( &Q, ec );
+     idx = ak_wcurve_comb_index( k, size, entry->columns, c-1 );
+
+    /* выбираем точку таблицы, просматривая всю таблицу */
+     mask = (( idx | ( 0 - idx )) >> 63 ) - 1;
+     for( l = 0; l < ec->size; l++ ) {
+        su[l] = 0; sv[l] = one[l]&mask;
+     }
+     for( j = 1, ptr = entry->comb; j <= ak_wcurve_comb_count; j++, ptr += 3*ec->size ) {
+        mask = idx^j;
+        mask = (( mask | ( 0 - mask )) >> 63 ) - 1;
+        for( l = 0; l < ec->size; l++ ) {
+           su[l] |= ptr[l]&mask;
+           sv[l] |= ptr[ec->size + l]&mask;
+        }
+     }
+     ak_wcurve_mul( sdt, su, sv, ec );
+     ak_wcurve_mul( sdt, sdt, ( ak_uint64 * )ec->edwards->d, ec );
+     ak_epoint_add_values( &Q, su, sv, sdt, NULL, ec );
+  }
+
+  ak_wpoint_set_epoint( wq, &Q, ec );
+  memset( &Q, 0, sizeof( struct epoint ));
+  memset( su, 0, sizeof( su ));
+  memset( sv, 0, sizeof( sv ));
+  memset( sdt, 0, sizeof( sdt ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для образующей точки \f$ P \f$ эллиптической кривой и заданного целого числа (вычета)
+    \f$ k \f$ функция вычисляет кратную точку \f$ Q = [k]P \f$ с использованием
+    предвычисленной таблицы гребенки (comb method).
+
+    Для числа \f$ k \f$, представленного в виде \f$ k = \sum_{i=0}^{w-1}\sum_{c=0}^{d-1}
+    k_{id+c}2^{id+c} \f$, вычисления производятся по столбцам гребенки: для каждого
+    \f$ c = d-1, \ldots, 0 \f$ точка \f$ Q \f$ удваивается, после чего к ней прибавляется
+    точка таблицы \f$ T_j \f$, где \f$ j = \sum_{i=0}^{w-1}k_{id+c}2^i \f$. Таким образом,
+    вместо \f$ 64n \f$ удвоений и сложений выполняется только \f$ d \f$ удвоений и сложений.
+
+    Для выравнивания времени вычислений
+     \li выбор точки таблицы выполняется просмотром всех точек таблицы с наложением маски,
+     \li сложение выполняется и для нулевого столбца гребенки, результат которого
+     отбрасывается наложением маски,
+     \li начальным значением точки \f$ Q \f$ является точка \f$ P \f$, а не бесконечно удаленная
+     точка; в конце вычислений из результата вычитается точка \f$ [2^d]P = T_2\f$.
+
+    Если для кривой определены параметры эквивалентной кривой Эдвардса, то вычисления
+    выполняются на кривой Эдвардса, а результат отображается обратно на исходную кривую.
+
+    Таблица гребенки вычисляется при первом вызове функции для заданной кривой и хранится
+    до завершения работы с библиотекой. Если таблица не может быть вычислена, либо размер
+    числа \f$ k \f$ отличен от размера параметров кривой, используется функция ak_wpoint_pow().
+
+    \b Для \b информации: Функция не приводит результирующую точку \f$ Q \f$ к аффинной форме.
+
+    @param wq Точка \f$ Q \f$, в которую помещается результат.
+    @param k Степень кратности.
+    @param size Размер степени \f$ k \f$ в машинных словах.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow_base( ak_wpoint wq, ak_uint64 *k, size_t size, ak_wcurve ec )
+{
+  size_t c, j, l;
+  ak_uint64 idx, mask, *ptr = NULL;
+  struct wpoint Q, R, S;
+  struct wcurve_base_table *entry = NULL;
+
+  if(( size != ec->size ) || (( entry = ak_wcurve_base_table_get( ec )) == NULL )) {
+    ak_wpoint_pow( wq, &ec->point, k, size, ec );
+    return;
+  }
+  if( ec->edwards != NULL ) {
+    ak_wpoint_pow_base_edwards( wq, k, size, entry, ec );
+    return;
+  }
+
+  ak_wpoint_set( &Q, ec );
+  ak_mpzn_set_ui( S.z, ec->size, 1 );
+  ak_wcurve_mul( S.z, S.z, ec->r2, ec ); /* единица в представлении Монтгомери */
+  for( c = entry->columns; c > 0; c-- ) {
+     ak_wpoint_double( &Q, ec );
+
+    /* формируем индекс точки таблицы из битов очередного столбца */
+     idx = ak_wcurve_comb_index( k, size, entry->columns, c-1 );
+
+    /* выбираем точку таблицы, просматривая всю таблицу */
+     memset( S.x, 0, ec->size*sizeof( ak_uint64 ));
+     memset( S.y, 0, ec->size*sizeof( ak_uint64 ));
+     for( j = 1, ptr = entry->comb; j <= ak_wcurve_comb_count; j++, ptr += 2*ec->size ) {
+        mask = idx^j;
+        mask = (( mask | ( 0 - mask )) >> 63 ) - 1;
+        for( l = 0; l < ec->size; l++ ) {
+           S.x[l] |= ptr[l]&mask;
+           S.y[l] |= ptr[ec->size + l]&mask;
+        }
+     }
+
+    /* складываем точки и оставляем результат только для ненулевого столбца */
+     ak_wpoint_set_wpoint( &R, &Q, ec );
+     ak_wpoint_add_affine( &R, &S, ec );
+     mask = 0 - (( idx | ( 0 - idx )) >> 63 );
+     for( l = 0; l < ec->size; l++ ) {
+        Q.x[l] ^= ( Q.x[l]^R.x[l] )&mask;
+        Q.y[l] ^= ( Q.y[l]^R.y[l] )&mask;
+        Q.z[l] ^= ( Q.z[l]^R.z[l] )&mask;
+     }
+  }
+
+ /* вычитаем начальное значение [2^d]P */
+  ptr = entry->comb + 2*ec->size;
+  memcpy( S.x, ptr, ec->size*sizeof( ak_uint64 ));
+  ak_mpzn_sub( S.y, ec->p, ptr + ec->size, ec->size );
+  ak_wpoint_add_affine( &Q, &S, ec );
+
+  ak_wpoint_set_wpoint( wq, &Q, ec );
+  memset( &R, 0, sizeof( struct wpoint ));
+  memset( &S, 0, sizeof( struct wpoint ));
+  memset( &Q, 0, sizeof( struct wpoint ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет wNAF представление числа \f$ k \f$ с заданной шириной окна.
+    \details Число представляется в виде \f$ k = \sum_i k_i2^i \f$, где каждое ненулевое
+    значение \f$ k_i \f$ нечетно, удовлетворяет неравенству \f$ |k_i| < 2^{w-1} \f$, и среди
+    любых \f$ w \f$ последовательных значений не более одного отлично от нуля.
+
+    @param naf Массив, в который помещаются значения \f$ k_i \f$; должен содержать
+    не менее \f$ 64n+1 \f$ элементов.
+    @param k Число \f$ k \f$.
+    @param size Размер числа \f$ k \f$ в машинных словах (величина \f$ n \f$).
+    @param width Ширина окна \f$ w \f$.
+    @return Функция возвращает количество значащих элементов массива naf.                          */
+/* ----------------------------------------------------------------------------------------------- */
+ static size_t ak_wpoint_wnaf( ak_int8 *naf, ak_uint64 *k, const size_t size, const size_t width )
+{
+  ak_int64 d;
+  size_t i, j, len = 0;
+  ak_uint64 c, v, t[ ak_mpzn512_size+1 ], mask = ( (ak_uint64)1 << width ) - 1;
+
+  memcpy( t, k, size*sizeof( ak_uint64 ));
+  t[size] = 0;
+  for( i = 0; i <= 64*size; i++ ) {
+     d = 0;
+     if( t[0]&0x1 ) {
+       d = ( ak_int64 )( t[0]&mask );
+       if( d >= (( ak_int64 )1 << ( width-1 ))) d -= (( ak_int64 )1 << width );
+       if( d > 0 ) { /* t <- t - d */
+         for( j = 0, c = ( ak_uint64 )d; ( j <= size ) && c; j++ ) {
+            v = t[j];
+            t[j] = v - c;
+            c = ( v < c );
+         }
+       } else { /* t <- t + |d| */
+           for( j = 0, c = ( ak_uint64 )( -d ); ( j <= size ) && c; j++ ) {
+              t[j] += c;
+              c = ( t[j] < c );
+           }
+         }
+       len = i+1;
+     }
+     naf[i] = ( ak_int8 )d;
+     for( j = 0; j < size; j++ ) t[j] = ( t[j] >> 1 )^( t[j+1] << 63 );
+     t[size] >>= 1;
+  }
+ return len;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для заданной точки \f$ R \f$ функция вычисляет ее нечетные кратные
+    \f$ R, [3]R, [5]R, \ldots, [2m-1]R \f$, где \f$ m \f$ количество вычисляемых точек.
+
+    @param table Массив, в который помещаются вычисленные точки; должен содержать
+    не менее \f$ m \f$ элементов.
+    @param count Количество вычисляемых точек \f$ m \f$.
+    @param wp Точка \f$ R \f$.
+    @param reduce Если значение истинно, то вычисленные точки приводятся к аффинной форме
+    одним обращением (см. ak_wpoint_reduce_batch()), а их координаты переводятся
+    в представление Монтгомери для использования в функции ak_wpoint_add_affine().
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_odd_multiples( ak_wpoint table, size_t count, ak_wpoint wp,
+                                                                  bool_t reduce, ak_wcurve ec )
+{
+  size_t l;
+  struct wpoint T;
+
+  if( count == 0 ) return;
+  ak_wpoint_set_wpoint( table, wp, ec );
+  ak_wpoint_set_wpoint( &T, wp, ec );
+  ak_wpoint_double( &T, ec );
+  for( l = 1; l < count; l++ ) {
+     ak_wpoint_set_wpoint( table+l, table+l-1, ec );
+     ak_wpoint_add( table+l, &T, ec );
+  }
+  if( reduce ) {
+    ak_wpoint_reduce_batch( table, count, ec );
+    for( l = 0; l < count; l++ ) ak_wpoint_set_montgomery_affine( table+l, ec );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление суммы кратных значений образующей и заданной точек методом Штрауса
+    на кривой Эдвардса.
+    \details Нечетные кратные точки \f$ R \f$ отображаются на кривую Эдвардса, при этом
+    вместо координаты \f$ T \f$ сохраняется величина \f$ dT \f$. Противоположная точка
+    к точке \f$ (X:Y:T:Z) \f$ имеет вид \f$ (-X:Y:-T:Z) \f$.                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wpoint_pow_joint_edwards( ak_wpoint wq, ak_int8 *naf1, ak_wpoint table,
+           size_t width, ak_int8 *naf2, size_t len, struct wcurve_base_table *entry, ak_wcurve ec )
+{
+  long long int i;
+  ak_uint64 *ptr = NULL;
+  ak_mpznmax u, dt, zero = ak_mpznmax_zero;
+  size_t l, step = 3*ec->size, count = ( size_t )1 << ( width-2 );
+  struct epoint Q, etable[ 1 << 6 ];
+
+  for( l = 0; l < count; l++ ) {
+     ak_epoint_set_wpoint( etable+l, table+l, ec );
+     ak_wcurve_mul( etable[l].t, etable[l].t, ( ak_uint64 * )ec->edwards->d, ec );
+  }
+
+  ak_epoint_set_as_unit( &Q, ec );
+  for( i = ( long long int )len - 1; i >= 0; i-- ) {
+     ak_epoint_double( &Q, ec );
+     if( naf1[i] != 0 ) {
+       ptr = entry->odd + step*(( naf1[i] > 0 ? naf1[i] : -naf1[i] ) >> 1 );
+       if( naf1[i] > 0 ) ak_epoint_add_values( &Q, ptr, ptr + ec->size, ptr + 2*ec->size, NULL, ec );
+        else {
+          ak_wcurve_sub( u, zero, ptr, ec );
+          ak_wcurve_sub( dt, zero, ptr + 2*ec->size, ec );
+          ak_epoint_add_values( &Q, u, ptr + ec->size, dt, NULL, ec );
+        }
+     }
+     if( naf2[i] != 0 ) {
+       ak_epoint ep = etable + (( naf2[i] > 0 ? naf2[i] : -naf2[i] ) >> 1 );
+       if( naf2[i] > 0 ) ak_epoint_add_values( &Q, ep->x, ep->y, ep->t, ep->z, ec );
+        else {
+          ak_wcurve_sub( u, zero, ep->x, ec );
+          ak_wcurve_sub( dt, zero, ep->t, ec );
+          ak_epoint_add_values( &Q, u, ep->y, dt, ep->z, ec );
+        }
+     }
+  }
+  ak_wpoint_set_epoint( wq, &Q, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для образующей точки \f$ P \f$ эллиптической кривой, точки \f$ R \f$, заданной массивом своих
+    нечетных кратных, и двух целых чисел (вычетов) \f$ k_1, k_2 \f$ функция вычисляет точку
+    \f$ Q = [k_1]P + [k_2]R \f$.
+
+    При вычислении используется метод Штрауса (Straus, Shamir's trick): числа \f$ k_1 \f$
+    и \f$ k_2 \f$ представляются в wNAF форме, после чего оба слагаемых вычисляются в одном
+    цикле с общими удвоениями. Для точки \f$ P \f$ используются хранящиеся в кэше нечетные
+    кратные (ширина окна 7), для точки \f$ R \f$ используются нечетные кратные, переданные
+    в функцию. Таким образом, вместо двух лесенок Монтгомери, каждая из которых содержит
+    \f$ 64n \f$ удвоений и сложений, выполняется \f$ 64n \f$ удвоений и, в среднем,
+    \f$ 64n/8 + 64n/(w+1) \f$ сложений. Если для кривой определены параметры эквивалентной
+    кривой Эдвардса, то вычисления выполняются на кривой Эдвардса. Точки таблиц, заданные
+    в аффинной форме, прибавляются функцией ak_wpoint_add_affine().
+
+    \warning Время работы функции зависит от значений \f$ k_1 \f$ и \f$ k_2 \f$, поэтому функция
+    должна использоваться только для открытых данных, например, при проверке электронной
+    подписи.
+
+    \b Для \b информации: Функция не приводит результирующую точку \f$ Q \f$ к аффинной форме.
+
+    @param wq Точка \f$ Q \f$, в которую помещается результат.
+    @param k1 Степень кратности образующей точки.
+    @param table Массив нечетных кратных \f$ R, [3]R, \ldots, [2^{w-1}-1]R \f$,
+    вычисленный функцией ak_wpoint_odd_multiples().
+    @param width Ширина окна \f$ w \f$, соответствующая массиву table (не менее 2 и не более 8).
+    @param k2 Степень кратности точки \f$ R \f$.
+    @param size Размер степеней \f$ k_1 \f$ и \f$ k_2 \f$ в машинных словах.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow_joint_table( ak_wpoint wq, ak_uint64 *k1, ak_wpoint table, size_t width,
+                                                         ak_uint64 *k2, size_t size, ak_wcurve ec )
+{
+  long long int i;
+  size_t len1, len2;
+  ak_uint64 *ptr = NULL;
+  ak_mpznmax one;
+  struct wpoint Q, T;
+  struct wcurve_base_table *entry = NULL;
+  ak_int8 naf1[ 64*ak_mpzn512_size+1 ], naf2[ 64*ak_mpzn512_size+1 ];
+
+  if(( size != ec->size ) || (( entry = ak_wcurve_base_table_get( ec )) == NULL )) {
+    ak_wpoint_pow( &Q, &ec->point, k1, size, ec );
+    ak_wpoint_pow( &T, table, k2, size, ec );
+    ak_wpoint_add( &Q, &T, ec );
+    ak_wpoint_set_wpoint( wq, &Q, ec );
+    return;
+  }
+
+  len1 = ak_wpoint_wnaf( naf1, k1, size, ak_wcurve_base_wnaf_width );
+  len2 = ak_wpoint_wnaf( naf2, k2, size, width );
+  if( ec->edwards != NULL ) {
+    ak_wpoint_pow_joint_edwards( wq, naf1, table, width, naf2, ak_max( len1, len2 ), entry, ec );
+    return;
+  }
+
+  ak_mpzn_set_ui( one, size, 1 );
+  ak_wcurve_mul( one, one, ec->r2, ec ); /* единица в представлении Монтгомери */
+
+  ak_wpoint_set_as_unit( &Q, ec );
+  for( i = ( long long int )ak_max( len1, len2 ) - 1; i >= 0; i-- ) {
+     ak_wpoint_double( &Q, ec );
+     if( naf1[i] != 0 ) {
+       ptr = entry->odd + 2*size*(( naf1[i] > 0 ? naf1[i] : -naf1[i] ) >> 1 );
+       memcpy( T.x, ptr, size*sizeof( ak_uint64 ));
+       if( naf1[i] > 0 ) memcpy( T.y, ptr + size, size*sizeof( ak_uint64 ));
+        else ak_mpzn_sub( T.y, ec->p, ptr + size, size );
+       ak_mpzn_set( T.z, one, size );
+       ak_wpoint_add_affine( &Q, &T, ec );
+     }
+     if( naf2[i] != 0 ) {
+       ak_wpoint_set_wpoint( &T, table + (( naf2[i] > 0 ? naf2[i] : -naf2[i] ) >> 1 ), ec );
+       if( naf2[i] < 0 ) ak_mpzn_sub( T.y, ec->p, T.y, size );
+      /* точки, приведенные функцией ak_wpoint_odd_multiples(), складываются смешанным способом */
+       if( ak_mpzn_cmp( T.z, one, size ) == 0 ) ak_wpoint_add_affine( &Q, &T, ec );
+        else ak_wpoint_add( &Q, &T, ec );
+     }
+  }
+  ak_wpoint_set_wpoint( wq, &Q, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для образующей точки \f$ P \f$ эллиптической кривой, заданной точки \f$ R \f$
+    и двух целых чисел (вычетов) \f$ k_1, k_2 \f$ функция вычисляет точку
+    \f$ Q = [k_1]P + [k_2]R \f$. Нечетные кратные точки \f$ R \f$ вычисляются при каждом
+    вызове функции (ширина окна 5), после чего вызывается функция ak_wpoint_pow_joint_table().
+
+    \warning Время работы функции зависит от значений \f$ k_1 \f$ и \f$ k_2 \f$, поэтому функция
+    должна использоваться только для открытых данных.
+
+    @param wq Точка \f$ Q \f$, в которую помещается результат.
+    @param k1 Степень кратности образующей точки.
+    @param wp Точка \f$ R \f$.
+    @param k2 Степень кратности точки \f$ R \f$.
+    @param size Размер степеней \f$ k_1 \f$ и \f$ k_2 \f$ в машинных словах.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow_joint( ak_wpoint wq, ak_uint64 *k1, ak_wpoint wp, ak_uint64 *k2,
+                                                                      size_t size, ak_wcurve ec )
+{
+  struct wpoint table[ ak_wpoint_wnaf_count ];
+
+  ak_wpoint_odd_multiples( table, ak_wpoint_wnaf_count, wp, ak_false, ec );
+  ak_wpoint_pow_joint_table( wq, k1, table, ak_wpoint_wnaf_width, k2, size, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для заданной точки \f$ P = (x:y:z) \f$ функция проверяет
+    что порядок точки действительно есть величина \f$ q \f$, заданная в параметрах
+    эллиптической кривой, то есть проверяется выполнимость равенства \f$ [q]P = \mathcal O\f$,
+    где \f$ \mathcal O \f$ - бесконечно удаленная точка (ноль группы точек эллиптической кривой),
+    а \f$ q \f$ порядок подгруппы, в которой реализуются вычисления.
+
+    @param wp точка \f$ P \f$ эллиптической кривой
+    @param ec эллиптическая кривая, на принадлежность которой проверяется точка \f$P\f$.
+
+    @return Функция возвращает \ref ak_true если все проверки выполнены. В противном случае
+    возвращается \ref ak_false.                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_wpoint_check_order( ak_wpoint wp, ak_wcurve ec )
+{
+  struct wpoint ep;
+
+  ak_wpoint_set_as_unit( &ep, ec );
+ /* порядок подгруппы является открытым значением */
+  ak_wpoint_pow_wnaf( &ep, wp, ec->q, ec->size, ak_wpoint_wnaf_width, ec );
+  return ak_mpzn_cmp_ui( ep.z, ec->size, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \example test-wcurve01.c                                                                   */
 /* ----------------------------------------------------------------------------------------------- */
 /*                                                                                    ak_curves.c  */
 /* ----------------------------------------------------------------------------------------------- */
@@ -15,6 +15,62 @@
 /*! \brief Контекст эллиптической кривой, заданной в короткой форме Вейерштрасса. */
  typedef struct wcurve *ak_wcurve;
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция, реализующая двуместную операцию в конечном поле эллиптической кривой. */
+ typedef void ( ak_function_wcurve_binary )( ak_uint64 *, ak_uint64 *, ak_uint64 *, ak_wcurve );
+/*! \brief Функция, реализующая одноместную операцию в конечном поле эллиптической кривой. */
+ typedef void ( ak_function_wcurve_unary )( ak_uint64 *, ak_uint64 *, ak_wcurve );
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Набор функций, реализующих арифметику в конечном поле, над которым определена
+    эллиптическая кривая.
+
+    Все функции работают с вычетами в представлении Монтгомери по модулю \f$ p \f$ кривой.
+    Реализация выбирается для каждой кривой отдельно, в зависимости от вида модуля.                */
+/* ----------------------------------------------------------------------------------------------- */
+ struct wcurve_arithmetic {
+  /*! \brief Умножение двух вычетов. */
+   ak_function_wcurve_binary *mul;
+  /*! \brief Возведение вычета в квадрат. */
+   ak_function_wcurve_unary *sqr;
+  /*! \brief Сложение двух вычетов. */
+   ak_function_wcurve_binary *add;
+  /*! \brief Вычитание двух вычетов. */
+   ak_function_wcurve_binary *sub;
+};
+/*! \brief Указатель на набор функций арифметики конечного поля. */
+ typedef const struct wcurve_arithmetic *ak_wcurve_arithmetic;
+
+/*! \brief Арифметика Монтгомери для модулей произвольного вида. */
+ extern const struct wcurve_arithmetic wcurve_arithmetic_montgomery;
+/*! \brief Арифметика для модулей вида \f$ 2^{64n} - c \f$ (псевдо-мерсенновых простых чисел). */
+ extern const struct wcurve_arithmetic wcurve_arithmetic_pseudo_mersenne;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Параметры скрученной кривой Эдвардса, бирационально эквивалентной эллиптической кривой,
+    заданной в короткой форме Вейерштрасса.
+
+    Если кубический многочлен \f$ x^3 + ax + b \f$ имеет корень \f$ t \f$ в поле \f$ \mathbb F_p \f$,
+    а величина \f$ s \f$ удовлетворяет равенствам \f$ s^2 = a + 3t^2 \f$ и \f$ 3t + 2s = 1 \f$,
+    то отображение \f$ u = (x-t)/y, v = (x-t-s)/(x-t+s) \f$ переводит точки кривой
+    \f$ y^2 = x^3 + ax + b \f$ в точки кривой Эдвардса \f$ u^2 + v^2 = 1 + du^2v^2 \f$,
+    где \f$ d = 3t - 2s \f$. Если величина \f$ d \f$ не является квадратом
+    в поле \f$ \mathbb F_p \f$, то формулы сложения точек кривой Эдвардса не имеют
+    исключительных случаев.
+
+    Все величины хранятся в представлении Монтгомери.                                              */
+/* ----------------------------------------------------------------------------------------------- */
+ struct wcurve_edwards {
+  /*! \brief Коэффициент \f$ d \f$ кривой Эдвардса. */
+   ak_uint64 d[ak_mpzn512_size];
+  /*! \brief Величина \f$ s \f$, используемая при отображении точек. */
+   ak_uint64 s[ak_mpzn512_size];
+  /*! \brief Корень \f$ t \f$ многочлена \f$ x^3 + ax + b \f$. */
+   ak_uint64 t[ak_mpzn512_size];
+};
+/*! \brief Указатель на параметры кривой Эдвардса. */
+ typedef const struct wcurve_edwards *ak_wcurve_edwards;
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Класс, реализующий точку эллиптической кривой.
 
@@ -35,6 +91,8 @@
 };
 /*! \brief Контекст точки эллиптической кривой в короткой форме Вейерштрасса */
  typedef struct wpoint *ak_wpoint;
+/*! \brief Функция, реализующая удвоение точки эллиптической кривой. */
+ typedef void ( ak_function_wpoint_double )( ak_wpoint, ak_wcurve );
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Инициализация и присвоение контексту значения образующей точки эллиптической кривой. */
@@ -51,12 +109,71 @@
 
 /*! \brief Удвоение точки эллиптической кривой, заданной в короткой форме Вейерштрасса. */
  void ak_wpoint_double( ak_wpoint , ak_wcurve );
+/*! \brief Удвоение точки эллиптической кривой с коэффициентом \f$ a = -3 \f$. */
+ void ak_wpoint_double_minus3( ak_wpoint , ak_wcurve );
 /*! \brief Прибавление к одной точке эллиптической кривой значения другой точки. */
  void ak_wpoint_add( ak_wpoint , ak_wpoint , ak_wcurve );
+/*! \brief Прибавление к точке эллиптической кривой точки, заданной в аффинной форме
+    в представлении Монтгомери (смешанное сложение). */
+ void ak_wpoint_add_affine( ak_wpoint , ak_wpoint , ak_wcurve );
 /*! \brief Приведение проективной точки к аффинному виду. */
  void ak_wpoint_reduce( ak_wpoint , ak_wcurve );
-/*! \brief Вычисление кратной точки эллиптической кривой. */
+/*! \brief Одновременное приведение массива проективных точек к аффинному виду. */
+ void ak_wpoint_reduce_batch( ak_wpoint , size_t , ak_wcurve );
+/*! \brief Вычисление кратной точки эллиптической кривой способом, определяемым для кривой. */
  void ak_wpoint_pow( ak_wpoint , ak_wpoint , ak_uint64 *, size_t , ak_wcurve );
+/*! \brief Вычисление кратной точки эллиптической кривой методом лесенки Монтгомери. */
+ void ak_wpoint_pow_ladder( ak_wpoint , ak_wpoint , ak_uint64 *, size_t , ak_wcurve );
+/*! \brief Вычисление кратной точки эллиптической кривой методом фиксированного окна. */
+ void ak_wpoint_pow_window( ak_wpoint , ak_wpoint , ak_uint64 *, size_t , size_t , ak_wcurve );
+/*! \brief Вычисление кратной точки эллиптической кривой с использованием wNAF представления
+    (для открытых данных). */
+ void ak_wpoint_pow_wnaf( ak_wpoint , ak_wpoint , ak_uint64 *, size_t , size_t , ak_wcurve );
+/*! \brief Вычисление кратной точки для образующей точки эллиптической кривой. */
+ void ak_wpoint_pow_base( ak_wpoint , ak_uint64 *, size_t , ak_wcurve );
+/*! \brief Вычисление нечетных кратных значений заданной точки. */
+ void ak_wpoint_odd_multiples( ak_wpoint , size_t , ak_wpoint , bool_t , ak_wcurve );
+/*! \brief Вычисление суммы кратных значений образующей и заданной точек (для открытых данных). */
+ void ak_wpoint_pow_joint( ak_wpoint , ak_uint64 *, ak_wpoint , ak_uint64 *, size_t , ak_wcurve );
+/*! \brief Вычисление суммы кратных значений образующей и заданной точек с использованием
+    предвычисленных нечетных кратных (для открытых данных). */
+ void ak_wpoint_pow_joint_table( ak_wpoint , ak_uint64 *, ak_wpoint , size_t ,
+                                                                ak_uint64 *, size_t , ak_wcurve );
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество сумм кратных точек, вычисляемых векторной реализацией одновременно. */
+ #define ak_wpoint_lanes_count          (8)
+
+/*! \brief Проверка доступности векторной реализации вычисления сумм кратных точек. */
+ bool_t ak_wcurve_lanes_is_available( ak_wcurve );
+/*! \brief Одновременное вычисление нескольких сумм кратных значений образующей и заданных точек
+    (для открытых данных). */
+ int ak_wpoint_pow_joint_lanes( ak_wpoint , ak_uint64 *, ak_wpoint *, ak_uint64 *,
+                                                                       const size_t , ak_wcurve );
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Максимальная ширина окна, используемая методом фиксированного окна. */
+ #define ak_wpoint_window_max_width     (6)
+
+/*! \brief Способ вычисления кратной точки эллиптической кривой. */
+ typedef enum {
+  /*! \brief Лесенка Монтгомери. */
+   wpoint_pow_ladder_engine = 0,
+  /*! \brief Метод фиксированного окна, точки таблицы выбираются без ветвлений. */
+   wpoint_pow_window_engine = 1,
+  /*! \brief Метод, использующий wNAF представление степени (только для открытых данных). */
+   wpoint_pow_wnaf_engine = 2,
+  /*! \brief Метод гребенки (только для образующей точки кривой). */
+   wpoint_pow_comb_engine = 3
+ } wpoint_pow_engine_t;
+
+/*! \brief Способ вычисления кратных точек, используемый для заданной кривой. */
+ typedef struct wcurve_pow_policy {
+  /*! \brief Способ вычисления кратной точки для секретных значений степени. */
+   wpoint_pow_engine_t engine;
+  /*! \brief Ширина окна для метода фиксированного окна. */
+   size_t width;
+ } *ak_wcurve_pow_policy;
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Класс, реализующий эллиптическую кривую, заданную в короткой форме Вейерштрасса
@@ -101,8 +218,33 @@
  /*! \brief Строка, содержащая символьную запись модуля \f$ p \f$.
      \details Используется для проверки корректного хранения параметров кривой в памяти. */
   const char *pchar;
+ /*! \brief Набор функций, реализующих арифметику в конечном поле.
+     \details Если значение не определено (равно NULL), используется арифметика Монтгомери
+     \ref wcurve_arithmetic_montgomery. */
+  ak_wcurve_arithmetic arithmetic;
+ /*! \brief Параметры эквивалентной кривой Эдвардса.
+     \details Если значение определено, то вычисление кратных точек выполняется
+     на кривой Эдвардса, при этом входные и выходные точки задаются в форме Вейерштрасса. */
+  ak_wcurve_edwards edwards;
+ /*! \brief Функция удвоения точки, учитывающая вид коэффициента \f$ a \f$ кривой.
+     \details Если значение не определено (равно NULL), используются формулы удвоения
+     для произвольного значения \f$ a \f$. */
+  ak_function_wpoint_double *point_double;
 };
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Набор функций арифметики конечного поля, используемый заданной кривой. */
+ #define ak_wcurve_get_arithmetic( ec ) \
+                 (( ec )->arithmetic == NULL ? &wcurve_arithmetic_montgomery : ( ec )->arithmetic )
+/*! \brief Умножение вычетов в представлении Монтгомери по модулю \f$ p \f$ кривой. */
+ #define ak_wcurve_mul( z, x, y, ec ) ak_wcurve_get_arithmetic( ec )->mul( z, x, y, ec )
+/*! \brief Возведение вычета в квадрат в представлении Монтгомери по модулю \f$ p \f$ кривой. */
+ #define ak_wcurve_sqr( z, x, ec ) ak_wcurve_get_arithmetic( ec )->sqr( z, x, ec )
+/*! \brief Сложение вычетов по модулю \f$ p \f$ кривой. */
+ #define ak_wcurve_add( z, x, y, ec ) ak_wcurve_get_arithmetic( ec )->add( z, x, y, ec )
+/*! \brief Вычитание вычетов по модулю \f$ p \f$ кривой. */
+ #define ak_wcurve_sub( z, x, y, ec ) ak_wcurve_get_arithmetic( ec )->sub( z, x, y, ec )
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Вычисление дискриминанта эллиптической кривой, заданной в короткой форме Вейерштрасса. */
  void ak_mpzn_set_wcurve_discriminant( ak_uint64 *, ak_wcurve );
@@ -115,6 +257,17 @@
 /*! \brief Функция тестирует все определяемые библиотекой параметры эллиптических кривых,
     заданных в короткой форме Вейерштрасса. */
  bool_t ak_wcurve_test( void );
+/*! \brief Уничтожение таблиц, используемых для вычисления кратных образующих точек. */
+ int ak_wcurve_base_cache_clear( void );
+/*! \brief Установление способа вычисления кратных точек для заданной кривой. */
+ int ak_wcurve_set_pow_policy( ak_wcurve , wpoint_pow_engine_t , size_t );
+/*! \brief Определение способа вычисления кратных точек для заданной кривой. */
+ void ak_wcurve_get_pow_policy( ak_wcurve , ak_wcurve_pow_policy );
+/*! \brief Вычисление кратной точки эллиптической кривой заданным способом. */
+ void ak_wpoint_pow_engine( ak_wpoint , ak_wpoint , ak_uint64 *, size_t ,
+                                                       wpoint_pow_engine_t , size_t , ak_wcurve );
+/*! \brief Выбор наиболее быстрого способа вычисления кратных точек для используемой платформы. */
+ int ak_wcurve_pow_benchmark( ak_wcurve , const size_t );
 
 #endif
 /* ----------------------------------------------------------------------------------------------- */
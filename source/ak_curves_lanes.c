@@ -0,0 +1,651 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Copyright (c) 2014 - 2019 by Axel Kenzo, axelkenzo@mail.ru                                     */
+/*                                                                                                 */
+/*  Файл ak_curves_lanes.с                                                                         */
+/*  - содержит векторную реализацию одновременного вычисления нескольких сумм кратных точек        */
+/*    эллиптической кривой.                                                                        */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <ak_tools.h>
+ #include <ak_curves.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+#ifdef LIBAKRYPT_HAVE_STRING_H
+ #include <string.h>
+#else
+ #error Library cannot be compiled without string.h header
+#endif
+#ifdef LIBAKRYPT_HAVE_STDLIB_H
+ #include <stdlib.h>
+#else
+ #error Library cannot be compiled without stdlib.h header
+#endif
+#ifdef LIBAKRYPT_HAVE_BUILTIN_MADD52
+ #include <immintrin.h>
+#endif
+
+#ifdef LIBAKRYPT_HAVE_BUILTIN_MADD52
+/* ----------------------------------------------------------------------------------------------- */
+/*                  арифметика в конечном поле с основанием 2^52 (AVX-512 IFMA)                    */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Атрибут функций, использующих инструкции AVX-512 IFMA.
+    \details Функции с данным атрибутом вызываются только после проверки того, что процессор
+    поддерживает необходимые инструкции.                                                           */
+ #define ak_lanes_target __attribute__(( target( "avx512f,avx512ifma" )))
+/*! \brief Атрибут функций, встраиваемых в вызывающую функцию; это позволяет компилятору
+    развернуть циклы по частям вычетов для каждой длины модуля отдельно.                           */
+ #define ak_lanes_inline ak_lanes_target static inline __attribute__(( always_inline ))
+
+/*! \brief Максимальное количество 52-х битных частей вычета (для модулей длины 512 бит). */
+ #define ak_lanes_max_limbs           (10)
+/*! \brief Ширина окна, используемая при одновременном вычислении кратных точек. */
+ #define ak_lanes_window_width         (4)
+/*! \brief Количество точек в таблице кратных, используемой одновременным вычислением. */
+ #define ak_lanes_table_size          (16)
+/*! \brief Маска, выделяющая младшие 52 бита 64-х битного слова. */
+ #define ak_lanes_limb_mask           (0xfffffffffffffLL)
+
+/*! \brief Вычеты, обрабатываемые одновременно: i-я часть всех вычетов хранится в одном регистре. */
+ typedef __m512i ak_lanes_element[ ak_lanes_max_limbs ];
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Точки эллиптической кривой, обрабатываемые одновременно (в проективных координатах). */
+ struct wpoint_lanes {
+  /*! \brief x-координаты точек. */
+   ak_lanes_element x;
+  /*! \brief y-координаты точек. */
+   ak_lanes_element y;
+  /*! \brief z-координаты точек. */
+   ak_lanes_element z;
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Параметры эллиптической кривой, используемые векторной реализацией.
+
+    Вычеты представляются в виде \f$ l \f$ частей по 52 бита, где \f$ l = 5 \f$ для модулей
+    длины 256 бит и \f$ l = 10 \f$ для модулей длины 512 бит, и хранятся в представлении
+    Монтгомери с константой \f$ R = 2^{52l} \f$. Поскольку \f$ 4p < R \f$, результат умножения
+    вычетов, меньших \f$ 2p \f$, также меньше \f$ 2p \f$; поэтому все промежуточные значения
+    хранятся в интервале \f$ [0, 2p) \f$ и полностью приводятся только перед выводом.            */
+/* ----------------------------------------------------------------------------------------------- */
+ struct wcurve_lanes {
+  /*! \brief Модуль \f$ p \f$. */
+   ak_lanes_element p;
+  /*! \brief Удвоенный модуль \f$ 2p \f$. */
+   ak_lanes_element p2;
+  /*! \brief Коэффициент \f$ a \f$ кривой. */
+   ak_lanes_element a;
+  /*! \brief Утроенный коэффициент \f$ b \f$ кривой. */
+   ak_lanes_element b3;
+  /*! \brief Константа \f$ -p^{-1} \pmod{2^{52}} \f$. */
+   __m512i n0;
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция разбивает вычет, заданный 64-х битными словами, на 52-х битные части. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_lanes_set_limbs( ak_uint64 *out, const ak_uint64 *in,
+                                                          const size_t size, const size_t limbs )
+{
+  size_t j, bit, w, sh;
+
+  for( j = 0; j < limbs; j++ ) {
+     bit = 52*j; w = bit >> 6; sh = bit&0x3f;
+     if( w >= size ) { out[j] = 0; continue; }
+     out[j] = in[w] >> sh;
+     if(( sh > 12 ) && ( w+1 < size )) out[j] |= in[w+1] << ( 64 - sh );
+     out[j] &= ak_lanes_limb_mask;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция собирает вычет, заданный 52-х битными частями, в 64-х битные слова. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_lanes_get_limbs( ak_uint64 *out, const ak_uint64 *in,
+                                                          const size_t size, const size_t limbs )
+{
+  size_t j, bit, w, sh;
+
+  memset( out, 0, size*sizeof( ak_uint64 ));
+  for( j = 0; j < limbs; j++ ) {
+     bit = 52*j; w = bit >> 6; sh = bit&0x3f;
+     if( w >= size ) break;
+     out[w] |= in[j] << sh;
+     if(( sh > 12 ) && ( w+1 < size )) out[w+1] |= in[j] >> ( 64 - sh );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет вычет \f$ 2^e \pmod{p} \f$ для \f$ e \geq 64n \f$. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_lanes_set_power_of_two( ak_uint64 *z, const size_t e, ak_wcurve ec )
+{
+  size_t i;
+  ak_mpzn512 one;
+
+ /* r^2 \cdot 1 \cdot r^{-1} = r = 2^{64n} */
+  ak_mpzn_set_ui( one, ec->size, 1 );
+  ak_mpzn_mul_montgomery( z, ec->r2, one, ec->p, ec->n, ec->size );
+  for( i = 64*ec->size; i < e; i++ ) ak_mpzn_add_montgomery( z, z, z, ec->p, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение вычетов в представлении Монтгомери (метод CIOS, основание \f$ 2^{52} \f$).
+    \details Аргументы должны быть меньше \f$ 2p \f$, результат также меньше \f$ 2p \f$.
+    Результат может совпадать с одним из аргументов.                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ ak_lanes_inline void ak_lanes_mul_limbs(
+                        __m512i *r, const __m512i *a, const __m512i *b, const __m512i *p,
+                                                          const __m512i n0, const size_t limbs )
+{
+  size_t i, j;
+  __m512i t[ ak_lanes_max_limbs+1 ], m, zero = _mm512_setzero_si512(),
+                                               mask = _mm512_set1_epi64( ak_lanes_limb_mask );
+
+  for( j = 0; j <= limbs; j++ ) t[j] = zero;
+  for( i = 0; i < limbs; i++ ) {
+    /* t = t + a*b_i */
+     for( j = 0; j < limbs; j++ ) {
+        t[j] = _mm512_madd52lo_epu64( t[j], a[j], b[i] );
+        t[j+1] = _mm512_madd52hi_epu64( t[j+1], a[j], b[i] );
+     }
+    /* t = ( t + m*p )/2^{52} */
+     m = _mm512_and_si512( _mm512_madd52lo_epu64( zero, t[0], n0 ), mask );
+     for( j = 0; j < limbs; j++ ) {
+        t[j] = _mm512_madd52lo_epu64( t[j], p[j], m );
+        t[j+1] = _mm512_madd52hi_epu64( t[j+1], p[j], m );
+     }
+     t[1] = _mm512_add_epi64( t[1], _mm512_srli_epi64( t[0], 52 ));
+     for( j = 0; j < limbs; j++ ) t[j] = t[j+1];
+     t[limbs] = zero;
+  }
+ /* нормализуем части результата */
+  for( j = 0; j < limbs-1; j++ ) {
+     t[j+1] = _mm512_add_epi64( t[j+1], _mm512_srli_epi64( t[j], 52 ));
+     r[j] = _mm512_and_si512( t[j], mask );
+  }
+  r[limbs-1] = t[limbs-1];
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Развернутое умножение вычетов для модулей длины 256 бит. */
+ ak_lanes_target static void ak_lanes_mul5( __m512i *r, const __m512i *a, const __m512i *b,
+                                                                            struct wcurve_lanes *lc )
+{
+  ak_lanes_mul_limbs( r, a, b, lc->p, lc->n0, 5 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Развернутое умножение вычетов для модулей длины 512 бит. */
+ ak_lanes_target static void ak_lanes_mul10( __m512i *r, const __m512i *a, const __m512i *b,
+                                                                            struct wcurve_lanes *lc )
+{
+  ak_lanes_mul_limbs( r, a, b, lc->p, lc->n0, 10 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение вычетов в представлении Монтгомери. */
+ ak_lanes_inline void ak_lanes_mul( __m512i *r, const __m512i *a, const __m512i *b,
+                                                        struct wcurve_lanes *lc, const size_t limbs )
+{
+  if( limbs == 5 ) ak_lanes_mul5( r, a, b, lc );
+   else ak_lanes_mul10( r, a, b, lc );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция нормализует части значения \f$ s \in [0, 2m) \f$ (части могут быть
+    отрицательными) и вычитает \f$ m \f$, если значение не меньше \f$ m \f$.                       */
+/* ----------------------------------------------------------------------------------------------- */
+ ak_lanes_inline void ak_lanes_reduce( __m512i *r, __m512i *s, const __m512i *m,
+                                                                              const size_t limbs )
+{
+  size_t j;
+  __mmask8 less;
+  __m512i d[ ak_lanes_max_limbs ], c = _mm512_setzero_si512(),
+                                               mask = _mm512_set1_epi64( ak_lanes_limb_mask );
+
+  for( j = 0; j < limbs-1; j++ ) {
+     s[j] = _mm512_add_epi64( s[j], c );
+     c = _mm512_srai_epi64( s[j], 52 );
+     s[j] = _mm512_and_si512( s[j], mask );
+  }
+  s[limbs-1] = _mm512_add_epi64( s[limbs-1], c );
+
+  c = _mm512_setzero_si512();
+  for( j = 0; j < limbs-1; j++ ) {
+     d[j] = _mm512_add_epi64( _mm512_sub_epi64( s[j], m[j] ), c );
+     c = _mm512_srai_epi64( d[j], 52 );
+     d[j] = _mm512_and_si512( d[j], mask );
+  }
+  d[limbs-1] = _mm512_add_epi64( _mm512_sub_epi64( s[limbs-1], m[limbs-1] ), c );
+
+ /* если разность отрицательна, то оставляем исходное значение */
+  less = _mm512_cmplt_epi64_mask( d[limbs-1], _mm512_setzero_si512( ));
+  for( j = 0; j < limbs; j++ ) r[j] = _mm512_mask_blend_epi64( less, d[j], s[j] );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Сложение вычетов, меньших \f$ 2p \f$. */
+ ak_lanes_inline void ak_lanes_add( __m512i *r, const __m512i *a, const __m512i *b,
+                                                        struct wcurve_lanes *lc, const size_t limbs )
+{
+  size_t j;
+  __m512i s[ ak_lanes_max_limbs ];
+
+  for( j = 0; j < limbs; j++ ) s[j] = _mm512_add_epi64( a[j], b[j] );
+  ak_lanes_reduce( r, s, lc->p2, limbs );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычитание вычетов, меньших \f$ 2p \f$. */
+ ak_lanes_inline void ak_lanes_sub( __m512i *r, const __m512i *a, const __m512i *b,
+                                                        struct wcurve_lanes *lc, const size_t limbs )
+{
+  size_t j;
+  __m512i s[ ak_lanes_max_limbs ];
+
+  for( j = 0; j < limbs; j++ )
+     s[j] = _mm512_sub_epi64( _mm512_add_epi64( a[j], lc->p2[j] ), b[j] );
+  ak_lanes_reduce( r, s, lc->p2, limbs );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                    точки эллиптической кривой, обрабатываемые одновременно                      */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Полная формула сложения точек в проективных координатах (Renes, Costello, Batina,
+    2016, алгоритм 1) для произвольного коэффициента \f$ a \f$.
+    \details Формула не имеет исключительных случаев для точек, разность которых не является
+    точкой второго порядка, в частности, для любых точек подгруппы нечетного порядка \f$ q \f$,
+    включая бесконечно удаленную точку и равные точки. Поэтому все точки обрабатываются
+    одинаково, без ветвлений. Результат может совпадать с одним из слагаемых.                     */
+/* ----------------------------------------------------------------------------------------------- */
+ ak_lanes_inline void ak_wpoint_lanes_add( struct wpoint_lanes *wr, struct wpoint_lanes *wp,
+                          struct wpoint_lanes *wq, struct wcurve_lanes *lc, const size_t limbs )
+{
+  ak_lanes_element t0, t1, t2, t3, t4, t5, x3, y3, z3;
+
+  ak_lanes_mul( t0, wp->x, wq->x, lc, limbs );
+  ak_lanes_mul( t1, wp->y, wq->y, lc, limbs );
+  ak_lanes_mul( t2, wp->z, wq->z, lc, limbs );
+  ak_lanes_add( t3, wp->x, wp->y, lc, limbs );
+  ak_lanes_add( t4, wq->x, wq->y, lc, limbs );
+  ak_lanes_mul( t3, t3, t4, lc, limbs );
+  ak_lanes_add( t4, t0, t1, lc, limbs );
+  ak_lanes_sub( t3, t3, t4, lc, limbs );
+  ak_lanes_add( t4, wp->x, wp->z, lc, limbs );
+  ak_lanes_add( t5, wq->x, wq->z, lc, limbs );
+  ak_lanes_mul( t4, t4, t5, lc, limbs );
+  ak_lanes_add( t5, t0, t2, lc, limbs );
+  ak_lanes_sub( t4, t4, t5, lc, limbs );
+  ak_lanes_add( t5, wp->y, wp->z, lc, limbs );
+  ak_lanes_add( x3, wq->y, wq->z, lc, limbs );
+  ak_lanes_mul( t5, t5, x3, lc, limbs );
+  ak_lanes_add( x3, t1, t2, lc, limbs );
+  ak_lanes_sub( t5, t5, x3, lc, limbs );
+  ak_lanes_mul( z3, lc->a, t4, lc, limbs );
+  ak_lanes_mul( x3, lc->b3, t2, lc, limbs );
+  ak_lanes_add( z3, x3, z3, lc, limbs );
+  ak_lanes_sub( x3, t1, z3, lc, limbs );
+  ak_lanes_add( z3, t1, z3, lc, limbs );
+  ak_lanes_mul( y3, x3, z3, lc, limbs );
+  ak_lanes_add( t1, t0, t0, lc, limbs );
+  ak_lanes_add( t1, t1, t0, lc, limbs );
+  ak_lanes_mul( t2, lc->a, t2, lc, limbs );
+  ak_lanes_mul( t4, lc->b3, t4, lc, limbs );
+  ak_lanes_add( t1, t1, t2, lc, limbs );
+  ak_lanes_sub( t2, t0, t2, lc, limbs );
+  ak_lanes_mul( t2, lc->a, t2, lc, limbs );
+  ak_lanes_add( t4, t4, t2, lc, limbs );
+  ak_lanes_mul( t0, t1, t4, lc, limbs );
+  ak_lanes_add( y3, y3, t0, lc, limbs );
+  ak_lanes_mul( t0, t5, t4, lc, limbs );
+  ak_lanes_mul( x3, t3, x3, lc, limbs );
+  ak_lanes_sub( x3, x3, t0, lc, limbs );
+  ak_lanes_mul( t0, t3, t1, lc, limbs );
+  ak_lanes_mul( z3, t5, z3, lc, limbs );
+  ak_lanes_add( z3, z3, t0, lc, limbs );
+
+  memcpy( wr->x, x3, limbs*sizeof( __m512i ));
+  memcpy( wr->y, y3, limbs*sizeof( __m512i ));
+  memcpy( wr->z, z3, limbs*sizeof( __m512i ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Полная формула удвоения точки в проективных координатах (Renes, Costello, Batina,
+    2016, алгоритм 3) для произвольного коэффициента \f$ a \f$.                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ ak_lanes_inline void ak_wpoint_lanes_double( struct wpoint_lanes *wp,
+                                                      struct wcurve_lanes *lc, const size_t limbs )
+{
+  ak_lanes_element t0, t1, t2, t3, x3, y3, z3;
+
+  ak_lanes_mul( t0, wp->x, wp->x, lc, limbs );
+  ak_lanes_mul( t1, wp->y, wp->y, lc, limbs );
+  ak_lanes_mul( t2, wp->z, wp->z, lc, limbs );
+  ak_lanes_mul( t3, wp->x, wp->y, lc, limbs );
+  ak_lanes_add( t3, t3, t3, lc, limbs );
+  ak_lanes_mul( z3, wp->x, wp->z, lc, limbs );
+  ak_lanes_add( z3, z3, z3, lc, limbs );
+  ak_lanes_mul( x3, lc->a, z3, lc, limbs );
+  ak_lanes_mul( y3, lc->b3, t2, lc, limbs );
+  ak_lanes_add( y3, x3, y3, lc, limbs );
+  ak_lanes_sub( x3, t1, y3, lc, limbs );
+  ak_lanes_add( y3, t1, y3, lc, limbs );
+  ak_lanes_mul( y3, x3, y3, lc, limbs );
+  ak_lanes_mul( x3, t3, x3, lc, limbs );
+  ak_lanes_mul( z3, lc->b3, z3, lc, limbs );
+  ak_lanes_mul( t2, lc->a, t2, lc, limbs );
+  ak_lanes_sub( t3, t0, t2, lc, limbs );
+  ak_lanes_mul( t3, lc->a, t3, lc, limbs );
+  ak_lanes_add( t3, t3, z3, lc, limbs );
+  ak_lanes_add( z3, t0, t0, lc, limbs );
+  ak_lanes_add( t0, z3, t0, lc, limbs );
+  ak_lanes_add( t0, t0, t2, lc, limbs );
+  ak_lanes_mul( t0, t0, t3, lc, limbs );
+  ak_lanes_add( y3, y3, t0, lc, limbs );
+  ak_lanes_mul( t2, wp->y, wp->z, lc, limbs );
+  ak_lanes_add( t2, t2, t2, lc, limbs );
+  ak_lanes_mul( t0, t2, t3, lc, limbs );
+  ak_lanes_sub( x3, x3, t0, lc, limbs );
+  ak_lanes_mul( z3, t2, t1, lc, limbs );
+  ak_lanes_add( z3, z3, z3, lc, limbs );
+  ak_lanes_add( z3, z3, z3, lc, limbs );
+
+  memcpy( wp->x, x3, limbs*sizeof( __m512i ));
+  memcpy( wp->y, y3, limbs*sizeof( __m512i ));
+  memcpy( wp->z, z3, limbs*sizeof( __m512i ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет таблицу кратных \f$ [j]R_i \f$, \f$ 0 \leq j < 16 \f$, для точек
+    \f$ R_i \f$ всех полос и сохраняет ее в массиве так, что значения одной части координаты
+    точки \f$ [j]R_i \f$ для всех полос располагаются последовательно.                            */
+/* ----------------------------------------------------------------------------------------------- */
+ ak_lanes_inline void ak_wpoint_lanes_set_table( ak_uint64 *table,
+                          struct wpoint_lanes *wp, struct wcurve_lanes *lc, const size_t limbs )
+{
+  size_t j, l;
+  struct wpoint_lanes wr;
+
+  for( j = 0; j < ak_lanes_table_size; j++ ) {
+     ak_uint64 *tx = table + 3*j*limbs*8, *ty = tx + limbs*8, *tz = ty + limbs*8;
+     if( j == 0 ) { /* бесконечно удаленная точка (0:1:0) */
+       memset( tx, 0, 3*limbs*8*sizeof( ak_uint64 ));
+       for( l = 0; l < 8; l++ ) ty[l] = 1;
+       continue;
+     }
+     if( j == 1 ) memcpy( &wr, wp, sizeof( struct wpoint_lanes ));
+     if( j == 2 ) ak_wpoint_lanes_double( &wr, lc, limbs );
+     if( j > 2 ) ak_wpoint_lanes_add( &wr, &wr, wp, lc, limbs );
+     for( l = 0; l < limbs; l++ ) {
+        _mm512_storeu_si512( tx + 8*l, wr.x[l] );
+        _mm512_storeu_si512( ty + 8*l, wr.y[l] );
+        _mm512_storeu_si512( tz + 8*l, wr.z[l] );
+     }
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция выбирает из таблицы для каждой полосы точку с заданным этой полосе индексом. */
+/* ----------------------------------------------------------------------------------------------- */
+ ak_lanes_inline void ak_wpoint_lanes_select( struct wpoint_lanes *wr,
+                                    const ak_uint64 *table, const ak_uint64 *digits, size_t limbs )
+{
+  size_t l;
+  ak_uint64 index[8];
+  __m512i idx;
+
+ /* смещение точки [d]R_i в таблице равно 24ld + i словам */
+  for( l = 0; l < 8; l++ ) index[l] = 24*limbs*digits[l] + l;
+  idx = _mm512_loadu_si512( index );
+  for( l = 0; l < limbs; l++ ) {
+     wr->x[l] = _mm512_i64gather_epi64( idx, table + 8*l, 8 );
+     wr->y[l] = _mm512_i64gather_epi64( idx, table + 8*( limbs + l ), 8 );
+     wr->z[l] = _mm512_i64gather_epi64( idx, table + 8*( 2*limbs + l ), 8 );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция загружает вычеты восьми полос, заданные 64-х битными словами, и переводит их
+    в представление Монтгомери с константой \f$ 2^{52l} \f$ умножением на заданную константу.      */
+/* ----------------------------------------------------------------------------------------------- */
+ ak_lanes_inline void ak_lanes_load( __m512i *r, ak_uint64 **values, ak_uint64 *c,
+                                     struct wcurve_lanes *lc, ak_wcurve ec, const size_t limbs )
+{
+  size_t i, l;
+  ak_lanes_element cl;
+  ak_uint64 parts[ ak_lanes_max_limbs ], buffer[ ak_lanes_max_limbs ][8];
+
+  for( i = 0; i < 8; i++ ) {
+     ak_lanes_set_limbs( parts, values[i], ec->size, limbs );
+     for( l = 0; l < limbs; l++ ) buffer[l][i] = parts[l];
+  }
+  for( l = 0; l < limbs; l++ ) r[l] = _mm512_loadu_si512( buffer[l] );
+  ak_lanes_set_limbs( parts, c, ec->size, limbs );
+  for( l = 0; l < limbs; l++ ) cl[l] = _mm512_set1_epi64(( ak_int64 ) parts[l] );
+  ak_lanes_mul( r, r, cl, lc, limbs );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция переводит вычеты восьми полос в представление Монтгомери библиотеки,
+    полностью приводит их по модулю \f$ p \f$ и сохраняет в 64-х битных словах.                    */
+/* ----------------------------------------------------------------------------------------------- */
+ ak_lanes_inline void ak_lanes_store( ak_uint64 **values, const __m512i *a, ak_uint64 *c,
+                                     struct wcurve_lanes *lc, ak_wcurve ec, const size_t limbs )
+{
+  size_t i, l;
+  ak_lanes_element r, cl;
+  ak_uint64 parts[ ak_lanes_max_limbs ], buffer[ ak_lanes_max_limbs ][8];
+
+  ak_lanes_set_limbs( parts, c, ec->size, limbs );
+  for( l = 0; l < limbs; l++ ) cl[l] = _mm512_set1_epi64(( ak_int64 ) parts[l] );
+  ak_lanes_mul( r, a, cl, lc, limbs );
+  ak_lanes_reduce( r, r, lc->p, limbs );
+
+  for( l = 0; l < limbs; l++ ) _mm512_storeu_si512( buffer[l], r[l] );
+  for( i = 0; i < 8; i++ ) {
+     for( l = 0; l < limbs; l++ ) parts[l] = buffer[l][i];
+     ak_lanes_get_limbs( values[i], parts, ec->size, limbs );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет точки \f$ Q_i = [k_{1,i}]P + [k_{2,i}]R_i \f$ для восьми полос.
+    \details Используется метод Штрауса с фиксированным окном ширины 4: после каждых четырех
+    удвоений к сумме прибавляются точки обеих таблиц, выбранные по цифрам степеней каждой полосы.
+    Поскольку формулы сложения полные, все полосы выполняют одинаковую последовательность
+    операций.                                                                                      */
+/* ----------------------------------------------------------------------------------------------- */
+ ak_lanes_inline int ak_wpoint_pow_joint_lanes_run( ak_wpoint *wq, ak_uint64 **k1,
+                                   ak_wpoint *wp, ak_uint64 **k2, ak_wcurve ec, const size_t limbs )
+{
+  size_t i, l, w, windows;
+  struct wcurve_lanes lc;
+  struct wpoint_lanes wr, wt;
+  ak_uint64 *table = NULL, *values[8], digits[8];
+  ak_mpzn512 cin, cout;
+  ak_uint64 parts[ ak_lanes_max_limbs ], p2[ ak_mpzn512_size+1 ];
+  size_t tsize = ak_lanes_table_size*3*ak_lanes_max_limbs*8;
+
+ /* формируем параметры кривой */
+  memset( &lc, 0, sizeof( struct wcurve_lanes ));
+  lc.n0 = _mm512_set1_epi64(( ak_int64 )( ec->n & ak_lanes_limb_mask ));
+  ak_lanes_set_limbs( parts, ec->p, ec->size, limbs );
+  for( l = 0; l < limbs; l++ ) lc.p[l] = _mm512_set1_epi64(( ak_int64 ) parts[l] );
+  p2[ec->size] = ak_mpzn_add( p2, ec->p, ec->p, ec->size );
+  ak_lanes_set_limbs( parts, p2, ec->size+1, limbs );
+  for( l = 0; l < limbs; l++ ) lc.p2[l] = _mm512_set1_epi64(( ak_int64 ) parts[l] );
+
+ /* константы перевода: 2^{104l - 64n} для входных и 2^{64n} для выходных значений */
+  ak_lanes_set_power_of_two( cin, 104*limbs - 64*ec->size, ec );
+  ak_lanes_set_power_of_two( cout, 64*ec->size, ec );
+
+  for( i = 0; i < 8; i++ ) values[i] = ec->a;
+  ak_lanes_load( lc.a, values, cin, &lc, ec, limbs );
+  for( i = 0; i < 8; i++ ) values[i] = ec->b;
+  ak_lanes_load( lc.b3, values, cin, &lc, ec, limbs );
+  ak_lanes_add( wt.x, lc.b3, lc.b3, &lc, limbs );
+  ak_lanes_add( lc.b3, wt.x, lc.b3, &lc, limbs );
+
+  if(( table = malloc( 2*tsize*sizeof( ak_uint64 ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+
+ /* таблицы кратных образующей точки и точек R_i */
+  for( i = 0; i < 8; i++ ) values[i] = ec->point.x;
+  ak_lanes_load( wt.x, values, cin, &lc, ec, limbs );
+  for( i = 0; i < 8; i++ ) values[i] = ec->point.y;
+  ak_lanes_load( wt.y, values, cin, &lc, ec, limbs );
+  for( i = 0; i < 8; i++ ) values[i] = ec->point.z;
+  ak_lanes_load( wt.z, values, cin, &lc, ec, limbs );
+  ak_wpoint_lanes_set_table( table, &wt, &lc, limbs );
+
+  for( i = 0; i < 8; i++ ) values[i] = wp[i]->x;
+  ak_lanes_load( wt.x, values, cin, &lc, ec, limbs );
+  for( i = 0; i < 8; i++ ) values[i] = wp[i]->y;
+  ak_lanes_load( wt.y, values, cin, &lc, ec, limbs );
+  for( i = 0; i < 8; i++ ) values[i] = wp[i]->z;
+  ak_lanes_load( wt.z, values, cin, &lc, ec, limbs );
+  ak_wpoint_lanes_set_table( table + tsize, &wt, &lc, limbs );
+
+ /* основной цикл: окна степеней от старших к младшим */
+  windows = 64*ec->size/ak_lanes_window_width;
+  for( w = windows; w > 0; w-- ) {
+     size_t bit = ( w-1 )*ak_lanes_window_width;
+     if( w < windows )
+       for( l = 0; l < ak_lanes_window_width; l++ ) ak_wpoint_lanes_double( &wr, &lc, limbs );
+
+     for( i = 0; i < 8; i++ )
+        digits[i] = ( k1[i][bit >> 6] >> ( bit&0x3f )) & ( ak_lanes_table_size-1 );
+     if( w == windows ) ak_wpoint_lanes_select( &wr, table, digits, limbs );
+      else {
+        ak_wpoint_lanes_select( &wt, table, digits, limbs );
+        ak_wpoint_lanes_add( &wr, &wr, &wt, &lc, limbs );
+      }
+     for( i = 0; i < 8; i++ )
+        digits[i] = ( k2[i][bit >> 6] >> ( bit&0x3f )) & ( ak_lanes_table_size-1 );
+     ak_wpoint_lanes_select( &wt, table + tsize, digits, limbs );
+     ak_wpoint_lanes_add( &wr, &wr, &wt, &lc, limbs );
+  }
+  free( table );
+
+ /* возвращаем результат в представлении Монтгомери библиотеки */
+  for( i = 0; i < 8; i++ ) values[i] = wq[i]->x;
+  ak_lanes_store( values, wr.x, cout, &lc, ec, limbs );
+  for( i = 0; i < 8; i++ ) values[i] = wq[i]->y;
+  ak_lanes_store( values, wr.y, cout, &lc, ec, limbs );
+  for( i = 0; i < 8; i++ ) values[i] = wq[i]->z;
+  ak_lanes_store( values, wr.z, cout, &lc, ec, limbs );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление сумм кратных точек для кривых с параметрами длины 256 бит. */
+ ak_lanes_target static int ak_wpoint_pow_joint_lanes5( ak_wpoint *wq, ak_uint64 **k1,
+                                                   ak_wpoint *wp, ak_uint64 **k2, ak_wcurve ec )
+{
+ return ak_wpoint_pow_joint_lanes_run( wq, k1, wp, k2, ec, 5 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление сумм кратных точек для кривых с параметрами длины 512 бит. */
+ ak_lanes_target static int ak_wpoint_pow_joint_lanes10( ak_wpoint *wq, ak_uint64 **k1,
+                                                   ak_wpoint *wp, ak_uint64 **k2, ak_wcurve ec )
+{
+ return ak_wpoint_pow_joint_lanes_run( wq, k1, wp, k2, ec, 10 );
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Векторная реализация использует инструкции AVX-512 IFMA и доступна, если библиотека
+    собрана компилятором, поддерживающим эти инструкции, процессор их поддерживает, а параметры
+    кривой имеют длину 256 или 512 бит. Реализация для процессоров, поддерживающих только
+    инструкции AVX2, не предусмотрена: в этом случае используется последовательное вычисление
+    точек с вычетами по основанию \f$ 2^{64} \f$.
+
+    @param ec Эллиптическая кривая.
+    @return Функция возвращает истину, если векторная реализация может быть использована.         */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_wcurve_lanes_is_available( ak_wcurve ec )
+{
+#ifdef LIBAKRYPT_HAVE_BUILTIN_MADD52
+  static int supported = -1;
+
+  if( ec == NULL ) return ak_false;
+  if(( ec->size != ak_mpzn256_size ) && ( ec->size != ak_mpzn512_size )) return ak_false;
+  if( supported < 0 ) {
+    __builtin_cpu_init();
+    supported = __builtin_cpu_supports( "avx512ifma" ) ? 1 : 0;
+  }
+ return supported ? ak_true : ak_false;
+#else
+  ( void )ec;
+ return ak_false;
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для образующей точки \f$ P \f$ эллиптической кривой, заданных точек \f$ R_i \f$ и пар
+    целых чисел \f$ k_{1,i}, k_{2,i} \f$ функция вычисляет точки
+    \f$ Q_i = [k_{1,i}]P + [k_{2,i}]R_i \f$, \f$ 0 \leq i < count \f$.
+    Вычисления для всех точек выполняются одновременно: каждая сумма обрабатывается в отдельной
+    полосе 512-ти битных векторных регистров, вычеты представляются частями по 52 бита,
+    а умножение выполняется инструкциями AVX-512 IFMA.
+
+    Точки \f$ R_i \f$ должны принадлежать подгруппе порядка \f$ q \f$, порожденной точкой
+    \f$ P \f$. Если это не так, то результат может оказаться бесконечно удаленной точкой.
+
+    \warning Время работы функции не зависит от значений \f$ k_{1,i}, k_{2,i} \f$, однако
+    выбор точек из таблиц выполняется по индексам, поэтому функция должна использоваться
+    только для открытых данных.
+
+    @param wq Массив точек \f$ Q_i \f$, в которые помещается результат (в проективной форме).
+    @param k1 Массив степеней кратности образующей точки; степени располагаются с шагом
+    \ref ak_mpzn512_size машинных слов.
+    @param wp Массив указателей на точки \f$ R_i \f$.
+    @param k2 Массив степеней кратности точек \f$ R_i \f$, располагаемых так же, как и `k1`.
+    @param count Количество вычисляемых точек, не более \ref ak_wpoint_lanes_count.
+    @param ec Эллиптическая кривая, на которой происходят вычисления.
+    @return В случае успеха функция возвращает \ref ak_error_ok. Если векторная реализация
+    недоступна, то возвращается \ref ak_error_undefined_function, в этом случае
+    вычисления должны быть выполнены функцией ak_wpoint_pow_joint().                              */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_wpoint_pow_joint_lanes( ak_wpoint wq, ak_uint64 *k1, ak_wpoint *wp, ak_uint64 *k2,
+                                                             const size_t count, ak_wcurve ec )
+{
+#ifdef LIBAKRYPT_HAVE_BUILTIN_MADD52
+  size_t i;
+  struct wpoint dummy;
+  ak_mpzn512 zero;
+  ak_wpoint points[ ak_wpoint_lanes_count ], results[ ak_wpoint_lanes_count ];
+  ak_uint64 *s1[ ak_wpoint_lanes_count ], *s2[ ak_wpoint_lanes_count ];
+#endif
+
+  if(( wq == NULL ) || ( k1 == NULL ) || ( wp == NULL ) || ( k2 == NULL ) || ( ec == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__, "using a null pointer to argument" );
+  if(( count == 0 ) || ( count > ak_wpoint_lanes_count ))
+    return ak_error_message( ak_error_wrong_length, __func__, "using wrong number of points" );
+  if( !ak_wcurve_lanes_is_available( ec )) return ak_error_undefined_function;
+
+#ifdef LIBAKRYPT_HAVE_BUILTIN_MADD52
+ /* незанятые полосы вычисляют бесконечно удаленную точку */
+  memset( zero, 0, sizeof( zero ));
+  for( i = 0; i < ak_wpoint_lanes_count; i++ ) {
+     if( i < count ) {
+       points[i] = wp[i]; results[i] = wq+i;
+       s1[i] = k1 + i*ak_mpzn512_size; s2[i] = k2 + i*ak_mpzn512_size;
+     } else {
+         points[i] = &ec->point; results[i] = &dummy;
+         s1[i] = s2[i] = zero;
+       }
+  }
+ if( ec->size == ak_mpzn256_size )
+   return ak_wpoint_pow_joint_lanes5( results, s1, points, s2, ec );
+ return ak_wpoint_pow_joint_lanes10( results, s1, points, s2, ec );
+#else
+ return ak_error_undefined_function;
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                                                                             ak_curves_lanes.c  */
+/* ----------------------------------------------------------------------------------------------- */
@@ -0,0 +1,152 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Copyright (c) 2019 by Axel Kenzo, axelkenzo@mail.ru                                            */
+/*                                                                                                 */
+/*  Файл ak_gentables.c                                                                            */
+/*  - содержит программу, вырабатывающую на этапе сборки библиотеки константные таблицы            */
+/*    алгоритма блочного шифрования Кузнечик (ГОСТ Р 34.12-2015).                                  */
+/*    Программа не входит в состав библиотеки и вызывается системой сборки.                        */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_parameters.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция умножает два элемента конечного поля \f$\mathbb F_{2^8}\f$, определенного
+     согласно ГОСТ Р 34.12-2015 (копия функции из файла ak_kuznechik.c).                          */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_uint8 ak_gentables_mul_gf256( ak_uint8 x, ak_uint8 y )
+{
+  ak_uint8 z = 0;
+  while( y ) {
+    if( y&0x1 ) z ^= x;
+    x = ((ak_uint8)(x << 1)) ^ ( x & 0x80 ? 0xC3 : 0x00 );
+    y >>= 1;
+  }
+ return z;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция выводит в файл массив байт в виде инициализатора языка Си.                      */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_gentables_print_bytes( FILE *fp, const ak_uint8 *ptr, const size_t size )
+{
+  size_t i = 0;
+
+  fprintf( fp, "{" );
+  for( i = 0; i < size; i++ ) {
+     if( i%16 == 0 ) fprintf( fp, "\n    " );
+     fprintf( fp, "0x%02X", ptr[i] );
+     if( i+1 < size ) fprintf( fp, ( i%16 == 15 ) ? "," : ", " );
+  }
+  fprintf( fp, " }" );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция выводит в файл развернутую таблицу в виде инициализатора языка Си.
+    \details Значения выводятся как 64-х битные целые числа, поэтому результат зависит
+    от порядка следования байт на платформе, на которой выполняется сборка.                        */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_gentables_print_table( FILE *fp, expanded_table tab )
+{
+  int i, j;
+
+  fprintf( fp, "{\n" );
+  for( i = 0; i < 16; i++ ) {
+     fprintf( fp, "   {" );
+     for( j = 0; j < 256; j++ ) {
+        if( j%2 == 0 ) fprintf( fp, "\n    " );
+        fprintf( fp, "{ 0x%016llxULL, 0x%016llxULL }", (unsigned long long) tab[i][j][0],
+                                                               (unsigned long long) tab[i][j][1] );
+        if( j < 255 ) fprintf( fp, ( j%2 == 1 ) ? "," : ", " );
+     }
+     fprintf( fp, " }%s\n", ( i < 15 ) ? "," : "" );
+  }
+  fprintf( fp, "  }" );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вырабатывает и выводит в файл параметры алгоритма Кузнечик для заданного
+    значения опции `openssl_compability`. Алгоритм выработки таблиц совпадает с алгоритмом,
+    реализуемым функцией ak_bckey_context_kuznechik_init_tables().                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_gentables_print_parameters( FILE *fp, const int oc )
+{
+  int i, j, l;
+  static expanded_table enc, dec;
+
+  for( i = 0; i < 16; i++ ) {
+     for( j = 0; j < 256; j++ ) {
+        ak_uint8 b[16], ib[16];
+        for( l = 0; l < 16; l++ ) {
+           b[15*oc + (1-2*oc)*l] = ak_gentables_mul_gf256( gost_L[l][i], gost_pi[j] );
+           ib[15*oc + (1-2*oc)*l] = ak_gentables_mul_gf256( gost_Linv[l][i], gost_pinv[j] );
+        }
+        memcpy( enc[i][j], b, 16 );
+        memcpy( dec[i][j], ib, 16 );
+     }
+  }
+
+  fprintf( fp, " { /* openssl_compability = %d */\n  /* reg */\n  ", oc );
+  ak_gentables_print_bytes( fp, gost_lvec, sizeof( linear_register ));
+  fprintf( fp, ",\n  /* L */\n  {" );
+  for( i = 0; i < 16; i++ ) {
+     fprintf( fp, "\n  " );
+     ak_gentables_print_bytes( fp, gost_L[i], 16 );
+     if( i < 15 ) fprintf( fp, "," );
+  }
+  fprintf( fp, " },\n  /* pi */\n  " );
+  ak_gentables_print_bytes( fp, gost_pi, sizeof( sbox ));
+  fprintf( fp, ",\n  /* enc */\n  " );
+  ak_gentables_print_table( fp, enc );
+  fprintf( fp, ",\n  /* Linv */\n  {" );
+  for( i = 0; i < 16; i++ ) {
+     fprintf( fp, "\n  " );
+     ak_gentables_print_bytes( fp, gost_Linv[i], 16 );
+     if( i < 15 ) fprintf( fp, "," );
+  }
+  fprintf( fp, " },\n  /* pinv */\n  " );
+  ak_gentables_print_bytes( fp, gost_pinv, sizeof( sbox ));
+  fprintf( fp, ",\n  /* dec */\n  " );
+  ak_gentables_print_table( fp, dec );
+  fprintf( fp, "\n }" );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( int argc, char *argv[] )
+{
+  FILE *fp = NULL;
+
+  if( argc != 2 ) {
+    fprintf( stderr, "usage: %s <output file>\n", argv[0] );
+    return EXIT_FAILURE;
+  }
+  if(( fp = fopen( argv[1], "w" )) == NULL ) {
+    fprintf( stderr, "%s: cannot create file %s\n", argv[0], argv[1] );
+    return EXIT_FAILURE;
+  }
+
+  fprintf( fp,
+   "/* ------------------------------------------------------------------------------------------- */\n"
+   "/*  Файл ak_kuznechik_tables.h сгенерирован автоматически программой ak_gentables.             */\n"
+   "/*  - содержит константные таблицы алгоритма блочного шифрования Кузнечик (ГОСТ Р 34.12-2015), */\n"
+   "/*    соответствующие значениям 0 и 1 опции openssl_compability. Не редактируйте этот файл.    */\n"
+   "/* ------------------------------------------------------------------------------------------- */\n"
+   "#ifndef __AK_KUZNECHIK_TABLES_H__\n"
+   "#define __AK_KUZNECHIK_TABLES_H__\n\n"
+   " static const struct kuznechik_params kuznechik_gost_parameters[2] = {\n" );
+  ak_gentables_print_parameters( fp, 0 );
+  fprintf( fp, ",\n" );
+  ak_gentables_print_parameters( fp, 1 );
+  fprintf( fp, "\n};\n\n#endif\n" );
+
+  if( fclose( fp ) != 0 ) {
+    fprintf( stderr, "%s: cannot write file %s\n", argv[0], argv[1] );
+    return EXIT_FAILURE;
+  }
+ return EXIT_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                                                                                 ak_gentables.c  */
+/* ----------------------------------------------------------------------------------------------- */
@@ -316,6 +316,33 @@
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция копирует в контекст `dst` текущее состояние контекста `src`, в том числе
+    промежуточное значение функции сжатия и необработанные данные. Это позволяет, например,
+    один раз обработать общий префикс сообщений, а затем продолжать вычисления с копиями.
+
+  @param dst Контекст функции хеширования, в который помещается копия.
+  @param src Копируемый контекст функции хеширования.
+  @return В случае успеха возвращается ak_error_ok (ноль). В случае возникновения ошибки
+  возвращается ее код.                                                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_context_clone( ak_hash dst, ak_hash src )
+{
+  int error = ak_error_ok;
+
+  if(( dst == NULL ) || ( src == NULL )) return ak_error_message( ak_error_null_pointer,
+                                                  __func__, "using null pointer to hash context" );
+  if( src->oid == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                 "using hash context with undefined algorithm" );
+  dst->oid = src->oid;
+  memcpy( &dst->data.sctx, &src->data.sctx, sizeof( struct streebog ));
+ /* функции сжатия копии должны работать с ее собственным состоянием */
+  if(( error = ak_mac_context_clone( &dst->mctx, &src->mctx, &dst->data.sctx )) != ak_error_ok )
+    ak_error_message( error, __func__, "incorrect cloning of internal mac context" );
+
+ return error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param hctx Контекст функции хеширования
     @return Функция возвращает NULL. В случае возникновения ошибки, ее код может быть получен с
@@ -64,6 +64,8 @@
  int ak_hash_context_create_oid( ak_hash, ak_oid );
 /*! \brief Уничтожение контекста функции хеширования. */
  int ak_hash_context_destroy( ak_hash );
+/*! \brief Создание копии контекста функции хеширования вместе с текущим состоянием. */
+ int ak_hash_context_clone( ak_hash , ak_hash );
 /*! \brief Освобождение памяти из под контекста функции хеширования. */
  ak_pointer ak_hash_context_delete( ak_pointer );
 
@@ -38,12 +38,15 @@
   if( !((hctx->key.flags)&ak_key_flag_set_key )) return ak_error_message( ak_error_key_value,
                                                __func__ , "using hmac key with unassigned value" );
 
-  if( hctx->key.resource.value.counter <= 1 ) return ak_error_message( ak_error_low_key_resource,
-                                            __func__, "using hmac key context with low resource" );
-                      /* нам надо два раза использовать ключ => ресурс должен быть не менее двух */
   if( hctx->mctx.bsize > sizeof( buffer )) return ak_error_message( ak_error_wrong_length,
                                             __func__, "using hash function with huge block size" );
 
+ /* ключ используется два раза (здесь и при завершении вычислений),
+    поэтому ресурс для обоих использований атомарно резервируется сразу */
+  if( ak_skey_context_use_resource( &hctx->key, 2 ) != ak_error_ok )
+    return ak_error_message( ak_error_low_key_resource,
+                                        __func__, "using hmac key context with low resource" );
+
  /* фомируем маскированное значение ключа */
   len = ak_min( hctx->mctx.bsize, jdx = hctx->key.key_size );
   for( idx = 0; idx < len; idx++, jdx++ ) {
@@ -63,9 +66,8 @@
  /* очищаем буффер */
   ak_ptr_context_wipe( buffer, sizeof( buffer ), &hctx->key.generator );
 
- /* перемаскируем ключ и меняем его ресурс */
+ /* перемаскируем ключ */
   hctx->key.set_mask( &hctx->key );
-  hctx->key.resource.value.counter--; /* мы использовали ключ один раз */
 
  return error;
 }
@@ -89,11 +91,9 @@
                                                       "using zero length for authenticated data" );
   if( size%hctx->mctx.bsize ) return ak_error_message( ak_error_wrong_length, __func__ ,
                                                                   "using data with wrong length" );
- /* проверяем наличие ключа и его ресурс */
+ /* проверяем наличие ключа (ресурс зарезервирован при вызове clean) */
   if( !((hctx->key.flags)&ak_key_flag_set_key )) return ak_error_message( ak_error_key_value,
                                                __func__ , "using hmac key with unassigned value" );
-  if( hctx->key.resource.value.counter <= 0 ) return ak_error_message( ak_error_low_key_resource,
-                                            __func__, "using hmac key context with low resource" );
 
   return ak_hash_context_update( &hctx->ctx, in, size );
 }
@@ -154,9 +154,8 @@
  /* очищаем буффер */
   ak_ptr_context_wipe( keybuffer, sizeof( keybuffer ), &hctx->key.generator );
 
- /* ресурс ключа */
+ /* перемаскируем ключ (ресурс был списан при вызове clean) */
   hctx->key.set_mask( &hctx->key );
-  hctx->key.resource.value.counter--; /* мы использовали ключ один раз */
 
  /* последний update/finalize и возврат результата */
   error = ak_hash_context_finalize( &hctx->ctx, temporary,
@@ -261,6 +260,40 @@
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция создает в контексте `dst` копию контекста `src`: копируются маскированное значение
+    ключа (с последующей сменой маски), его ресурс и текущее состояние внутренней функции
+    хеширования. Если копируемый контекст был подготовлен вызовом ak_hmac_context_clean(),
+    то копия содержит уже обработанный блок `ipad` и может сразу использоваться функциями
+    ak_hmac_context_update() и ak_hmac_context_finalize().
+
+    \param dst Контекст алгоритма HMAC, в который помещается копия. Контекст не должен быть
+    инициализирован ранее.
+    \param src Копируемый контекст алгоритма HMAC выработки имитовставки.
+    \return В случае успешного завершения функций возвращает \ref ak_error_ok. В случае
+    возникновения ошибки возвращеется ее код.                                                      */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hmac_context_clone( ak_hmac dst, ak_hmac src )
+{
+  int error = ak_error_ok;
+
+  if(( dst == NULL ) || ( src == NULL )) return ak_error_message( ak_error_null_pointer,
+                                                  __func__, "using null pointer to hmac context" );
+  if(( error = ak_hash_context_clone( &dst->ctx, &src->ctx )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect cloning of hash context" );
+  if(( error = ak_mac_context_clone( &dst->mctx, &src->mctx, dst )) != ak_error_ok ) {
+    ak_hash_context_destroy( &dst->ctx );
+    return ak_error_message( error, __func__, "incorrect cloning of mac context" );
+  }
+  if(( error = ak_skey_context_clone( &dst->key, &src->key )) != ak_error_ok ) {
+    ak_hash_context_destroy( &dst->ctx );
+    ak_mac_context_destroy( &dst->mctx );
+    return ak_error_message( error, __func__, "incorrect cloning of secret key context" );
+  }
+
+ return error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \param hctx Контекст алгоритма HMAC выработки имитовставки.
     \return Функция возвращает NULL. В случае возникновения ошибки, ее код может быть получен с
@@ -870,6 +903,7 @@
 /* ----------------------------------------------------------------------------------------------- */
 /*! \example test-hmac01.c                                                                         */
 /*! \example test-hmac02.c                                                                         */
+/*! \example test-hmac03.c                                                                         */
 /* ----------------------------------------------------------------------------------------------- */
 /*                                                                                      ak_hmac.c  */
 /* ----------------------------------------------------------------------------------------------- */
@@ -45,6 +45,8 @@
  int ak_hmac_context_create_oid( ak_hmac , ak_oid );
 /*! \brief Уничтожение контекста функции хеширования. */
  int ak_hmac_context_destroy( ak_hmac );
+/*! \brief Создание копии контекста ключевой функции хеширования HMAC. */
+ int ak_hmac_context_clone( ak_hmac , ak_hmac );
 /*! \brief Освобождение памяти из под контекста функции хеширования. */
  ak_pointer ak_hmac_context_delete( ak_pointer );
 
@@ -32,7 +32,16 @@
  typedef ak_uint64 ak_kuznechik_expanded_keys[80];
 
 /* ---------------------------------------------------------------------------------------------- */
- static struct kuznechik_params kuznechik_parameters;
+#ifdef LIBAKRYPT_CONST_KUZNECHIK_TABLES
+/* константные параметры и таблицы, выработанные на этапе сборки библиотеки
+   программой ak_gentables (для каждого из значений опции openssl_compability) */
+ #include <ak_kuznechik_tables.h>
+#else
+ static struct kuznechik_params kuznechik_gost_parameters;
+#endif
+
+/*! \brief Указатель на параметры и развернутые таблицы, используемые алгоритмом Кузнечик. */
+ static const struct kuznechik_params *kuznechik_parameters = NULL;
 
 /* ---------------------------------------------------------------------------------------------- */
 /*! \brief Функция умножает два элемента конечного поля \f$\mathbb F_{2^8}\f$, определенного
@@ -52,7 +61,7 @@
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Функция умножает вектор w на матрицу D, результат помещается в вектор x.                */
 /* ----------------------------------------------------------------------------------------------- */
- static void ak_kuznechik_matrix_mul_vector( linear_matrix D, ak_uint8 *w, ak_uint8* x )
+ static void ak_kuznechik_matrix_mul_vector( const linear_matrix D, ak_uint8 *w, ak_uint8* x )
 {
   int i = 0, j = 0;
   for( i = 0; i < 16; i++ ) {
@@ -93,7 +102,7 @@
      ak_uint8 z = w[0];
      for( i = 1; i < 16; i++ ) {
         w[i-1] = w[i];
-        z ^= ak_bckey_context_kuznechik_mul_gf256( w[i], kuznechik_parameters.reg[i] );
+        z ^= ak_bckey_context_kuznechik_mul_gf256( w[i], kuznechik_parameters->reg[i] );
      }
      w[15] = z;
   }
@@ -145,7 +154,7 @@
  int ak_bckey_context_kuznechik_init_tables( const linear_register reg,
                                                           const sbox pi, ak_kuznechik_params par )
 {
-  int i, j, l, oc = (int) ak_libakrypt_get_option( "openssl_compability" );
+  int i, j, l, oc = (int) ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
 
   if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
                                                 "wrong value for \"openssl_compability\" option" );
@@ -179,22 +188,18 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_bckey_context_kuznechik_init_gost_tables( void )
 {
-  int audit = ak_log_get_level(),
-      error = ak_bckey_context_kuznechik_init_tables( gost_lvec, gost_pi, &kuznechik_parameters );
-
- /* ---- удали меня скорее ----
-   FILE *fp = fopen("table.txt", "w" );
-
-    for( int i = 0; i < 16; i++ ) {
-      fprintf( fp, "\n  tab[%02d][j][1]    tab[%02d][j][0] (for j from 0 to 255)\n", i, i );
-      for( int j = 0; j < 256; j++ ) {
-         fprintf( fp, "%016llX:%016llX\n",
-           kuznechik_parameters.enc[i][j][1], kuznechik_parameters.enc[i][j][0] );
-      }
-      fprintf( fp, "\n");
-    }
-   fclose(fp);
-    ---- удали меня скорее ---- */
+  int audit = ak_log_get_level(), error = ak_error_ok;
+#ifdef LIBAKRYPT_CONST_KUZNECHIK_TABLES
+  int oc = (int) ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
+
+ /* таблицы уже выработаны, необходимо только выбрать их вариант */
+  if(( oc < 0 ) || ( oc > 1 )) error = ak_error_wrong_option;
+    else kuznechik_parameters = &kuznechik_gost_parameters[oc];
+#else
+  error = ak_bckey_context_kuznechik_init_tables( gost_lvec, gost_pi, &kuznechik_gost_parameters );
+  kuznechik_parameters = &kuznechik_gost_parameters;
+#endif
+
 
 
   if( error != ak_error_ok )
@@ -234,6 +239,59 @@
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция сменяет маски развернутых раундовых ключей алгоритма Кузнечик.
+    \details Используется после копирования развернутых ключей, например, из кэша.
+    \param skey Указатель на контекст секретного ключа, содержащего развернутые
+    раундовые ключи и маски.
+    \return Функция возвращает \ref ak_error_ok в случае успеха.
+    В противном случае возвращается код ошибки.                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_kuznechik_remask_keys( ak_skey skey )
+{
+  size_t idx = 0;
+  ak_uint64 newmask[40], *keys = ( ak_uint64 *)skey->data;
+  int error = ak_error_ok;
+
+ /* за один вызов вырабатываем новые маски для прямых и обратных ключей */
+  if(( error = ak_random_context_random( &skey->generator,
+                                                     newmask, sizeof( newmask ))) != ak_error_ok )
+    return ak_error_message( error, __func__, "wrong generation of random masks" );
+
+ /* ключи хранятся в первых 40 словах, маски - в последних 40 */
+  for( idx = 0; idx < 40; idx++ ) {
+     keys[idx] ^= keys[idx+40]^newmask[idx];
+     keys[idx+40] = newmask[idx];
+  }
+  ak_ptr_context_wipe( newmask, sizeof( newmask ), &skey->generator );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция копирует развернутые раундовые ключи алгоритма Кузнечик и сменяет их маски.
+    \param dst Указатель на контекст секретного ключа, в который помещаются копии
+    развернутых раундовых ключей.
+    \param src Указатель на контекст секретного ключа, содержащего развернутые
+    раундовые ключи и маски.
+    \return Функция возвращает \ref ak_error_ok в случае успеха.
+    В противном случае возвращается код ошибки.                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_kuznechik_clone_keys( ak_skey dst, ak_skey src )
+{
+  if(( dst == NULL ) || ( src == NULL )) return ak_error_message( ak_error_null_pointer,
+                                                 __func__ , "using a null pointer to secret key" );
+  if( src->data == NULL ) return ak_error_message( ak_error_null_pointer,
+                                                   __func__ , "using undefined round keys data" );
+  if( dst->data != NULL ) ak_kuznechik_delete_keys( dst );
+  if(( dst->data = ak_libakrypt_aligned_malloc( sizeof( ak_kuznechik_expanded_keys ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__ ,
+                                                             "wrong allocation of internal data" );
+  memcpy( dst->data, src->data, sizeof( ak_kuznechik_expanded_keys ));
+
+ return ak_kuznechik_remask_keys( dst );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Функция реализует развертку ключей для алгоритма Кузнечик.
     \param skey Указатель на контекст секретного ключа, в который помещаются развернутые
@@ -246,7 +304,7 @@
   ak_uint8 reverse[64];
   int i = 0, j = 0, l = 0, kdx = 2;
   ak_uint64 a0[2], a1[2], c[2], t[2], idx = 0;
-  ak_int64 oc = ak_libakrypt_get_option( "openssl_compability" );
+  ak_int64 oc = ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
   ak_uint64 *ekey = NULL, *mkey = NULL, *dkey = NULL, *xkey = NULL, *rkey = NULL, *lkey = NULL;
 
  /* выполняем стандартные проверки */
@@ -264,6 +322,11 @@
   if(( skey->data = ak_libakrypt_aligned_malloc( sizeof( ak_kuznechik_expanded_keys ))) == NULL )
     return ak_error_message( ak_error_out_of_memory, __func__ ,
                                                              "wrong allocation of internal data" );
+ /* если ключ уже разворачивался ранее, то копируем развернутые ключи из кэша */
+  if( ak_bckey_schedule_cache_find( skey, skey->data,
+                                           sizeof( ak_kuznechik_expanded_keys )) == ak_true )
+    return ak_kuznechik_remask_keys( skey );
+
  /* получаем указатели на области памяти */
   ekey = ( ak_uint64 *)skey->data;                  /* 10 прямых раундовых ключей */
   dkey = ( ak_uint64 *)skey->data + 20;           /* 10 обратных раундовых ключей */
@@ -292,7 +355,7 @@
   dkey[0] = a1[0]^xkey[0]; dkey[1] = a1[1]^xkey[1];
 
   ekey[2] = a0[0]^mkey[2]; ekey[3] = a0[1]^mkey[3];
-  ak_kuznechik_matrix_mul_vector( kuznechik_parameters.Linv,
+  ak_kuznechik_matrix_mul_vector( kuznechik_parameters->Linv,
                                             (ak_uint8 *)a0, (ak_uint8 *)( dkey+2 ));
   dkey[2] ^= xkey[2]; dkey[3] ^= xkey[3];
 
@@ -316,13 +379,13 @@
      }
      kdx += 2;
      ekey[kdx] = a1[0]^mkey[kdx]; ekey[kdx+1] = a1[1]^mkey[kdx+1];
-     ak_kuznechik_matrix_mul_vector( kuznechik_parameters.Linv,
+     ak_kuznechik_matrix_mul_vector( kuznechik_parameters->Linv,
                                          ( ak_uint8 *)a1, (ak_uint8 *)( dkey+kdx ));
      dkey[kdx] ^= xkey[kdx]; dkey[kdx+1] ^= xkey[kdx+1];
 
      kdx += 2;
      ekey[kdx] = a0[0]^mkey[kdx]; ekey[kdx+1] = a0[1]^mkey[kdx+1];
-     ak_kuznechik_matrix_mul_vector( kuznechik_parameters.Linv,
+     ak_kuznechik_matrix_mul_vector( kuznechik_parameters->Linv,
                                          ( ak_uint8 *)a0, (ak_uint8 *)( dkey+kdx ));
      dkey[kdx] ^= xkey[kdx]; dkey[kdx+1] ^= xkey[kdx+1];
   }
@@ -345,6 +408,9 @@
     ak_ptr_context_wipe( reverse, sizeof( reverse ), &skey->generator );
   }
 
+ /* сохраняем развернутые ключи для последующего использования */
+  ak_bckey_schedule_cache_add( skey, skey->data, sizeof( ak_kuznechik_expanded_keys ));
+
  return ak_error_ok;
 }
 
@@ -367,39 +433,39 @@
      x[0] ^= ekey[i]; x[0] ^= mkey[i];
      x[1] ^= ekey[++i]; x[1] ^= mkey[i++];
 
-     t  = kuznechik_parameters.enc[ 0][b[ 0]][0];
-     t ^= kuznechik_parameters.enc[ 1][b[ 1]][0];
-     t ^= kuznechik_parameters.enc[ 2][b[ 2]][0];
-     t ^= kuznechik_parameters.enc[ 3][b[ 3]][0];
-     t ^= kuznechik_parameters.enc[ 4][b[ 4]][0];
-     t ^= kuznechik_parameters.enc[ 5][b[ 5]][0];
-     t ^= kuznechik_parameters.enc[ 6][b[ 6]][0];
-     t ^= kuznechik_parameters.enc[ 7][b[ 7]][0];
-     t ^= kuznechik_parameters.enc[ 8][b[ 8]][0];
-     t ^= kuznechik_parameters.enc[ 9][b[ 9]][0];
-     t ^= kuznechik_parameters.enc[10][b[10]][0];
-     t ^= kuznechik_parameters.enc[11][b[11]][0];
-     t ^= kuznechik_parameters.enc[12][b[12]][0];
-     t ^= kuznechik_parameters.enc[13][b[13]][0];
-     t ^= kuznechik_parameters.enc[14][b[14]][0];
-     t ^= kuznechik_parameters.enc[15][b[15]][0];
-
-     s  = kuznechik_parameters.enc[ 0][b[ 0]][1];
-     s ^= kuznechik_parameters.enc[ 1][b[ 1]][1];
-     s ^= kuznechik_parameters.enc[ 2][b[ 2]][1];
-     s ^= kuznechik_parameters.enc[ 3][b[ 3]][1];
-     s ^= kuznechik_parameters.enc[ 4][b[ 4]][1];
-     s ^= kuznechik_parameters.enc[ 5][b[ 5]][1];
-     s ^= kuznechik_parameters.enc[ 6][b[ 6]][1];
-     s ^= kuznechik_parameters.enc[ 7][b[ 7]][1];
-     s ^= kuznechik_parameters.enc[ 8][b[ 8]][1];
-     s ^= kuznechik_parameters.enc[ 9][b[ 9]][1];
-     s ^= kuznechik_parameters.enc[10][b[10]][1];
-     s ^= kuznechik_parameters.enc[11][b[11]][1];
-     s ^= kuznechik_parameters.enc[12][b[12]][1];
-     s ^= kuznechik_parameters.enc[13][b[13]][1];
-     s ^= kuznechik_parameters.enc[14][b[14]][1];
-     s ^= kuznechik_parameters.enc[15][b[15]][1];
+     t  = kuznechik_parameters->enc[ 0][b[ 0]][0];
+     t ^= kuznechik_parameters->enc[ 1][b[ 1]][0];
+     t ^= kuznechik_parameters->enc[ 2][b[ 2]][0];
+     t ^= kuznechik_parameters->enc[ 3][b[ 3]][0];
+     t ^= kuznechik_parameters->enc[ 4][b[ 4]][0];
+     t ^= kuznechik_parameters->enc[ 5][b[ 5]][0];
+     t ^= kuznechik_parameters->enc[ 6][b[ 6]][0];
+     t ^= kuznechik_parameters->enc[ 7][b[ 7]][0];
+     t ^= kuznechik_parameters->enc[ 8][b[ 8]][0];
+     t ^= kuznechik_parameters->enc[ 9][b[ 9]][0];
+     t ^= kuznechik_parameters->enc[10][b[10]][0];
+     t ^= kuznechik_parameters->enc[11][b[11]][0];
+     t ^= kuznechik_parameters->enc[12][b[12]][0];
+     t ^= kuznechik_parameters->enc[13][b[13]][0];
+     t ^= kuznechik_parameters->enc[14][b[14]][0];
+     t ^= kuznechik_parameters->enc[15][b[15]][0];
+
+     s  = kuznechik_parameters->enc[ 0][b[ 0]][1];
+     s ^= kuznechik_parameters->enc[ 1][b[ 1]][1];
+     s ^= kuznechik_parameters->enc[ 2][b[ 2]][1];
+     s ^= kuznechik_parameters->enc[ 3][b[ 3]][1];
+     s ^= kuznechik_parameters->enc[ 4][b[ 4]][1];
+     s ^= kuznechik_parameters->enc[ 5][b[ 5]][1];
+     s ^= kuznechik_parameters->enc[ 6][b[ 6]][1];
+     s ^= kuznechik_parameters->enc[ 7][b[ 7]][1];
+     s ^= kuznechik_parameters->enc[ 8][b[ 8]][1];
+     s ^= kuznechik_parameters->enc[ 9][b[ 9]][1];
+     s ^= kuznechik_parameters->enc[10][b[10]][1];
+     s ^= kuznechik_parameters->enc[11][b[11]][1];
+     s ^= kuznechik_parameters->enc[12][b[12]][1];
+     s ^= kuznechik_parameters->enc[13][b[13]][1];
+     s ^= kuznechik_parameters->enc[14][b[14]][1];
+     s ^= kuznechik_parameters->enc[15][b[15]][1];
 
      x[0] = t; x[1] = s;
   }
@@ -423,50 +489,50 @@
   ak_uint8 *b = ( ak_uint8 *)x;
 
   x[0] = (( ak_uint64 *) in)[0]; x[1] = (( ak_uint64 *) in)[1];
-  for( i = 0; i < 16; i++ ) b[i] = kuznechik_parameters.pi[b[i]];
+  for( i = 0; i < 16; i++ ) b[i] = kuznechik_parameters->pi[b[i]];
 
   i = 19;
   while( i > 1 ) {
-     t  = kuznechik_parameters.dec[ 0][b[ 0]][0];
-     t ^= kuznechik_parameters.dec[ 1][b[ 1]][0];
-     t ^= kuznechik_parameters.dec[ 2][b[ 2]][0];
-     t ^= kuznechik_parameters.dec[ 3][b[ 3]][0];
-     t ^= kuznechik_parameters.dec[ 4][b[ 4]][0];
-     t ^= kuznechik_parameters.dec[ 5][b[ 5]][0];
-     t ^= kuznechik_parameters.dec[ 6][b[ 6]][0];
-     t ^= kuznechik_parameters.dec[ 7][b[ 7]][0];
-     t ^= kuznechik_parameters.dec[ 8][b[ 8]][0];
-     t ^= kuznechik_parameters.dec[ 9][b[ 9]][0];
-     t ^= kuznechik_parameters.dec[10][b[10]][0];
-     t ^= kuznechik_parameters.dec[11][b[11]][0];
-     t ^= kuznechik_parameters.dec[12][b[12]][0];
-     t ^= kuznechik_parameters.dec[13][b[13]][0];
-     t ^= kuznechik_parameters.dec[14][b[14]][0];
-     t ^= kuznechik_parameters.dec[15][b[15]][0];
-
-     s  = kuznechik_parameters.dec[ 0][b[ 0]][1];
-     s ^= kuznechik_parameters.dec[ 1][b[ 1]][1];
-     s ^= kuznechik_parameters.dec[ 2][b[ 2]][1];
-     s ^= kuznechik_parameters.dec[ 3][b[ 3]][1];
-     s ^= kuznechik_parameters.dec[ 4][b[ 4]][1];
-     s ^= kuznechik_parameters.dec[ 5][b[ 5]][1];
-     s ^= kuznechik_parameters.dec[ 6][b[ 6]][1];
-     s ^= kuznechik_parameters.dec[ 7][b[ 7]][1];
-     s ^= kuznechik_parameters.dec[ 8][b[ 8]][1];
-     s ^= kuznechik_parameters.dec[ 9][b[ 9]][1];
-     s ^= kuznechik_parameters.dec[10][b[10]][1];
-     s ^= kuznechik_parameters.dec[11][b[11]][1];
-     s ^= kuznechik_parameters.dec[12][b[12]][1];
-     s ^= kuznechik_parameters.dec[13][b[13]][1];
-     s ^= kuznechik_parameters.dec[14][b[14]][1];
-     s ^= kuznechik_parameters.dec[15][b[15]][1];
+     t  = kuznechik_parameters->dec[ 0][b[ 0]][0];
+     t ^= kuznechik_parameters->dec[ 1][b[ 1]][0];
+     t ^= kuznechik_parameters->dec[ 2][b[ 2]][0];
+     t ^= kuznechik_parameters->dec[ 3][b[ 3]][0];
+     t ^= kuznechik_parameters->dec[ 4][b[ 4]][0];
+     t ^= kuznechik_parameters->dec[ 5][b[ 5]][0];
+     t ^= kuznechik_parameters->dec[ 6][b[ 6]][0];
+     t ^= kuznechik_parameters->dec[ 7][b[ 7]][0];
+     t ^= kuznechik_parameters->dec[ 8][b[ 8]][0];
+     t ^= kuznechik_parameters->dec[ 9][b[ 9]][0];
+     t ^= kuznechik_parameters->dec[10][b[10]][0];
+     t ^= kuznechik_parameters->dec[11][b[11]][0];
+     t ^= kuznechik_parameters->dec[12][b[12]][0];
+     t ^= kuznechik_parameters->dec[13][b[13]][0];
+     t ^= kuznechik_parameters->dec[14][b[14]][0];
+     t ^= kuznechik_parameters->dec[15][b[15]][0];
+
+     s  = kuznechik_parameters->dec[ 0][b[ 0]][1];
+     s ^= kuznechik_parameters->dec[ 1][b[ 1]][1];
+     s ^= kuznechik_parameters->dec[ 2][b[ 2]][1];
+     s ^= kuznechik_parameters->dec[ 3][b[ 3]][1];
+     s ^= kuznechik_parameters->dec[ 4][b[ 4]][1];
+     s ^= kuznechik_parameters->dec[ 5][b[ 5]][1];
+     s ^= kuznechik_parameters->dec[ 6][b[ 6]][1];
+     s ^= kuznechik_parameters->dec[ 7][b[ 7]][1];
+     s ^= kuznechik_parameters->dec[ 8][b[ 8]][1];
+     s ^= kuznechik_parameters->dec[ 9][b[ 9]][1];
+     s ^= kuznechik_parameters->dec[10][b[10]][1];
+     s ^= kuznechik_parameters->dec[11][b[11]][1];
+     s ^= kuznechik_parameters->dec[12][b[12]][1];
+     s ^= kuznechik_parameters->dec[13][b[13]][1];
+     s ^= kuznechik_parameters->dec[14][b[14]][1];
+     s ^= kuznechik_parameters->dec[15][b[15]][1];
 
      x[0] = t; x[1] = s;
 
      x[1] ^= dkey[i]; x[1] ^= xkey[i--];
      x[0] ^= dkey[i]; x[0] ^= xkey[i--];
   }
-  for( i = 0; i < 16; i++ ) b[i] = kuznechik_parameters.pinv[b[i]];
+  for( i = 0; i < 16; i++ ) b[i] = kuznechik_parameters->pinv[b[i]];
 
   x[0] ^= dkey[0]; x[1] ^= dkey[1];
   (( ak_uint64 *) out)[0] = x[0] ^ xkey[0];
@@ -495,39 +561,39 @@
      x[0] ^= ekey[i]; x[0] ^= mkey[i];
      x[1] ^= ekey[++i]; x[1] ^= mkey[i++];
 
-     t  = kuznechik_parameters.enc[ 0][b[15]][0];
-     t ^= kuznechik_parameters.enc[ 1][b[14]][0];
-     t ^= kuznechik_parameters.enc[ 2][b[13]][0];
-     t ^= kuznechik_parameters.enc[ 3][b[12]][0];
-     t ^= kuznechik_parameters.enc[ 4][b[11]][0];
-     t ^= kuznechik_parameters.enc[ 5][b[10]][0];
-     t ^= kuznechik_parameters.enc[ 6][b[ 9]][0];
-     t ^= kuznechik_parameters.enc[ 7][b[ 8]][0];
-     t ^= kuznechik_parameters.enc[ 8][b[ 7]][0];
-     t ^= kuznechik_parameters.enc[ 9][b[ 6]][0];
-     t ^= kuznechik_parameters.enc[10][b[ 5]][0];
-     t ^= kuznechik_parameters.enc[11][b[ 4]][0];
-     t ^= kuznechik_parameters.enc[12][b[ 3]][0];
-     t ^= kuznechik_parameters.enc[13][b[ 2]][0];
-     t ^= kuznechik_parameters.enc[14][b[ 1]][0];
-     t ^= kuznechik_parameters.enc[15][b[ 0]][0];
-
-     s  = kuznechik_parameters.enc[ 0][b[15]][1];
-     s ^= kuznechik_parameters.enc[ 1][b[14]][1];
-     s ^= kuznechik_parameters.enc[ 2][b[13]][1];
-     s ^= kuznechik_parameters.enc[ 3][b[12]][1];
-     s ^= kuznechik_parameters.enc[ 4][b[11]][1];
-     s ^= kuznechik_parameters.enc[ 5][b[10]][1];
-     s ^= kuznechik_parameters.enc[ 6][b[ 9]][1];
-     s ^= kuznechik_parameters.enc[ 7][b[ 8]][1];
-     s ^= kuznechik_parameters.enc[ 8][b[ 7]][1];
-     s ^= kuznechik_parameters.enc[ 9][b[ 6]][1];
-     s ^= kuznechik_parameters.enc[10][b[ 5]][1];
-     s ^= kuznechik_parameters.enc[11][b[ 4]][1];
-     s ^= kuznechik_parameters.enc[12][b[ 3]][1];
-     s ^= kuznechik_parameters.enc[13][b[ 2]][1];
-     s ^= kuznechik_parameters.enc[14][b[ 1]][1];
-     s ^= kuznechik_parameters.enc[15][b[ 0]][1];
+     t  = kuznechik_parameters->enc[ 0][b[15]][0];
+     t ^= kuznechik_parameters->enc[ 1][b[14]][0];
+     t ^= kuznechik_parameters->enc[ 2][b[13]][0];
+     t ^= kuznechik_parameters->enc[ 3][b[12]][0];
+     t ^= kuznechik_parameters->enc[ 4][b[11]][0];
+     t ^= kuznechik_parameters->enc[ 5][b[10]][0];
+     t ^= kuznechik_parameters->enc[ 6][b[ 9]][0];
+     t ^= kuznechik_parameters->enc[ 7][b[ 8]][0];
+     t ^= kuznechik_parameters->enc[ 8][b[ 7]][0];
+     t ^= kuznechik_parameters->enc[ 9][b[ 6]][0];
+     t ^= kuznechik_parameters->enc[10][b[ 5]][0];
+     t ^= kuznechik_parameters->enc[11][b[ 4]][0];
+     t ^= kuznechik_parameters->enc[12][b[ 3]][0];
+     t ^= kuznechik_parameters->enc[13][b[ 2]][0];
+     t ^= kuznechik_parameters->enc[14][b[ 1]][0];
+     t ^= kuznechik_parameters->enc[15][b[ 0]][0];
+
+     s  = kuznechik_parameters->enc[ 0][b[15]][1];
+     s ^= kuznechik_parameters->enc[ 1][b[14]][1];
+     s ^= kuznechik_parameters->enc[ 2][b[13]][1];
+     s ^= kuznechik_parameters->enc[ 3][b[12]][1];
+     s ^= kuznechik_parameters->enc[ 4][b[11]][1];
+     s ^= kuznechik_parameters->enc[ 5][b[10]][1];
+     s ^= kuznechik_parameters->enc[ 6][b[ 9]][1];
+     s ^= kuznechik_parameters->enc[ 7][b[ 8]][1];
+     s ^= kuznechik_parameters->enc[ 8][b[ 7]][1];
+     s ^= kuznechik_parameters->enc[ 9][b[ 6]][1];
+     s ^= kuznechik_parameters->enc[10][b[ 5]][1];
+     s ^= kuznechik_parameters->enc[11][b[ 4]][1];
+     s ^= kuznechik_parameters->enc[12][b[ 3]][1];
+     s ^= kuznechik_parameters->enc[13][b[ 2]][1];
+     s ^= kuznechik_parameters->enc[14][b[ 1]][1];
+     s ^= kuznechik_parameters->enc[15][b[ 0]][1];
 
      x[0] = t; x[1] = s;
   }
@@ -554,50 +620,50 @@
   ak_uint8 *b = ( ak_uint8 *)x;
 
   x[0] = (( ak_uint64 *) in)[0]; x[1] = (( ak_uint64 *) in)[1];
-  for( i = 0; i < 16; i++ ) b[i] = kuznechik_parameters.pi[b[i]];
+  for( i = 0; i < 16; i++ ) b[i] = kuznechik_parameters->pi[b[i]];
 
   i = 19;
   while( i > 1 ) {
-     t  = kuznechik_parameters.dec[ 0][b[15]][0];
-     t ^= kuznechik_parameters.dec[ 1][b[14]][0];
-     t ^= kuznechik_parameters.dec[ 2][b[13]][0];
-     t ^= kuznechik_parameters.dec[ 3][b[12]][0];
-     t ^= kuznechik_parameters.dec[ 4][b[11]][0];
-     t ^= kuznechik_parameters.dec[ 5][b[10]][0];
-     t ^= kuznechik_parameters.dec[ 6][b[ 9]][0];
-     t ^= kuznechik_parameters.dec[ 7][b[ 8]][0];
-     t ^= kuznechik_parameters.dec[ 8][b[ 7]][0];
-     t ^= kuznechik_parameters.dec[ 9][b[ 6]][0];
-     t ^= kuznechik_parameters.dec[10][b[ 5]][0];
-     t ^= kuznechik_parameters.dec[11][b[ 4]][0];
-     t ^= kuznechik_parameters.dec[12][b[ 3]][0];
-     t ^= kuznechik_parameters.dec[13][b[ 2]][0];
-     t ^= kuznechik_parameters.dec[14][b[ 1]][0];
-     t ^= kuznechik_parameters.dec[15][b[ 0]][0];
-
-     s  = kuznechik_parameters.dec[ 0][b[15]][1];
-     s ^= kuznechik_parameters.dec[ 1][b[14]][1];
-     s ^= kuznechik_parameters.dec[ 2][b[13]][1];
-     s ^= kuznechik_parameters.dec[ 3][b[12]][1];
-     s ^= kuznechik_parameters.dec[ 4][b[11]][1];
-     s ^= kuznechik_parameters.dec[ 5][b[10]][1];
-     s ^= kuznechik_parameters.dec[ 6][b[ 9]][1];
-     s ^= kuznechik_parameters.dec[ 7][b[ 8]][1];
-     s ^= kuznechik_parameters.dec[ 8][b[ 7]][1];
-     s ^= kuznechik_parameters.dec[ 9][b[ 6]][1];
-     s ^= kuznechik_parameters.dec[10][b[ 5]][1];
-     s ^= kuznechik_parameters.dec[11][b[ 4]][1];
-     s ^= kuznechik_parameters.dec[12][b[ 3]][1];
-     s ^= kuznechik_parameters.dec[13][b[ 2]][1];
-     s ^= kuznechik_parameters.dec[14][b[ 1]][1];
-     s ^= kuznechik_parameters.dec[15][b[ 0]][1];
+     t  = kuznechik_parameters->dec[ 0][b[15]][0];
+     t ^= kuznechik_parameters->dec[ 1][b[14]][0];
+     t ^= kuznechik_parameters->dec[ 2][b[13]][0];
+     t ^= kuznechik_parameters->dec[ 3][b[12]][0];
+     t ^= kuznechik_parameters->dec[ 4][b[11]][0];
+     t ^= kuznechik_parameters->dec[ 5][b[10]][0];
+     t ^= kuznechik_parameters->dec[ 6][b[ 9]][0];
+     t ^= kuznechik_parameters->dec[ 7][b[ 8]][0];
+     t ^= kuznechik_parameters->dec[ 8][b[ 7]][0];
+     t ^= kuznechik_parameters->dec[ 9][b[ 6]][0];
+     t ^= kuznechik_parameters->dec[10][b[ 5]][0];
+     t ^= kuznechik_parameters->dec[11][b[ 4]][0];
+     t ^= kuznechik_parameters->dec[12][b[ 3]][0];
+     t ^= kuznechik_parameters->dec[13][b[ 2]][0];
+     t ^= kuznechik_parameters->dec[14][b[ 1]][0];
+     t ^= kuznechik_parameters->dec[15][b[ 0]][0];
+
+     s  = kuznechik_parameters->dec[ 0][b[15]][1];
+     s ^= kuznechik_parameters->dec[ 1][b[14]][1];
+     s ^= kuznechik_parameters->dec[ 2][b[13]][1];
+     s ^= kuznechik_parameters->dec[ 3][b[12]][1];
+     s ^= kuznechik_parameters->dec[ 4][b[11]][1];
+     s ^= kuznechik_parameters->dec[ 5][b[10]][1];
+     s ^= kuznechik_parameters->dec[ 6][b[ 9]][1];
+     s ^= kuznechik_parameters->dec[ 7][b[ 8]][1];
+     s ^= kuznechik_parameters->dec[ 8][b[ 7]][1];
+     s ^= kuznechik_parameters->dec[ 9][b[ 6]][1];
+     s ^= kuznechik_parameters->dec[10][b[ 5]][1];
+     s ^= kuznechik_parameters->dec[11][b[ 4]][1];
+     s ^= kuznechik_parameters->dec[12][b[ 3]][1];
+     s ^= kuznechik_parameters->dec[13][b[ 2]][1];
+     s ^= kuznechik_parameters->dec[14][b[ 1]][1];
+     s ^= kuznechik_parameters->dec[15][b[ 0]][1];
 
      x[0] = t; x[1] = s;
 
      x[1] ^= dkey[i]; x[1] ^= xkey[i--];
      x[0] ^= dkey[i]; x[0] ^= xkey[i--];
   }
-  for( i = 0; i < 16; i++ ) b[i] = kuznechik_parameters.pinv[b[i]];
+  for( i = 0; i < 16; i++ ) b[i] = kuznechik_parameters->pinv[b[i]];
 
   x[0] ^= dkey[0]; x[1] ^= dkey[1];
   (( ak_uint64 *) out)[0] = x[0] ^ xkey[0];
@@ -613,7 +679,8 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_bckey_context_create_kuznechik( ak_bckey bkey )
 {
-  int error = ak_error_ok, oc = (int) ak_libakrypt_get_option( "openssl_compability" );
+  int error = ak_error_ok,
+      oc = (int) ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
 
   if( bkey == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                "using null pointer to block cipher key context" );
@@ -637,6 +704,7 @@
  /* устанавливаем методы */
   bkey->schedule_keys = ak_kuznechik_schedule_keys;
   bkey->delete_keys = ak_kuznechik_delete_keys;
+  bkey->clone_keys = ak_kuznechik_clone_keys;
   if( oc ) {
     bkey->encrypt = ak_kuznechik_encrypt_with_mask_oc;
     bkey->decrypt = ak_kuznechik_decrypt_with_mask_oc;
@@ -655,9 +723,12 @@
 {
   struct hash ctx;
   ak_uint8 out[16];
-  struct kuznechik_params parameters;
+  const struct kuznechik_params *parameters = NULL;
+#ifndef LIBAKRYPT_CONST_KUZNECHIK_TABLES
+  struct kuznechik_params generated;
+#endif
   int error = ak_error_ok, audit = ak_log_get_level(),
-      oc = (int) ak_libakrypt_get_option( "openssl_compability" );
+      oc = (int) ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
 
   ak_uint8 esum[16] = {
                  0x5b,0x80,0x54,0xb3,0x4e,0x81,0x09,0x94,0xcc,0x83,0x8b,0x8e,0x53,0xba,0x9d,0x18 };
@@ -686,11 +757,20 @@
               return ak_false;
     }
 
+#ifdef LIBAKRYPT_CONST_KUZNECHIK_TABLES
+ /* проверяем таблицы, выработанные на этапе сборки библиотеки */
+  if(( parameters = kuznechik_parameters ) == NULL ) {
+    ak_error_message( ak_error_null_pointer, __func__, "using undefined kuznechik parameters" );
+    return ak_false;
+  }
+#else
  /* вырабатываем значения параметров */
-  ak_bckey_context_kuznechik_init_tables( gost_lvec, gost_pi, &parameters );
+  ak_bckey_context_kuznechik_init_tables( gost_lvec, gost_pi, &generated );
+  parameters = &generated;
+#endif
 
  /* проверяем генерацию обратной перестановки */
-  if( !ak_ptr_is_equal_with_log( parameters.pinv, gost_pinv, sizeof( sbox ))) {
+  if( !ak_ptr_is_equal_with_log( parameters->pinv, gost_pinv, sizeof( sbox ))) {
     ak_error_message( ak_error_not_equal_data, __func__,
                                          "incorrect generation of nonlinear inverse permutation" );
     return ak_false;
@@ -699,7 +779,7 @@
                                                                      "inverse permutation is Ok" );
 
  /* проверяем генерацию сопровождающей матрицы линейного регистра сдвига и обратной к ней */
-  if( !ak_ptr_is_equal( parameters.L, gost_L, sizeof( linear_matrix ))) {
+  if( !ak_ptr_is_equal( parameters->L, gost_L, sizeof( linear_matrix ))) {
     size_t i = 0;
     ak_error_message( ak_error_not_equal_data, __func__,
                                               "incorrect generation of linear reccurence matrix" );
@@ -707,15 +787,15 @@
     for( i = 0; i < 16; i++ ) {
       ak_error_message_fmt( 0, __func__,
         "%02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x",
-        parameters.L[i][0],  parameters.L[i][1],  parameters.L[i][2],  parameters.L[i][3],
-        parameters.L[i][4],  parameters.L[i][5],  parameters.L[i][6],  parameters.L[i][7],
-        parameters.L[i][8],  parameters.L[i][9],  parameters.L[i][10], parameters.L[i][11],
-              parameters.L[i][12], parameters.L[i][13], parameters.L[i][14], parameters.L[i][15] );
+        parameters->L[i][0],  parameters->L[i][1],  parameters->L[i][2],  parameters->L[i][3],
+        parameters->L[i][4],  parameters->L[i][5],  parameters->L[i][6],  parameters->L[i][7],
+        parameters->L[i][8],  parameters->L[i][9],  parameters->L[i][10], parameters->L[i][11],
+              parameters->L[i][12], parameters->L[i][13], parameters->L[i][14], parameters->L[i][15] );
     }
     return ak_false;
   }
 
-  if( !ak_ptr_is_equal( parameters.Linv, gost_Linv, sizeof( linear_matrix ))) {
+  if( !ak_ptr_is_equal( parameters->Linv, gost_Linv, sizeof( linear_matrix ))) {
     size_t i = 0;
     ak_error_message( ak_error_not_equal_data, __func__,
                                               "incorrect generation inverse of companion matrix" );
@@ -723,12 +803,12 @@
     for( i = 0; i < 16; i++ ) {
       ak_error_message_fmt( 0, __func__,
         "%02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x %02x",
-        parameters.Linv[i][0],  parameters.Linv[i][1],  parameters.Linv[i][2],
-        parameters.Linv[i][3],  parameters.Linv[i][4],  parameters.Linv[i][5],
-        parameters.Linv[i][6],  parameters.Linv[i][7],  parameters.Linv[i][8],
-        parameters.Linv[i][9],  parameters.Linv[i][10], parameters.Linv[i][11],
-        parameters.Linv[i][12], parameters.Linv[i][13], parameters.Linv[i][14],
-                                                                          parameters.Linv[i][15] );
+        parameters->Linv[i][0],  parameters->Linv[i][1],  parameters->Linv[i][2],
+        parameters->Linv[i][3],  parameters->Linv[i][4],  parameters->Linv[i][5],
+        parameters->Linv[i][6],  parameters->Linv[i][7],  parameters->Linv[i][8],
+        parameters->Linv[i][9],  parameters->Linv[i][10], parameters->Linv[i][11],
+        parameters->Linv[i][12], parameters->Linv[i][13], parameters->Linv[i][14],
+                                                                          parameters->Linv[i][15] );
     }
     return ak_false;
   }
@@ -739,7 +819,8 @@
     ak_error_message( error, __func__, "incorrect creation of hash function context" );
     return ak_false;
   }
-  ak_hash_context_ptr( &ctx, parameters.enc, sizeof( expanded_table ), out, sizeof( out ));
+  ak_hash_context_ptr( &ctx, ( ak_pointer )parameters->enc,
+                                                   sizeof( expanded_table ), out, sizeof( out ));
   if( !ak_ptr_is_equal_with_log( out, oc ? esum2 : esum, sizeof( out ))) {
     ak_hash_context_destroy( &ctx );
     ak_error_message( ak_error_not_equal_data, __func__,
@@ -747,7 +828,8 @@
     return ak_false;
   }
 
-  ak_hash_context_ptr( &ctx, parameters.dec, sizeof( expanded_table ), out, sizeof( out ));
+  ak_hash_context_ptr( &ctx, ( ak_pointer )parameters->dec,
+                                                   sizeof( expanded_table ), out, sizeof( out ));
   if( !ak_ptr_is_equal_with_log( out, oc ? dsum2 : dsum, sizeof( out ))) {
     ak_hash_context_destroy( &ctx );    
     ak_error_message( ak_error_not_equal_data, __func__,
@@ -768,7 +850,7 @@
   ak_uint8 myout[256];
   bool_t result = ak_true;
   int error = ak_error_ok, audit = ak_log_get_level(),
-      oc = (int) ak_libakrypt_get_option( "openssl_compability" );
+      oc = (int) ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
 
  /* тестовый ключ из ГОСТ Р 34.12-2015, приложение А.1 */
  /* тестовый ключ из ГОСТ Р 34.13-2015, приложение А.1 */
@@ -451,6 +451,20 @@
   if( ak_libakrypt_destroy_context_manager() != ak_error_ok ) {
     ak_error_message( ak_error_get_value(), __func__, "destroying of context manager is wrong" );
   }
+ /* уничтожаем развернутые раундовые ключи, хранящиеся в кэше */
+  if( ak_bckey_schedule_cache_clear() != ak_error_ok ) {
+    ak_error_message( ak_error_get_value(), __func__, "destroying of round keys cache is wrong" );
+  }
+ /* уничтожаем таблицы кратных образующих точек эллиптических кривых */
+  if( ak_wcurve_base_cache_clear() != ak_error_ok ) {
+    ak_error_message( ak_error_get_value(), __func__,
+                                                "destroying of base point tables cache is wrong" );
+  }
+ /* уничтожаем результаты проверки открытых ключей */
+  if( ak_verifykey_check_cache_clear() != ak_error_ok ) {
+    ak_error_message( ak_error_get_value(), __func__,
+                                                "destroying of public keys check cache is wrong" );
+  }
 #endif
 
   if( ak_log_get_level() != ak_log_none )
@@ -468,7 +482,7 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_libakrypt_set_openssl_compability( bool_t flag )
 {
-  if( ak_libakrypt_set_option( "openssl_compability", flag ) != ak_error_ok )
+  if( ak_libakrypt_set_option_by_index( ak_option_openssl_compability, flag ) != ak_error_ok )
     return ak_error_message( ak_error_get_value(), __func__, "using an incorrect option name" );
   return ak_bckey_context_kuznechik_init_gost_tables();
 }
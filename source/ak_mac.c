@@ -63,6 +63,35 @@
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция копирует в контекст `dst` текущее состояние контекста `src`, включая
+    необработанные данные, хранящиеся во временном буффере. Поскольку контекст итерационного
+    сжатия содержит указатель на родительский объект, указатель на объект, которым будут
+    оперировать функции копии, передается явно.
+
+    @param dst Указатель на контекст итерационного сжатия, в который помещается копия.
+    @param src Указатель на копируемый контекст итерационного сжатия.
+    @param ictx Указатель на родительский объект копии.
+    @return В случае успеха возвращается \ref ak_error_ok (ноль). В случае возникновения ошибки
+    возвращается ее код.                                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_mac_context_clone( ak_mac dst, ak_mac src, ak_pointer ictx )
+{
+  if(( dst == NULL ) || ( src == NULL )) return ak_error_message( ak_error_null_pointer,
+                                                   __func__, "using null pointer to mac context" );
+  if( ictx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                        "using null pointer to internal context" );
+  memcpy( dst->data, src->data, sizeof( dst->data ));
+  dst->length = src->length;
+  dst->bsize = src->bsize;
+  dst->ctx = ictx;
+  dst->clean = src->clean;
+  dst->update = src->update;
+  dst->finalize = src->finalize;
+
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param mctx Указатель на контекст итерационного сжатия.
     @return В случае успеха возвращается \ref ak_error_ok (ноль). В случае возникновения ошибки
@@ -51,6 +51,8 @@
      ak_function_context_clean * , ak_function_context_update * , ak_function_context_finalize * );
 /*! \brief Функция удаления контекста. */
  int ak_mac_context_destroy( ak_mac );
+/*! \brief Создание копии контекста сжимающего отображения. */
+ int ak_mac_context_clone( ak_mac , ak_mac , ak_pointer );
 /*! \brief Очистка контекста сжимающего отображения. */
  int ak_mac_context_clean( ak_mac );
 /*! \brief Обновление состояния контекста сжимающего отображения. */
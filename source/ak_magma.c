@@ -368,6 +368,62 @@
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция сменяет аддитивные маски развернутых ключей алгоритма Магма.
+    \details Используется после копирования развернутых ключей, например, из кэша.
+
+    @param skey Указатель на контекст секретного ключа
+
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае,
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_magma_context_remask_keys( ak_skey skey )
+{
+  size_t idx = 0, jdx = 0;
+  ak_uint32 newmask[8];
+  int error = ak_error_ok;
+  struct magma_encrypted_keys *data = ( struct magma_encrypted_keys *)skey->data;
+
+  for( jdx = 0; jdx < 2; jdx++ ) {
+     if(( error = ak_random_context_random( &skey->generator,
+                                                     newmask, sizeof( newmask ))) != ak_error_ok )
+       return ak_error_message( error, __func__, "wrong generation of random masks" );
+     for( idx = 0; idx < 8; idx++ ) {
+        data->inkey[jdx][idx] += newmask[idx];
+        data->inkey[jdx][idx] -= data->inmask[jdx][idx];
+        data->inmask[jdx][idx] = newmask[idx];
+     }
+  }
+  ak_ptr_context_wipe( newmask, sizeof( newmask ), &skey->generator );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция копирует развернутые ключи алгоритма Магма и сменяет их аддитивные маски.
+
+    @param dst Указатель на контекст секретного ключа, в который помещается копия
+    @param src Указатель на контекст копируемого секретного ключа
+
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае,
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_magma_context_clone_keys( ak_skey dst, ak_skey src )
+{
+  if(( dst == NULL ) || ( src == NULL )) return ak_error_message( ak_error_null_pointer,
+                                             __func__ , "using a null pointer to secret key" );
+  if( src->data == NULL ) return ak_error_message( ak_error_null_pointer,
+                                                   __func__ , "using undefined round keys data" );
+  if( dst->data != NULL ) ak_magma_context_delete_keys( dst );
+  if(( dst->data = ak_libakrypt_aligned_malloc( sizeof( struct magma_encrypted_keys ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+
+  memcpy( dst->data, src->data, sizeof( struct magma_encrypted_keys ));
+  dst->flags |= ak_key_flag_data_not_free;
+
+ return ak_magma_context_remask_keys( dst );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Функция выработки инвертированного ключа и ключевых масок.
 
@@ -397,6 +453,10 @@
   skey->data = ( ak_pointer )data;
   skey->flags |= ak_key_flag_data_not_free;
 
+ /* если ключ уже разворачивался ранее, то копируем развернутые ключи из кэша */
+  if( ak_bckey_schedule_cache_find( skey, data, sizeof( struct magma_encrypted_keys )) == ak_true )
+    return ak_magma_context_remask_keys( skey );
+
  /* размещаем данные */
   if(( error = ak_random_context_random( &skey->generator, data->inmask, sizeof( data->inmask ))) != ak_error_ok )
     return ak_error_message( error, __func__, "incorrect generation first secret key mask" );
@@ -411,6 +471,9 @@
      data->inkey[1][idx] += data->inmask[0][idx];                  /* сняли старую маску */
   }
 
+ /* сохраняем развернутые ключи для последующего использования */
+  ak_bckey_schedule_cache_add( skey, data, sizeof( struct magma_encrypted_keys ));
+
  return ak_error_ok;
 }
 
@@ -619,7 +682,8 @@
 /* ----------------------------------------------------------------------------------------------- */
 int ak_bckey_context_create_magma( ak_bckey bkey )
 {
-  int error = ak_error_ok, oc = (int) ak_libakrypt_get_option( "openssl_compability" );
+  int error = ak_error_ok,
+      oc = (int) ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
 
   if( bkey == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                "using null pointer to block cipher key context" );
@@ -648,6 +712,7 @@ int ak_bckey_context_create_magma( ak_bckey bkey )
 
   bkey->schedule_keys = ak_magma_context_schedule_keys;
   bkey->delete_keys = ak_magma_context_delete_keys;
+  bkey->clone_keys = ak_magma_context_clone_keys;
   if( oc ) {
     bkey->encrypt = ak_magma_encrypt_with_random_walk_oc;
     bkey->decrypt = ak_magma_decrypt_with_random_walk_oc;
@@ -765,7 +830,7 @@ int ak_bckey_context_create_magma( ak_bckey bkey )
   ak_uint8 myout[256];
   bool_t result = ak_true;
   int error = ak_error_ok, audit = ak_log_get_level(),
-      oc = (int) ak_libakrypt_get_option( "openssl_compability" );
+      oc = (int) ak_libakrypt_get_option_by_index( ak_option_openssl_compability );
 
  /* Проверка используемого режима совместимости */
   if(( oc < 0 ) || ( oc > 1 )) {
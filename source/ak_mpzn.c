@@ -773,52 +773,1058 @@
   if( cy != t[2*size] ) memcpy( z, t+size, size*sizeof( ak_uint64 ));
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/* Развернутые реализации умножения Монтгомери для модулей фиксированной длины.                    */
+/* Используется метод CIOS (Coarsely Integrated Operand Scanning) из указанной выше статьи,        */
+/* в котором вычисление очередной строки произведения чередуется с шагом приведения по модулю,     */
+/* что позволяет обойтись временным массивом длины size+2 вместо 2*size+1.                         */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление t + a*b + c; младшее слово помещается в t, старшее - в c. */
+ #define ak_mpzn_cios_mac( t, c, a, b )   \
+ do {                                     \
+    ak_uint64 __w1, __w0;                 \
+    umul_ppmm( __w1, __w0, (a), (b) );    \
+    __w0 += (c);                          \
+    __w1 += ( __w0 < (c) );               \
+    __w0 += (t);                          \
+    __w1 += ( __w0 < (t) );               \
+    (t) = __w0;                           \
+    (c) = __w1;                           \
+ } while(0)
+
+/*! \brief Вычисление t[j-1] = t[j] + m*p[j] + c (сдвиг на одно слово при приведении). */
+ #define ak_mpzn_cios_red( t, j, c, m, p ) \
+ do {                                      \
+    ak_uint64 __w1, __w0;                  \
+    umul_ppmm( __w1, __w0, (m), (p)[j] );  \
+    __w0 += (c);                           \
+    __w1 += ( __w0 < (c) );                \
+    __w0 += (t)[j];                        \
+    __w1 += ( __w0 < (t)[j] );             \
+    (t)[(j)-1] = __w0;                     \
+    (c) = __w1;                            \
+ } while(0)
+
+/*! \brief Прибавление к t[size], t[size+1] переноса, оставшегося после вычисления строки. */
+ #define ak_mpzn_cios_top( t, c, size ) \
+ do {                                   \
+    (t)[size] += (c);                   \
+    (t)[(size)+1] = ( (t)[size] < (c) );  \
+ } while(0)
+
+/*! \brief Завершение шага приведения: нулевое слово t[0] + m*p[0] обращается в ноль. */
+ #define ak_mpzn_cios_first( t, c, m, p, n0 )  \
+ do {                                          \
+    ak_uint64 __w1, __w0;                      \
+    m = (t)[0]*(n0);                           \
+    umul_ppmm( __w1, __w0, (m), (p)[0] );      \
+    __w0 += (t)[0];                            \
+    (c) = __w1 + ( __w0 < (t)[0] );            \
+ } while(0)
+
+/*! \brief Перенос старших слов после шага приведения. */
+ #define ak_mpzn_cios_last( t, c, size )            \
+ do {                                               \
+    (t)[(size)-1] = (t)[size] + (c);                \
+    (t)[size] = (t)[(size)+1] + ( (t)[(size)-1] < (c) ); \
+ } while(0)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычитание модуля и запись результата умножения Монтгомери. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_mpzn_cios_final( ak_uint64 *z, ak_uint64 *t, ak_uint64 *p, const size_t size )
+{
+  size_t i = 0;
+  ak_uint64 av = 0, bv = 0, cy = 0;
+  ak_mpznmax u;
+
+  for( i = 0; i < size; i++ ) {
+     av = t[i];
+     bv = av - cy;
+     cy = bv > av;
+     av = bv - p[i];
+     cy += av > bv;
+     u[i] = av;
+  }
+  if( cy != t[size] ) memcpy( z, t, size*sizeof( ak_uint64 ));
+   else memcpy( z, u, size*sizeof( ak_uint64 ));
+}
+
+#ifdef LIBAKRYPT_HAVE_BUILTIN_MULX_ADX
+/* ----------------------------------------------------------------------------------------------- */
+/* Реализация строк метода CIOS инструкциями MULX, ADCX и ADOX (расширения BMI2 и ADX).           */
+/* Младшие части произведений прибавляются к слову временного массива в цепочке переносов флага CF */
+/* (инструкция ADCX), старшие части - в независимой цепочке переносов флага OF (инструкция ADOX),  */
+/* тем самым обе цепочки сложений выполняются процессором параллельно. Инструкция MULX не        */
+/* изменяет флаги. Операнды ассемблерных вставок: %0 - младшая часть произведения, %1 и %2 -      */
+/* старшие части текущего и предыдущего произведений, %3 - слово суммы, %4 - ноль,                 */
+/* %5 - временный массив t, %6 - множитель y, %7 - модуль p, %8 - слово x[i], %9 - константа n0.   */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Начало строки: в регистр rdx помещается слово x[i], флаги CF и OF обнуляются. */
+ #define ak_mpzn_adx_begin                                                                     \
+    "movq %8, %%rdx\n\t"                                                                       \
+    "xorl %k4, %k4\n\t"
+
+/*! \brief Вычисление t[j] = t[j] + lo(x[i]*y[j]) + hi(x[i]*y[j-1]). */
+ #define ak_mpzn_adx_mul( j, h, ph )                                                           \
+    "mulxq 8*" #j "(%6), %0, " h "\n\t"                                                        \
+    "movq 8*" #j "(%5), %3\n\t"                                                                \
+    "adcxq %0, %3\n\t"                                                                         \
+    "adoxq " ph ", %3\n\t"                                                                     \
+    "movq %3, 8*" #j "(%5)\n\t"
+
+/*! \brief Перенос в старшие слова t[n], t[n+1] и начало шага приведения: m = t[0]*n0,
+    слово t[0] + lo(m*p[0]) обращается в ноль, сохраняется только перенос. */
+ #define ak_mpzn_adx_top( n, ph )                                                              \
+    "movq 8*" #n "(%5), %3\n\t"                                                                \
+    "adcxq %4, %3\n\t"                                                                         \
+    "adoxq " ph ", %3\n\t"                                                                     \
+    "movq %3, 8*" #n "(%5)\n\t"                                                                \
+    "movl $0, %k3\n\t"                                                                         \
+    "adcxq %4, %3\n\t"                                                                         \
+    "adoxq %4, %3\n\t"                                                                         \
+    "movq %3, 8*(" #n "+1)(%5)\n\t"                                                            \
+    "movq (%5), %%rdx\n\t"                                                                     \
+    "imulq %9, %%rdx\n\t"                                                                      \
+    "xorl %k4, %k4\n\t"                                                                        \
+    "mulxq (%7), %0, %1\n\t"                                                                   \
+    "movq (%5), %3\n\t"                                                                        \
+    "adcxq %0, %3\n\t"
+
+/*! \brief Вычисление t[j-1] = t[j] + lo(m*p[j]) + hi(m*p[j-1]) (сдвиг на одно слово). */
+ #define ak_mpzn_adx_red( j, h, ph )                                                           \
+    "mulxq 8*" #j "(%7), %0, " h "\n\t"                                                        \
+    "movq 8*" #j "(%5), %3\n\t"                                                                \
+    "adcxq %0, %3\n\t"                                                                         \
+    "adoxq " ph ", %3\n\t"                                                                     \
+    "movq %3, 8*(" #j "-1)(%5)\n\t"
+
+/*! \brief Завершение шага приведения: сдвиг слов t[n], t[n+1] с прибавлением переносов. */
+ #define ak_mpzn_adx_last( n, ph )                                                             \
+    "movq 8*" #n "(%5), %3\n\t"                                                                \
+    "adcxq %4, %3\n\t"                                                                         \
+    "adoxq " ph ", %3\n\t"                                                                     \
+    "movq %3, 8*(" #n "-1)(%5)\n\t"                                                            \
+    "movq 8*(" #n "+1)(%5), %3\n\t"                                                            \
+    "adcxq %4, %3\n\t"                                                                         \
+    "adoxq %4, %3\n\t"                                                                         \
+    "movq %3, 8*" #n "(%5)\n\t"
+
+/*! \brief Вычисление одной строки метода CIOS для слова x[i]. */
+ #define ak_mpzn_adx_row( i, code )                                                            \
+ do {                                                                                          \
+    ak_uint64 __lo, __h0, __h1, __acc, __zero;                                                 \
+    __asm__ __volatile__( code                                                                 \
+      : "=&r" (__lo), "=&r" (__h0), "=&r" (__h1), "=&r" (__acc), "=&r" (__zero)                \
+      : "r" (t), "r" (y), "r" (p), "rm" (x[i]), "rm" (n0)                                      \
+      : "rdx", "cc", "memory" );                                                               \
+ } while(0)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка поддержки процессором инструкций MULX, ADCX и ADOX.
+    \details Проверка выполняется один раз, при первом вызове функции.
+    @return Функция возвращает \ref ak_true, если инструкции поддерживаются.                      */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_mpzn_adx_is_available( void )
+{
+  static int supported = -1;
+
+  if( supported < 0 ) {
+    __builtin_cpu_init();
+    supported = ( __builtin_cpu_supports( "bmi2" ) && __builtin_cpu_supports( "adx" )) ? 1 : 0;
+  }
+ return supported ? ak_true : ak_false;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение Монтгомери для модулей длины 256 бит с использованием инструкций
+    MULX, ADCX и ADOX. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_mul_montgomery_adx_256( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                                     ak_uint64 *p, ak_uint64 n0 )
+{
+  ak_uint64 t[ak_mpzn256_size+2] = { 0, 0, 0, 0, 0, 0 };
+
+ #define ak_mpzn_adx_code_256                                                                   \
+    ak_mpzn_adx_begin                                                                           \
+    ak_mpzn_adx_mul( 0, "%1", "%4" ) ak_mpzn_adx_mul( 1, "%2", "%1" )                           \
+    ak_mpzn_adx_mul( 2, "%1", "%2" ) ak_mpzn_adx_mul( 3, "%2", "%1" )                           \
+    ak_mpzn_adx_top( 4, "%2" )                                                                  \
+    ak_mpzn_adx_red( 1, "%2", "%1" ) ak_mpzn_adx_red( 2, "%1", "%2" )                           \
+    ak_mpzn_adx_red( 3, "%2", "%1" )                                                            \
+    ak_mpzn_adx_last( 4, "%2" )
+
+  ak_mpzn_adx_row( 0, ak_mpzn_adx_code_256 );
+  ak_mpzn_adx_row( 1, ak_mpzn_adx_code_256 );
+  ak_mpzn_adx_row( 2, ak_mpzn_adx_code_256 );
+  ak_mpzn_adx_row( 3, ak_mpzn_adx_code_256 );
+ #undef ak_mpzn_adx_code_256
+
+  ak_mpzn_cios_final( z, t, p, ak_mpzn256_size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение Монтгомери для модулей длины 512 бит с использованием инструкций
+    MULX, ADCX и ADOX. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_mul_montgomery_adx_512( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                                     ak_uint64 *p, ak_uint64 n0 )
+{
+  ak_uint64 t[ak_mpzn512_size+2] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+ #define ak_mpzn_adx_code_512                                                                   \
+    ak_mpzn_adx_begin                                                                           \
+    ak_mpzn_adx_mul( 0, "%1", "%4" ) ak_mpzn_adx_mul( 1, "%2", "%1" )                           \
+    ak_mpzn_adx_mul( 2, "%1", "%2" ) ak_mpzn_adx_mul( 3, "%2", "%1" )                           \
+    ak_mpzn_adx_mul( 4, "%1", "%2" ) ak_mpzn_adx_mul( 5, "%2", "%1" )                           \
+    ak_mpzn_adx_mul( 6, "%1", "%2" ) ak_mpzn_adx_mul( 7, "%2", "%1" )                           \
+    ak_mpzn_adx_top( 8, "%2" )                                                                  \
+    ak_mpzn_adx_red( 1, "%2", "%1" ) ak_mpzn_adx_red( 2, "%1", "%2" )                           \
+    ak_mpzn_adx_red( 3, "%2", "%1" ) ak_mpzn_adx_red( 4, "%1", "%2" )                           \
+    ak_mpzn_adx_red( 5, "%2", "%1" ) ak_mpzn_adx_red( 6, "%1", "%2" )                           \
+    ak_mpzn_adx_red( 7, "%2", "%1" )                                                            \
+    ak_mpzn_adx_last( 8, "%2" )
+
+  ak_mpzn_adx_row( 0, ak_mpzn_adx_code_512 );
+  ak_mpzn_adx_row( 1, ak_mpzn_adx_code_512 );
+  ak_mpzn_adx_row( 2, ak_mpzn_adx_code_512 );
+  ak_mpzn_adx_row( 3, ak_mpzn_adx_code_512 );
+  ak_mpzn_adx_row( 4, ak_mpzn_adx_code_512 );
+  ak_mpzn_adx_row( 5, ak_mpzn_adx_code_512 );
+  ak_mpzn_adx_row( 6, ak_mpzn_adx_code_512 );
+  ak_mpzn_adx_row( 7, ak_mpzn_adx_code_512 );
+ #undef ak_mpzn_adx_code_512
+
+  ak_mpzn_cios_final( z, t, p, ak_mpzn512_size );
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция реализует умножение Монтгомери для модулей длины 256 бит и вычисляет то же значение,
+    что и функция ak_mpzn_mul_montgomery() при `size` равном \ref ak_mpzn256_size.
+    Все циклы функции развернуты, а вычисление произведения совмещено с приведением по модулю.
+    Если процессор поддерживает инструкции MULX, ADCX и ADOX, то вычисления выполняются с их
+    использованием (выбор реализации производится во время выполнения программы).
+    Указатель на z может совпадать с одним из указателей на перемножаемые вычеты.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Левый аргумент операции умножения
+    @param y Правый аргумент операции умножения
+    @param p Модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в вычислениях. Представляет собой младшее слово
+    числа n, удовлетворяющего равенству \f$ rs - np = 1\f$.                                        */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_mul_montgomery_256( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                                     ak_uint64 *p, ak_uint64 n0 )
+{
+  ak_uint64 c, m, t[ak_mpzn256_size+2] = { 0, 0, 0, 0, 0, 0 };
+
+#ifdef LIBAKRYPT_HAVE_BUILTIN_MULX_ADX
+  if( ak_mpzn_adx_is_available()) {
+    ak_mpzn_mul_montgomery_adx_256( z, x, y, p, n0 );
+    return;
+  }
+#endif
+
+ #define ak_mpzn_cios_row_256( i )                                                               \
+    c = 0;                                                                                      \
+    ak_mpzn_cios_mac( t[0], c, x[i], y[0] ); ak_mpzn_cios_mac( t[1], c, x[i], y[1] );           \
+    ak_mpzn_cios_mac( t[2], c, x[i], y[2] ); ak_mpzn_cios_mac( t[3], c, x[i], y[3] );           \
+    ak_mpzn_cios_top( t, c, 4 );                                                                \
+    ak_mpzn_cios_first( t, c, m, p, n0 );                                                       \
+    ak_mpzn_cios_red( t, 1, c, m, p ); ak_mpzn_cios_red( t, 2, c, m, p );                       \
+    ak_mpzn_cios_red( t, 3, c, m, p );                                                          \
+    ak_mpzn_cios_last( t, c, 4 );
+
+  ak_mpzn_cios_row_256( 0 );
+  ak_mpzn_cios_row_256( 1 );
+  ak_mpzn_cios_row_256( 2 );
+  ak_mpzn_cios_row_256( 3 );
+ #undef ak_mpzn_cios_row_256
+
+  ak_mpzn_cios_final( z, t, p, ak_mpzn256_size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция реализует умножение Монтгомери для модулей длины 512 бит и вычисляет то же значение,
+    что и функция ak_mpzn_mul_montgomery() при `size` равном \ref ak_mpzn512_size.
+    Все циклы функции развернуты, а вычисление произведения совмещено с приведением по модулю.
+    Если процессор поддерживает инструкции MULX, ADCX и ADOX, то вычисления выполняются с их
+    использованием (выбор реализации производится во время выполнения программы).
+    Указатель на z может совпадать с одним из указателей на перемножаемые вычеты.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Левый аргумент операции умножения
+    @param y Правый аргумент операции умножения
+    @param p Модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в вычислениях. Представляет собой младшее слово
+    числа n, удовлетворяющего равенству \f$ rs - np = 1\f$.                                        */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_mul_montgomery_512( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                                     ak_uint64 *p, ak_uint64 n0 )
+{
+  ak_uint64 c, m, t[ak_mpzn512_size+2] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+#ifdef LIBAKRYPT_HAVE_BUILTIN_MULX_ADX
+  if( ak_mpzn_adx_is_available()) {
+    ak_mpzn_mul_montgomery_adx_512( z, x, y, p, n0 );
+    return;
+  }
+#endif
+
+ #define ak_mpzn_cios_row_512( i )                                                               \
+    c = 0;                                                                                      \
+    ak_mpzn_cios_mac( t[0], c, x[i], y[0] ); ak_mpzn_cios_mac( t[1], c, x[i], y[1] );           \
+    ak_mpzn_cios_mac( t[2], c, x[i], y[2] ); ak_mpzn_cios_mac( t[3], c, x[i], y[3] );           \
+    ak_mpzn_cios_mac( t[4], c, x[i], y[4] ); ak_mpzn_cios_mac( t[5], c, x[i], y[5] );           \
+    ak_mpzn_cios_mac( t[6], c, x[i], y[6] ); ak_mpzn_cios_mac( t[7], c, x[i], y[7] );           \
+    ak_mpzn_cios_top( t, c, 8 );                                                                \
+    ak_mpzn_cios_first( t, c, m, p, n0 );                                                       \
+    ak_mpzn_cios_red( t, 1, c, m, p ); ak_mpzn_cios_red( t, 2, c, m, p );                       \
+    ak_mpzn_cios_red( t, 3, c, m, p ); ak_mpzn_cios_red( t, 4, c, m, p );                       \
+    ak_mpzn_cios_red( t, 5, c, m, p ); ak_mpzn_cios_red( t, 6, c, m, p );                       \
+    ak_mpzn_cios_red( t, 7, c, m, p );                                                          \
+    ak_mpzn_cios_last( t, c, 8 );
+
+  ak_mpzn_cios_row_512( 0 );
+  ak_mpzn_cios_row_512( 1 );
+  ak_mpzn_cios_row_512( 2 );
+  ak_mpzn_cios_row_512( 3 );
+  ak_mpzn_cios_row_512( 4 );
+  ak_mpzn_cios_row_512( 5 );
+  ak_mpzn_cios_row_512( 6 );
+  ak_mpzn_cios_row_512( 7 );
+ #undef ak_mpzn_cios_row_512
+
+  ak_mpzn_cios_final( z, t, p, ak_mpzn512_size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Возведение в квадрат с последующим приведением по модулю (метод SOS).
+
+    Произведения \f$ x_ix_j \f$ при \f$ i \neq j \f$ вычисляются один раз, после чего их сумма
+    удваивается сдвигом и к ней прибавляются квадраты слов \f$ x_i^2 \f$. Тем самым количество
+    умножений слов сокращается с \f$ n^2 \f$ до \f$ n(n+1)/2 \f$. Приведение по модулю
+    выполняется так же, как в функции ak_mpzn_mul_montgomery().
+
+    При вызове с константным значением `size` компилятор полностью разворачивает циклы функции. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_mpzn_sqr_montgomery_sos( ak_uint64 *z, ak_uint64 *x,
+                                                   ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  size_t i = 0, j = 0;
+  ak_uint64 c = 0, m = 0;
+  ak_mpznmax t = ak_mpznmax_zero;
+
+ /* вычисляем сумму попарных произведений x_i*x_j, i < j */
+  for( i = 0; i < size; i++ ) {
+     for( j = i+1, c = 0; j < size; j++ ) ak_mpzn_cios_mac( t[i+j], c, x[i], x[j] );
+     t[i+size] = c;
+  }
+
+ /* удваиваем полученную сумму */
+  for( i = 2*size-1; i > 0; i-- ) t[i] = ( t[i] << 1 )|( t[i-1] >> 63 );
+  t[0] <<= 1;
+
+ /* прибавляем квадраты слов */
+  for( i = 0, c = 0; i < size; i++ ) {
+     ak_uint64 w1, w0, cy;
+     umul_ppmm( w1, w0, x[i], x[i] );
+     t[2*i] += w0;
+     cy = t[2*i] < w0;
+     t[2*i] += c;
+     cy += t[2*i] < c;
+     t[2*i+1] += w1;
+     c = t[2*i+1] < w1;
+     t[2*i+1] += cy;
+     c += t[2*i+1] < cy;
+  }
+
+ /* приводим по модулю */
+  for( i = 0; i < size; i++ ) {
+     m = t[i]*n0;
+     for( j = 0, c = 0; j < size; j++ ) ak_mpzn_cios_mac( t[i+j], c, m, p[j] );
+     j = i+size;
+     do {
+         t[j] += c;
+         c = t[j] < c;
+         j++;
+     } while( c != 0 );
+  }
+  ak_mpzn_cios_final( z, t+size, p, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция возводит в квадрат вычет x, заданный в представлении Монтгомери, то есть для
+    \f$ x \equiv x_0r \pmod{p} \f$ вычисляет значение, удовлетворяющее сравнению
+    \f$ z \equiv x_0^2r \pmod{p}\f$. Функция вычисляет то же значение, что и вызов
+    ak_mpzn_mul_montgomery( z, x, x, p, n0, size ), однако использует примерно на треть
+    меньше умножений машинных слов. Указатель на z может совпадать с указателем на x.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Вычет, который возводится в квадрат
+    @param p Модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в вычислениях. Представляет собой младшее слово
+    числа n, удовлетворяющего равенству \f$ rs - np = 1\f$.
+    @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size или
+                                                                          \ref ak_mpzn512_size).   */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_sqr_montgomery( ak_uint64 *z, ak_uint64 *x,
+                                                   ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  ak_mpzn_sqr_montgomery_sos( z, x, p, n0, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выбор реализации возведения в квадрат в зависимости от длины модуля.
+
+    Для модулей длины 256 и 512 бит используются развернутые реализации умножения Монтгомери:
+    они выполняются быстрее, чем возведение в квадрат методом SOS, поскольку экономия умножений
+    слов не окупает отдельного прохода приведения по модулю с распространением переносов.      */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_mpzn_sqr_montgomery_size( ak_uint64 *z, ak_uint64 *x,
+                                                   ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  switch( size ) {
+    case ak_mpzn256_size: ak_mpzn_mul_montgomery_256( z, x, x, p, n0 );
+                          break;
+    case ak_mpzn512_size: ak_mpzn_mul_montgomery_512( z, x, x, p, n0 );
+                          break;
+    default: ak_mpzn_sqr_montgomery( z, x, p, n0, size );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выбор реализации умножения Монтгомери в зависимости от длины модуля.                   */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_mpzn_mul_montgomery_size( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                   ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  switch( size ) {
+    case ak_mpzn256_size: ak_mpzn_mul_montgomery_256( z, x, y, p, n0 );
+                          break;
+    case ak_mpzn512_size: ak_mpzn_mul_montgomery_512( z, x, y, p, n0 );
+                          break;
+    default: ak_mpzn_mul_montgomery( z, x, y, p, n0, size );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычитает из вычета x вычет y и приводит полученную разность по модулю p, то есть
+    вычисляет значение сравнения \f$ z \equiv x - y \pmod{p}\f$. Результат помещается
+    в переменную z. Указатель на z может совпадать с одним из указателей на аргументы.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Уменьшаемое
+    @param y Вычитаемое
+    @param p Модуль, по которому производится операция вычитания
+    @param size Размер модуля в словах (значение константы ak_mpzn256_size или ak_mpzn512_size )   */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_sub_montgomery( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                                ak_uint64 *p, const size_t size )
+{
+  size_t i = 0;
+  ak_uint64 av = 0, bv = 0, cy = 0, mask = 0;
+
+ // сначала вычитаем: (x - y) -> z
+  for( i = 0; i < size; i++ ) {
+     av = x[i];
+     bv = av - cy;
+     cy = bv > av;
+     av = bv - y[i];
+     cy += av > bv;
+     z[i] = av;
+  }
+ // потом, если возник заем, прибавляем модуль: (z + p) -> z
+  mask = 0 - cy; cy = 0;
+  for( i = 0; i < size; i++ ) {
+     av = p[i]&mask;
+     bv = z[i] + cy;
+     cy = bv < cy;
+     bv += av;
+     cy += bv < av;
+     z[i] = bv;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* Арифметика по модулям специального вида \f$ p = 2^{64n} - c \f$, где \f$ 0 < c < 2^{64}\f$      */
+/* (псевдо-мерсенновы простые числа).                                                              */
+/*                                                                                                 */
+/* Вычеты хранятся в том же представлении Монтгомери, что и для произвольных модулей, однако       */
+/* для таких модулей выполнено \f$ p \equiv -c \pmod{2^{64}} \f$ и \f$ mp = m2^{64n} - mc \f$.     */
+/* Поэтому каждый шаг приведения требует лишь одного умножения слов \f$ mc \f$ вместо \f$ n \f$,   */
+/* а сложение с модулем заменяется вычитанием однословной константы \f$ c \f$.                     */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Приведение Монтгомери произведения t длины 2*size+1 слов по модулю вида 2^{64size} - c. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_mpzn_redc_pm( ak_uint64 *z, ak_uint64 *t,
+                                                   ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  size_t i = 0;
+  ak_uint64 c = 0 - p[0], av = 0, bv = 0, cy = 0, hi = 0, lo = 0;
+  ak_mpznmax m;
+
+ /* обрабатываем младшую половину: на i-м шаге из слова t[i] вычитается старшее слово
+    произведения, полученного на предыдущем шаге, а само слово обнуляется добавлением m_i*p */
+  for( i = 0; i < size; i++ ) {
+     av = t[i];
+     bv = av - cy;
+     cy = bv > av;
+     av = bv - hi;
+     cy += av > bv;
+     m[i] = av*n0;
+     umul_ppmm( hi, lo, m[i], c ); /* младшее слово произведения совпадает с av */
+     (void) lo;
+  }
+
+ /* прибавляем к старшей половине сумму m_i2^{64i} и вычитаем оставшийся заем */
+  bv = cy; cy = 0;
+  for( i = 0; i < size; i++ ) {
+     av = t[i+size] + cy;
+     cy = av < cy;
+     av += m[i];
+     cy += av < m[i];
+     t[i+size] = av;
+  }
+  t[2*size] += cy;
+
+  cy = bv;
+  for( i = size; i <= 2*size; i++ ) {
+     av = t[i];
+     bv = av - cy;
+     cy = bv > av;
+     av = bv - hi;
+     cy += av > bv;
+     t[i] = av;
+     hi = 0;
+  }
+  ak_mpzn_cios_final( z, t+size, p, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение и приведение по модулю вида 2^{64size} - c для фиксированного размера.     */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_mpzn_mul_montgomery_pm_size( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                   ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  size_t i = 0, j = 0;
+  ak_mpznmax t = ak_mpznmax_zero;
+
+  for( i = 0; i < size; i++ ) {
+     ak_uint64 c = 0;
+     for( j = 0; j < size; j++ ) ak_mpzn_cios_mac( t[i+j], c, x[i], y[j] );
+     t[i+size] = c;
+  }
+  ak_mpzn_redc_pm( z, t, p, n0, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Возведение в квадрат и приведение по модулю вида 2^{64size} - c.                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_mpzn_sqr_montgomery_pm_size( ak_uint64 *z, ak_uint64 *x,
+                                                   ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  size_t i = 0, j = 0;
+  ak_uint64 c = 0;
+  ak_mpznmax t = ak_mpznmax_zero;
+
+  for( i = 0; i < size; i++ ) {
+     for( j = i+1, c = 0; j < size; j++ ) ak_mpzn_cios_mac( t[i+j], c, x[i], x[j] );
+     t[i+size] = c;
+  }
+  for( i = 2*size-1; i > 0; i-- ) t[i] = ( t[i] << 1 )|( t[i-1] >> 63 );
+  t[0] <<= 1;
+  for( i = 0, c = 0; i < size; i++ ) {
+     ak_uint64 w1, w0, cy;
+     umul_ppmm( w1, w0, x[i], x[i] );
+     t[2*i] += w0;
+     cy = t[2*i] < w0;
+     t[2*i] += c;
+     cy += t[2*i] < c;
+     t[2*i+1] += w1;
+     c = t[2*i+1] < w1;
+     t[2*i+1] += cy;
+     c += t[2*i+1] < cy;
+  }
+  ak_mpzn_redc_pm( z, t, p, n0, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет то же значение, что и функция ak_mpzn_mul_montgomery(), однако
+    предполагает, что модуль имеет вид \f$ p = 2^{64\cdot size} - c \f$, где \f$ 0 < c < 2^{64}\f$.
+    Для модулей другого вида функция возвращает неверный результат.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Левый аргумент операции умножения
+    @param y Правый аргумент операции умножения
+    @param p Модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в вычислениях. Представляет собой младшее слово
+    числа n, удовлетворяющего равенству \f$ rs - np = 1\f$.
+    @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size или
+                                                                          \ref ak_mpzn512_size).   */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_mul_montgomery_pm( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                   ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  switch( size ) {
+    case ak_mpzn256_size: ak_mpzn_mul_montgomery_pm_size( z, x, y, p, n0, ak_mpzn256_size );
+                          break;
+    case ak_mpzn512_size: ak_mpzn_mul_montgomery_pm_size( z, x, y, p, n0, ak_mpzn512_size );
+                          break;
+    default: ak_mpzn_mul_montgomery_pm_size( z, x, y, p, n0, size );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет то же значение, что и функция ak_mpzn_sqr_montgomery(), однако
+    предполагает, что модуль имеет вид \f$ p = 2^{64\cdot size} - c \f$, где \f$ 0 < c < 2^{64}\f$.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Вычет, который возводится в квадрат
+    @param p Модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в вычислениях.
+    @param size Размер модуля в словах.                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_sqr_montgomery_pm( ak_uint64 *z, ak_uint64 *x,
+                                                   ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  switch( size ) {
+    case ak_mpzn256_size: ak_mpzn_sqr_montgomery_pm_size( z, x, p, n0, ak_mpzn256_size );
+                          break;
+    case ak_mpzn512_size: ak_mpzn_sqr_montgomery_pm_size( z, x, p, n0, ak_mpzn512_size );
+                          break;
+    default: ak_mpzn_sqr_montgomery_pm_size( z, x, p, n0, size );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет то же значение, что и функция ak_mpzn_add_montgomery(), для модуля
+    вида \f$ p = 2^{64\cdot size} - c \f$. Вместо вычитания модуля к сумме прибавляется
+    величина \f$ c \f$; выбор результата выполняется без ветвлений.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Левый аргумент операции сложения
+    @param y Правый аргумент операции сложения
+    @param p Модуль, по которому производится операция сложения
+    @param size Размер модуля в словах.                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_add_pm( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y, ak_uint64 *p, const size_t size )
+{
+  size_t i = 0;
+  ak_uint64 av = 0, bv = 0, cy = 0, cw = 0, mask = 0, c = 0 - p[0];
+  ak_mpznmax s, w;
+
+  for( i = 0; i < size; i++ ) {
+     av = x[i]; bv = y[i];
+     bv += cy;
+     cy = bv < cy;
+     bv += av;
+     cy += bv < av;
+     s[i] = bv;
+  }
+  for( i = 0; i < size; i++ ) {
+     av = s[i] + c;
+     cw = av < c;
+     w[i] = av;
+     c = cw;
+  }
+ /* результатом является s+c, если сумма x+y не меньше 2^{64size}, либо не меньше p */
+  mask = 0 - ( cy|cw );
+  for( i = 0; i < size; i++ ) z[i] = ( w[i]&mask )|( s[i]&~mask );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет то же значение, что и функция ak_mpzn_sub_montgomery(), для модуля
+    вида \f$ p = 2^{64\cdot size} - c \f$. При возникновении заема из разности вычитается
+    величина \f$ c \f$.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Уменьшаемое
+    @param y Вычитаемое
+    @param p Модуль, по которому производится операция вычитания
+    @param size Размер модуля в словах.                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_sub_pm( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y, ak_uint64 *p, const size_t size )
+{
+  size_t i = 0;
+  ak_uint64 av = 0, bv = 0, cy = 0, c = 0 - p[0];
+
+  for( i = 0; i < size; i++ ) {
+     av = x[i];
+     bv = av - cy;
+     cy = bv > av;
+     av = bv - y[i];
+     cy += av > bv;
+     z[i] = av;
+  }
+  c &= 0 - cy; cy = 0;
+  for( i = 0; i < size; i++ ) {
+     av = z[i];
+     bv = av - cy;
+     cy = bv > av;
+     av = bv - c;
+     cy += av > bv;
+     z[i] = av;
+     c = 0;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция проверяет, что модуль имеет вид \f$ p = 2^{64\cdot size} - c \f$,
+    где \f$ 0 < c < 2^{64}\f$, то есть для вычислений по этому модулю могут быть использованы
+    функции ak_mpzn_mul_montgomery_pm(), ak_mpzn_sqr_montgomery_pm(), ak_mpzn_add_pm()
+    и ak_mpzn_sub_pm().
+
+    @param p Модуль
+    @param size Размер модуля в словах.
+    @return Функция возвращает \ref ak_true, если модуль имеет указанный вид.
+    В противном случае возвращается \ref ak_false.                                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_mpzn_is_pseudo_mersenne( ak_uint64 *p, const size_t size )
+{
+  size_t i = 0;
+  if( size < 2 ) return ak_false;
+  if( p[0] == 0 ) return ak_false;
+  for( i = 1; i < size; i++ ) if( p[i] != 0xFFFFFFFFFFFFFFFFLL ) return ak_false;
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Максимальная ширина окна при возведении в степень со скользящим окном. */
+ #define ak_mpzn_modpow_window_max    (5)
+
+/*! \brief Значение бита с номером i вычета k. */
+ #define ak_mpzn_bit( k, i )     ((( k )[( i ) >> 6] >> (( i )&0x3F ))&0x1 )
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Для вычета \f$ x \f$, заданного в представлении Монтгомери в виде \f$ xr \f$, где \f$ r \f$
     заданная степень двойки, вычисляется вычет \f$ z \f$,
     удовлетворяющий сравнению \f$z \equiv (x^k)r \pmod{p}\f$.
-    Результат \f$ z \f$  является значением вычета \f$ x^k \pmod{p}\f$ в представлении Монтгомери.
     Величины \f$ k \f$  и \f$ p \f$ задаются как обычные вычеты и \f$ p \f$  отлично от нуля.
 
+    Функция использует метод скользящего окна: вычисляются нечетные степени
+    \f$ x, x^3, \ldots, x^{2^w-1} \f$, после чего степень просматривается от старших разрядов
+    к младшим, а каждая последовательность из не более чем \f$ w \f$ разрядов, начинающаяся
+    и заканчивающаяся единицей, обрабатывается одним умножением. Ширина окна \f$ w \leq 5 \f$
+    выбирается в зависимости от длины степени; старшие нулевые разряды степени пропускаются.
+
+    Время работы функции зависит от значения степени, поэтому функция должна применяться
+    только к открытым значениям (например, к показателям \f$ p-1 \f$ или \f$ q-1 \f$
+    при проверке параметров эллиптической кривой). Возведение в секретные степени в библиотеке
+    не используется: обращение вычетов выполняется за постоянное время функцией ak_mpzn_inverse().
+
     @param z Вычет, в который помещается результат
     @param x Вычет, который возводится в степень \f$ k \f$
-    @param k Степень, в которую возводится вычет \f$ x \f$
+    @param k Открытое значение степени, в которую возводится вычет \f$ x \f$
     @param p Модуль, по которому производятся вычисления
     @param n0 Константа, используемая в вычислениях. Представляет собой младшее слово числа n,
     удовлетворяющего равенству \f$ rs - np = 1\f$.
     @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size
     или \ref ak_mpzn512_size )                                                                     */
 /* ----------------------------------------------------------------------------------------------- */
- void ak_mpzn_modpow_montgomery( ak_uint64 *z, ak_uint64 *x, ak_uint64 *k,
+ void ak_mpzn_modpow_montgomery_vartime( ak_uint64 *z, ak_uint64 *x, ak_uint64 *k,
                                                    ak_uint64 *p, ak_uint64 n0, const size_t size )
 {
-  ak_uint64 uk = 0;
-  size_t s = size-1;
-  long long int i, j;
-  ak_mpznmax res = ak_mpznmax_zero; // это константа r (mod p) = r-p
+  bool_t first = ak_true;
+  size_t bits = 64*size, w = 1, i, j, l, value;
+  ak_mpznmax res = ak_mpznmax_zero, x2, table[1 << ( ak_mpzn_modpow_window_max - 1 )];
+
   if( ak_mpzn_sub( res, res, p, size ) == 0 ) {
-    ak_error_message( ak_error_undefined_value,
-                                          "using an unexpected value of prime modulo", __func__ );
+    ak_error_message( ak_error_undefined_value, __func__,
+                                                      "using an unexpected value of prime modulo" );
+    return;
+  }
+  while(( bits > 0 ) && ( ak_mpzn_bit( k, bits-1 ) == 0 )) bits--;
+  if( bits == 0 ) {
+    ak_mpzn_set( z, res, size );
     return;
   }
-  while( k[s] == 0 ) {
-     if( s > 0 ) --s;
-      else {
-             ak_mpzn_set( z, res, size );
-             return;
-           }
-  }
-  for( i = s; i >= 0; i-- ) {
-     uk = k[i];
-     for( j = 0; j < 64; j++ ) {
-        ak_mpzn_mul_montgomery( res, res, res, p, n0, size );
-        if( uk&0x8000000000000000LL ) ak_mpzn_mul_montgomery( res, res, x, p, n0, size );
-        uk <<= 1;
+
+ /* выбираем ширину окна и вычисляем нечетные степени x^{2j+1} */
+  if( bits > 240 ) w = 5;
+   else if( bits > 80 ) w = 4;
+    else if( bits > 24 ) w = 3;
+  ak_mpzn_set( table[0], x, size );
+  if( w > 1 ) {
+    ak_mpzn_sqr_montgomery_size( x2, x, p, n0, size );
+    for( j = 1; j < ( (size_t)1 << ( w-1 )); j++ )
+       ak_mpzn_mul_montgomery_size( table[j], table[j-1], x2, p, n0, size );
+  }
+
+  for( i = bits; i > 0; ) {
+     if( ak_mpzn_bit( k, i-1 ) == 0 ) {
+       ak_mpzn_sqr_montgomery_size( res, res, p, n0, size );
+       i--;
+       continue;
      }
+    /* ищем окно [j, i-1], младший разряд которого равен единице */
+     j = ( i > w ) ? i - w : 0;
+     while( ak_mpzn_bit( k, j ) == 0 ) j++;
+     for( value = 0, l = i; l > j; l-- ) value = ( value << 1 )^ak_mpzn_bit( k, l-1 );
+
+     if( first ) {
+       ak_mpzn_set( res, table[value >> 1], size );
+       first = ak_false;
+     } else {
+         for( l = i; l > j; l-- ) ak_mpzn_sqr_montgomery_size( res, res, p, n0, size );
+         ak_mpzn_mul_montgomery_size( res, res, table[value >> 1], p, n0, size );
+       }
+     i = j;
   }
   memcpy( z, res, size*sizeof( ak_uint64 ));
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                     обращение вычетов методом Бернштейна-Янга (safegcd)                        */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество шагов алгоритма, выполняемых над младшими словами за одну итерацию. */
+ #define ak_mpzn_divsteps_count     (62)
+/*! \brief Маска для выделения младших 62-х бит слова. */
+ #define ak_mpzn_divsteps_mask      (0x3FFFFFFFFFFFFFFFLL)
+/*! \brief Максимальное количество 62-х битных слов в представлении знаковых вычетов. */
+ #define ak_mpzn_signed62_size      ( ak_mpznmax_size + 2 )
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Знаковое произведение двух 64-х битных слов прибавляется к 128-ми битному
+    аккумулятору (hi, lo), хранящему значение в дополнительном коде.                             */
+/* ----------------------------------------------------------------------------------------------- */
+ #define ak_mpzn_smul_add( hi, lo, a, b )                                          \
+ do {                                                                              \
+    ak_uint64 __w0, __w1, __a = (a), __b = (b);                                    \
+    umul_ppmm( __w1, __w0, __a, __b );                                             \
+    __w1 -= ( __b&( (ak_uint64)0 - ( __a >> 63 ))) + ( __a&( (ak_uint64)0 - ( __b >> 63 ))); \
+    (lo) += __w0;                                                                  \
+    (hi) += __w1 + ( (lo) < __w0 );                                                \
+ } while(0)
+
+/*! \brief Арифметический сдвиг вправо на 62 разряда 64-х битного знакового слова. */
+ #define ak_mpzn_sar62( x ) \
+                        ((( x ) >> 62 )^(( (ak_uint64)0 - (( x ) >> 63 )) << 2 ))
+
+/*! \brief Арифметический сдвиг вправо на 62 разряда 128-ми битного аккумулятора (hi, lo). */
+ #define ak_mpzn_sar62_128( hi, lo )                                               \
+ do {                                                                              \
+    (lo) = ( (lo) >> 62 )^( (hi) << 2 );                                           \
+    (hi) = ak_mpzn_sar62( hi );                                                    \
+ } while(0)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция выполняет 62 шага алгоритма (divstep) над младшими словами \f$ f_0, g_0 \f$
+    и вычисляет матрицу перехода \f$ t = (u, v, q, r) \f$, удовлетворяющую равенствам
+    \f$ 2^{62}f' = uf + vg \f$ и \f$ 2^{62}g' = qf + rg \f$.
+
+    Все вычисления выполняются без ветвлений, зависящих от обрабатываемых данных.
+    Величина \f$ \eta = -\delta \f$ хранится в дополнительном коде.
+
+    @return Функция возвращает новое значение величины \f$ \eta \f$.                               */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_uint64 ak_mpzn_divsteps( ak_uint64 eta, ak_uint64 f, ak_uint64 g, ak_uint64 *t )
+{
+  int i = 0;
+  ak_uint64 u = 1, v = 0, q = 0, r = 1, c1, c2, x, y, z;
+
+  for( i = 0; i < ak_mpzn_divsteps_count; i++ ) {
+    /* c1 - маска условия delta > 0, c2 - маска нечетности g */
+     c1 = (ak_uint64)0 - ( eta >> 63 );
+     c2 = (ak_uint64)0 - ( g&0x1 );
+     x = ( f^c1 ) - c1;
+     y = ( u^c1 ) - c1;
+     z = ( v^c1 ) - c1;
+     g += x&c2; q += y&c2; r += z&c2;
+    /* c1 - маска условия обмена значений f и g */
+     c1 &= c2;
+     eta = ( eta^c1 ) - ( c1+1 );
+     f += g&c1; u += q&c1; v += r&c1;
+     g >>= 1; u <<= 1; v <<= 1;
+  }
+  t[0] = u; t[1] = v; t[2] = q; t[3] = r;
+ return eta;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет \f$ (f, g) \leftarrow t(f, g)/2^{62} \f$ (деление нацело).          */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_update_fg( ak_uint64 *f, ak_uint64 *g, ak_uint64 *t, const size_t n )
+{
+  size_t i = 0;
+  ak_uint64 cfh = 0, cfl = 0, cgh = 0, cgl = 0;
+
+  ak_mpzn_smul_add( cfh, cfl, t[0], f[0] ); ak_mpzn_smul_add( cfh, cfl, t[1], g[0] );
+  ak_mpzn_smul_add( cgh, cgl, t[2], f[0] ); ak_mpzn_smul_add( cgh, cgl, t[3], g[0] );
+  ak_mpzn_sar62_128( cfh, cfl ); ak_mpzn_sar62_128( cgh, cgl );
+  for( i = 1; i < n; i++ ) {
+     ak_mpzn_smul_add( cfh, cfl, t[0], f[i] ); ak_mpzn_smul_add( cfh, cfl, t[1], g[i] );
+     ak_mpzn_smul_add( cgh, cgl, t[2], f[i] ); ak_mpzn_smul_add( cgh, cgl, t[3], g[i] );
+     f[i-1] = cfl&ak_mpzn_divsteps_mask; g[i-1] = cgl&ak_mpzn_divsteps_mask;
+     ak_mpzn_sar62_128( cfh, cfl ); ak_mpzn_sar62_128( cgh, cgl );
+  }
+  f[n-1] = cfl; g[n-1] = cgl;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет \f$ (d, e) \leftarrow t(d, e)/2^{62} \pmod{p} \f$.
+    \details К произведению прибавляются кратные модуля, обнуляющие младшие 62 бита результата,
+    что позволяет выполнить деление на \f$ 2^{62} \f$ сдвигом. Значения \f$ d, e \f$
+    остаются в интервале \f$ (-2p, p) \f$.                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_update_de( ak_uint64 *d, ak_uint64 *e, ak_uint64 *t,
+                                            ak_uint64 *p, ak_uint64 pinv, const size_t n )
+{
+  size_t i = 0;
+  ak_uint64 sd, se, md, me, cdh = 0, cdl = 0, ceh = 0, cel = 0;
+
+ /* для отрицательных d, e к результату дополнительно прибавляются (u,q)p и (v,r)p */
+  sd = (ak_uint64)0 - ( d[n-1] >> 63 );
+  se = (ak_uint64)0 - ( e[n-1] >> 63 );
+  md = ( t[0]&sd ) + ( t[1]&se );
+  me = ( t[2]&sd ) + ( t[3]&se );
+
+  ak_mpzn_smul_add( cdh, cdl, t[0], d[0] ); ak_mpzn_smul_add( cdh, cdl, t[1], e[0] );
+  ak_mpzn_smul_add( ceh, cel, t[2], d[0] ); ak_mpzn_smul_add( ceh, cel, t[3], e[0] );
+ /* выбираем md, me так, чтобы младшие 62 бита значений t(d,e) + p(md,me) были равны нулю */
+  md -= ( pinv*cdl + md )&ak_mpzn_divsteps_mask;
+  me -= ( pinv*cel + me )&ak_mpzn_divsteps_mask;
+  ak_mpzn_smul_add( cdh, cdl, p[0], md ); ak_mpzn_smul_add( ceh, cel, p[0], me );
+  ak_mpzn_sar62_128( cdh, cdl ); ak_mpzn_sar62_128( ceh, cel );
+
+  for( i = 1; i < n; i++ ) {
+     ak_mpzn_smul_add( cdh, cdl, t[0], d[i] ); ak_mpzn_smul_add( cdh, cdl, t[1], e[i] );
+     ak_mpzn_smul_add( cdh, cdl, p[i], md );
+     ak_mpzn_smul_add( ceh, cel, t[2], d[i] ); ak_mpzn_smul_add( ceh, cel, t[3], e[i] );
+     ak_mpzn_smul_add( ceh, cel, p[i], me );
+     d[i-1] = cdl&ak_mpzn_divsteps_mask; e[i-1] = cel&ak_mpzn_divsteps_mask;
+     ak_mpzn_sar62_128( cdh, cdl ); ak_mpzn_sar62_128( ceh, cel );
+  }
+  d[n-1] = cdl; e[n-1] = cel;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция приводит значение \f$ d \in (-2p, p) \f$, умноженное на знак \f$ s \f$,
+    к интервалу \f$ [0, p) \f$ без ветвлений, зависящих от обрабатываемых данных.              */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_normalize62( ak_uint64 *d, ak_uint64 s, ak_uint64 *p, const size_t n )
+{
+  size_t i = 0;
+  ak_uint64 cond = (ak_uint64)0 - ( d[n-1] >> 63 ), neg = (ak_uint64)0 - ( s >> 63 );
+
+  for( i = 0; i < n; i++ ) d[i] = (( d[i] + ( p[i]&cond ))^neg ) - neg;
+  for( i = 0; i < n-1; i++ ) {
+     d[i+1] += ak_mpzn_sar62( d[i] );
+     d[i] &= ak_mpzn_divsteps_mask;
+  }
+  cond = (ak_uint64)0 - ( d[n-1] >> 63 );
+  for( i = 0; i < n; i++ ) d[i] += p[i]&cond;
+  for( i = 0; i < n-1; i++ ) {
+     d[i+1] += ak_mpzn_sar62( d[i] );
+     d[i] &= ak_mpzn_divsteps_mask;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование вычета в последовательность 62-х битных слов. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_to_signed62( ak_uint64 *r, ak_uint64 *x, const size_t size, const size_t n )
+{
+  size_t i, w, s;
+
+  for( i = 0; i < n; i++ ) {
+     w = ( 62*i ) >> 6; s = ( 62*i )&0x3F;
+     r[i] = ( w < size ) ? x[w] >> s : 0;
+     if(( s > 2 ) && ( w+1 < size )) r[i] ^= x[w+1] << ( 64-s );
+     r[i] &= ak_mpzn_divsteps_mask;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование последовательности неотрицательных 62-х битных слов в вычет. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_from_signed62( ak_uint64 *x, ak_uint64 *r, const size_t size, const size_t n )
+{
+  size_t i, w, s;
+
+  memset( x, 0, size*sizeof( ak_uint64 ));
+  for( i = 0; i < n; i++ ) {
+     w = ( 62*i ) >> 6; s = ( 62*i )&0x3F;
+     if( w < size ) x[w] ^= r[i] << s;
+     if(( s > 2 ) && ( w+1 < size )) x[w+1] ^= r[i] >> ( 64-s );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для вычета \f$ x \f$, удовлетворяющего неравенству \f$ 0 \leq x < p\f$, функция вычисляет
+    вычет \f$ z \equiv x^{-1} \pmod{p} \f$. Вычисления выполняются методом Д. Бернштейна и Б. Янга
+    (safegcd, 2019): над значениями \f$ f = p \f$ и \f$ g = x \f$ выполняется фиксированное
+    количество шагов (divstep) бинарного алгоритма Евклида, при этом одновременно вычисляются
+    коэффициенты \f$ d, e \f$, удовлетворяющие сравнениям \f$ f \equiv dx, g \equiv ex \pmod{p}\f$.
+
+    Количество шагов зависит только от длины модуля (744 шага для модуля длины 256 бит и
+    1488 шагов для модуля длины 512 бит), а сами шаги выполняются без ветвлений, зависящих
+    от значения \f$ x \f$. Поэтому время работы функции не зависит от обращаемого вычета.
+    По сравнению с возведением в степень \f$ p-2 \f$ функция выполняет в несколько раз меньше
+    умножений машинных слов.
+
+    Если \f$ x = 0 \f$, то результат также равен нулю.
+
+    @param z Вычет, в который помещается результат
+    @param x Обращаемый вычет
+    @param p Нечетный модуль, по которому производятся вычисления
+    @param n0 Константа Монтгомери \f$ n_0 \equiv -p^{-1} \pmod{2^{64}} \f$;
+    используется для деления на степень двойки по модулю \f$ p \f$.
+    @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size
+    или \ref ak_mpzn512_size )                                                                     */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_inverse( ak_uint64 *z, ak_uint64 *x, ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  ak_uint64 t[4], eta = (ak_uint64)0 - 1, pinv = ( (ak_uint64)0 - n0 )&ak_mpzn_divsteps_mask;
+  ak_uint64 f[ak_mpzn_signed62_size], g[ak_mpzn_signed62_size], pp[ak_mpzn_signed62_size],
+            d[ak_mpzn_signed62_size], e[ak_mpzn_signed62_size];
+ /* количество 62-х битных слов и количество итераций, достаточное для модуля длины 64*size
+    бит: согласно оценке Бернштейна-Янга требуется не менее (49*bits + 57)/17 шагов */
+  size_t i = 0, n = ( 64*size )/62 + 1,
+         count = (( 49*64*size + 57 )/17 + ak_mpzn_divsteps_count )/ak_mpzn_divsteps_count;
+
+  ak_mpzn_to_signed62( pp, p, size, n );
+  ak_mpzn_to_signed62( g, x, size, n );
+  memcpy( f, pp, n*sizeof( ak_uint64 ));
+  memset( d, 0, n*sizeof( ak_uint64 ));
+  memset( e, 0, n*sizeof( ak_uint64 ));
+  e[0] = 1;
+
+  for( i = 0; i < count; i++ ) {
+     eta = ak_mpzn_divsteps( eta, f[0], g[0], t );
+     ak_mpzn_update_de( d, e, t, pp, pinv, n );
+     ak_mpzn_update_fg( f, g, t, n );
+  }
+
+ /* теперь f = \pm 1 и, следовательно, x^{-1} = \pm d */
+  ak_mpzn_normalize62( d, f[n-1], pp, n );
+  ak_mpzn_from_signed62( z, d, size, n );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для вычета \f$ x \f$, заданного в представлении Монтгомери в виде \f$ xr \f$, функция
+    вычисляет вычет \f$ z \equiv x^{-1}r \pmod{p} \f$, т.е. обратный вычет в представлении
+    Монтгомери. Результат совпадает с результатом возведения в степень \f$ p-2 \f$, но
+    вычисляется функцией ak_mpzn_inverse() и двумя умножениями в представлении Монтгомери.
+
+    @param z Вычет, в который помещается результат
+    @param x Обращаемый вычет в представлении Монтгомери
+    @param p Модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в вычислениях. Представляет собой младшее слово числа n,
+    удовлетворяющего равенству \f$ rs - np = 1\f$.
+    @param r2 Величина \f$ r^2 \pmod{p} \f$
+    @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size
+    или \ref ak_mpzn512_size )                                                                     */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_inverse_montgomery( ak_uint64 *z, ak_uint64 *x, ak_uint64 *p,
+                                                ak_uint64 n0, ak_uint64 *r2, const size_t size )
+{
+  ak_mpzn_inverse( z, x, p, n0, size );               /* z = (xr)^{-1} */
+  ak_mpzn_mul_montgomery( z, z, r2, p, n0, size );    /* z = x^{-1} */
+  ak_mpzn_mul_montgomery( z, z, r2, p, n0, size );    /* z = x^{-1}r */
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 #ifdef LIBAKRYPT_HAVE_GMP_H
 /* преобразование "туда и обратно" */
@@ -839,6 +1845,7 @@
     \example test-mpzn-arithmetic.c
     \example test-mpzn-montgomery.c
     \example test-mpzn-rem.c
+    \example test-mpzn02.c
                                                                                                    */
 /* ----------------------------------------------------------------------------------------------- */
 /*                                                                                      ak_mpzn.c  */
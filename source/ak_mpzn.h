@@ -10,6 +10,19 @@
 /* ----------------------------------------------------------------------------------------------- */
  #include <ak_random.h>
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что модуль имеет вид 2^{64size} - c для одного слова c. */
+ bool_t ak_mpzn_is_pseudo_mersenne( ak_uint64 *, const size_t );
+/*! \brief Умножение в представлении Монтгомери по модулю вида 2^{64size} - c. */
+ void ak_mpzn_mul_montgomery_pm( ak_uint64 *, ak_uint64 *, ak_uint64 *,
+                                                          ak_uint64 *, ak_uint64, const size_t );
+/*! \brief Возведение в квадрат в представлении Монтгомери по модулю вида 2^{64size} - c. */
+ void ak_mpzn_sqr_montgomery_pm( ak_uint64 *, ak_uint64 *, ak_uint64 *, ak_uint64, const size_t );
+/*! \brief Сложение вычетов по модулю вида 2^{64size} - c. */
+ void ak_mpzn_add_pm( ak_uint64 *, ak_uint64 *, ak_uint64 *, ak_uint64 *, const size_t );
+/*! \brief Вычитание вычетов по модулю вида 2^{64size} - c. */
+ void ak_mpzn_sub_pm( ak_uint64 *, ak_uint64 *, ak_uint64 *, ak_uint64 *, const size_t );
+
 /* ----------------------------------------------------------------------------------------------- */
 #ifdef LIBAKRYPT_HAVE_GMP_H
  #include <gmp.h>
@@ -81,9 +94,23 @@
 /*! \brief Умножение двух вычетов в представлении Монтгомери. */
  void ak_mpzn_mul_montgomery( ak_uint64 *, ak_uint64 *, ak_uint64 *,
                                                           ak_uint64 *, ak_uint64, const size_t );
-/*! \brief Модульное возведение в степень в представлении Монтгомери. */
- void ak_mpzn_modpow_montgomery( ak_uint64 *, ak_uint64 *, ak_uint64 *,
+/*! \brief Умножение двух вычетов в представлении Монтгомери по модулю длины 256 бит. */
+ void ak_mpzn_mul_montgomery_256( ak_uint64 *, ak_uint64 *, ak_uint64 *, ak_uint64 *, ak_uint64 );
+/*! \brief Умножение двух вычетов в представлении Монтгомери по модулю длины 512 бит. */
+ void ak_mpzn_mul_montgomery_512( ak_uint64 *, ak_uint64 *, ak_uint64 *, ak_uint64 *, ak_uint64 );
+/*! \brief Возведение вычета в квадрат в представлении Монтгомери. */
+ void ak_mpzn_sqr_montgomery( ak_uint64 *, ak_uint64 *, ak_uint64 *, ak_uint64, const size_t );
+/*! \brief Вычитание двух вычетов в представлении Монтгомери. */
+ void ak_mpzn_sub_montgomery( ak_uint64 *, ak_uint64 *, ak_uint64 *, ak_uint64 *, const size_t );
+/*! \brief Модульное возведение в открытую степень в представлении Монтгомери
+    (метод скользящего окна). */
+ void ak_mpzn_modpow_montgomery_vartime( ak_uint64 *, ak_uint64 *, ak_uint64 *,
                                                           ak_uint64 *, ak_uint64, const size_t );
+/*! \brief Обращение вычета за постоянное время (метод Бернштейна-Янга). */
+ void ak_mpzn_inverse( ak_uint64 *, ak_uint64 *, ak_uint64 *, ak_uint64, const size_t );
+/*! \brief Обращение вычета в представлении Монтгомери за постоянное время. */
+ void ak_mpzn_inverse_montgomery( ak_uint64 *, ak_uint64 *, ak_uint64 *,
+                                             ak_uint64, ak_uint64 *, const size_t );
 /* ----------------------------------------------------------------------------------------------- */
 #ifdef LIBAKRYPT_HAVE_GMP_H
 /*! \brief Преобразование ak_mpznxxx в mpz_t. */
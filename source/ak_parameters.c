@@ -36,6 +36,20 @@
   "8000000000000000000000000000000000000000000000000000000000000431"
  };
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Параметры кривой Эдвардса, эквивалентной кривой paramSetA из рекомендаций Р 50.1.114-2016. */
+/*! \code
+      d = "605F6B7C183FA81578BC39CFAD518132B9DF62897009AF7E522C32D6DC7BFFB",
+      s = "7E7E82520F9F015FAA1D0F18C14AB9FB35188275DA3FD94206B74F34A48E0ECD",
+      t = "100FE73F595FF158E974B44D478D9588744FE5C192AC47EA63075DCE7A14AAA"
+    \endcode                                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static const struct wcurve_edwards id_tc26_gost_3410_2012_256_paramSetA_edwards = {
+  { 0x40c8687d966dd5b1LL, 0x1fb647d3f0757f77LL, 0xffda75588b970634LL, 0x845fa0e16716c1bbLL }, /* d */
+  { 0x2fcde5e09a6488c5LL, 0xf8126e0b03e2a022LL, 0x000962a9dd1a3e72LL, 0xdee817c7a63a4f91LL }, /* s */
+  { 0x8acc116a43bcf88cLL, 0x05490bf8a813953eLL, 0xaaa468e41743d65eLL, 0x6b65457ae683caf4LL }  /* t */
+};
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Параметры 256-ти битной эллиптической кривой из рекомендаций Р 50.1.114-2016 (paramSetA). */
 /*! \code
@@ -63,7 +77,9 @@
   },
   0x46f3234475d5add9LL, /* n */
   0x035bdd1aeafdb0a9LL, /* nq */
-  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffd97"
+  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffd97",
+  &wcurve_arithmetic_pseudo_mersenne,
+  &id_tc26_gost_3410_2012_256_paramSetA_edwards
 };
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -93,7 +109,10 @@
   },
   0x46f3234475d5add9LL, /* n */
   0x9ee6ea0b57c7da65LL, /* nq */
-  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffd97"
+  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffd97",
+  &wcurve_arithmetic_pseudo_mersenne,
+  NULL, /* edwards */
+  ak_wpoint_double_minus3
  };
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -123,7 +142,10 @@
   },
   0xbd667ab8a3347857LL, /* n */
   0xca89614990611a91LL, /* nq */
-  "8000000000000000000000000000000000000000000000000000000000000c99"
+  "8000000000000000000000000000000000000000000000000000000000000c99",
+  NULL, /* arithmetic */
+  NULL, /* edwards */
+  ak_wpoint_double_minus3
  };
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -153,7 +175,10 @@
   },
   0xdf6e6c2c727c176dLL, /* n */
   0xa1c6af0a552f7577LL, /* nq */
-  "9b9f605f5a858107ab1ec85e6b41c8aacf846e86789051d37998f7b9022d759b"
+  "9b9f605f5a858107ab1ec85e6b41c8aacf846e86789051d37998f7b9022d759b",
+  NULL, /* arithmetic */
+  NULL, /* edwards */
+  ak_wpoint_double_minus3
  };
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -192,7 +217,10 @@
   },
   0x71A1662E6FA1D92DLL, /* n */
   0x40BB2313A95302ADLL, /* nq */
-  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffd215b"
+  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffd215b",
+  &wcurve_arithmetic_pseudo_mersenne,
+  NULL, /* edwards */
+  ak_wpoint_double_minus3
  };
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -252,7 +280,10 @@
   },
   0x58a1f7e6ce0f4c09LL, /* n */
   0x02ccc1665d51f223LL, /* nq */
-  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffdc7"
+  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffdc7",
+  &wcurve_arithmetic_pseudo_mersenne,
+  NULL, /* edwards */
+  ak_wpoint_double_minus3
  };
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -283,8 +314,25 @@
   0x4e6a171024e6a171LL, /* n */
   0xc07d62492cbac26bLL, /* nq */
   "8000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000006f",
+  NULL, /* arithmetic */
+  NULL, /* edwards */
+  ak_wpoint_double_minus3
  };
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Параметры кривой Эдвардса, эквивалентной кривой paramSetC из рекомендаций Р 50.1.114-2016. */
+/*! \code
+      d = "9E4F5D8C017D8D9F13A5CF3CDF5BFE4DAB402D54198E31EBDE28A0621050439CA6B39E0A515C06B304E2CE43E79E369E91A0CFC2BC2A22B4CA302DBB33EE7550",
+      s = "186C289CFFA09C983B168C30C829006C952FF4AAF99C73850875D7E77BEBEF18D653187D6BA8FE533EC74C6F061872585B97CC0F50F57752CD73F4913304621E",
+      t = "9A628F975594ECEFD89BA28A2539FFB79C8AB238AEED0851FA5C1ABB02B80B44C6734501B83A011DD625CD0B5145091A6D9ACD4B1F5C5B1E21B2B249DDFD1271"
+    \endcode                                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static const struct wcurve_edwards id_tc26_gost_3410_2012_512_paramSetC_edwards = {
+  { 0x6515a5166d05caf7, 0xae6dc7d439a723d5, 0xdc1c74edcea76671, 0x853a44eed58ae3e5, 0xc84c79f64266472e, 0xa1a4bfeccd0cf540, 0xab899e4c73783aa1, 0xde66ec2f500fc692 }, /* d */
+  { 0xa6ba96ba64be8cb4, 0x94648e0af196370a, 0x88f8e2c48c562663, 0x5eb16ec44a9d4706, 0xcdece1826f666e34, 0x9796d004ccbcc2af, 0x551d986ce321f157, 0x486644f42bfc0e5b }, /* s */
+  { 0xe62e462e6780f788, 0x9d124bf8b44685f8, 0xfa04be27a2713bbd, 0x163460d278ec7b50, 0x76b769a90b110bdd, 0xf0461ffcccd77e35, 0x71ec450cbde95f1a, 0x2511275d3802a118 }  /* t */
+};
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Параметры 512-ти битной эллиптической кривой из рекомендаций Р 50.1.114-2016 (paramSetC). */
 /*! \code
@@ -312,7 +360,9 @@
   },
   0x58a1f7e6ce0f4c09LL, /* n */
   0x0ed9d8e0b6624e1bLL, /* nq */
-  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffdc7"
+  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffdc7",
+  &wcurve_arithmetic_pseudo_mersenne,
+  &id_tc26_gost_3410_2012_512_paramSetC_edwards
  };
 
 /* ----------------------------------------------------------------------------------------------- */
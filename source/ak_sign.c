@@ -23,6 +23,12 @@
 #ifdef LIBAKRYPT_HAVE_TIME_H
  #include <time.h>
 #endif
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+ #include <pthread.h>
+#endif
+#ifdef LIBAKRYPT_HAVE_SYSMMAN_H
+ #include <sys/mman.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Установление или изменение маски секретного ключа ассиметричного криптографического
@@ -51,7 +57,7 @@
 #ifndef LIBAKRYPT_LITTLE_ENDIAN
   int i = 0;
 #endif
-  ak_mpznmax u, zeta;
+  ak_mpznmax zeta;
   ak_wcurve wc = NULL;
   int error = ak_error_ok;
   ak_uint64 *key = NULL, *mask = NULL;
@@ -95,10 +101,7 @@
      ak_mpzn_mul_montgomery( key, key, mask, wc->q, wc->nq, wc->size);
 
     /* вычисляем обратное значение для маски */
-     ak_mpzn_set_ui( u, wc->size, 2 );
-     ak_mpzn_sub( u, wc->q, u, wc->size );
-     ak_mpzn_modpow_montgomery( mask, // m <- m^{q-2} (mod q)
-                                    mask, u, wc->q, wc->nq, wc->size );
+     ak_mpzn_inverse_montgomery( mask, mask, wc->q, wc->nq, wc->r2q, wc->size );
     /* меняем значение флага */
      skey->flags |= ak_key_flag_set_mask;
 
@@ -115,9 +118,7 @@
     /* домножаем ключ на случайное число */
      ak_mpzn_mul_montgomery( key, key, zeta, wc->q, wc->nq, wc->size );
     /* вычисляем обратное значение zeta */
-     ak_mpzn_set_ui( u, wc->size, 2 );
-     ak_mpzn_sub( u, wc->q, u, wc->size );
-     ak_mpzn_modpow_montgomery( zeta, zeta, u, wc->q, wc->nq, wc->size ); // z <- z^{q-2} (mod q)
+     ak_mpzn_inverse_montgomery( zeta, zeta, wc->q, wc->nq, wc->r2q, wc->size );
 
     /* домножаем маску на обратное значение zeta */
      ak_mpzn_mul_montgomery( mask, mask, zeta, wc->q, wc->nq, wc->size );
@@ -190,6 +191,112 @@
 }
 
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество пар масок, вычисляемых функцией ak_signkey_context_compute_masks()
+    за одно обращение. */
+ #define ak_signkey_mask_pairs_count   (32)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выработка запаса пар масок \f$ (\zeta, \zeta^{-1}) \f$ секретного ключа.
+
+    Функция вырабатывает случайные вычеты \f$ \zeta_1, \ldots, \zeta_n \f$ из кольца
+    \f$ \mathbb Z_q\f$ и вычисляет обратные к ним значения методом Монтгомери:
+    вычисляются произведения \f$ \pi_i = \zeta_1 \cdots \zeta_i \f$, после чего обращается
+    только одно значение \f$ \pi_n \f$, а остальные обратные значения вычисляются
+    с помощью \f$ 3(n-1) \f$ умножений. Все вычеты хранятся в представлении Монтгомери.
+    Память под запас масок, при наличии такой возможности, блокируется от выгрузки на диск.
+
+    @param sctx Контекст секретного ключа алгоритма электронной подписи.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае,
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_signkey_context_compute_masks( ak_signkey sctx )
+{
+  size_t i = 0;
+  ak_mpznmax inv, tmp;
+  int error = ak_error_ok;
+  ak_wcurve wc = ( ak_wcurve ) sctx->key.data;
+  ak_uint64 *zeta = NULL, *prod = NULL;
+
+  if( sctx->masks == NULL ) {
+    if(( sctx->masks = calloc( 2*ak_signkey_mask_pairs_count, sizeof( ak_mpzn512 ))) == NULL )
+      return ak_error_message( ak_error_out_of_memory, __func__ , "incorrect memory allocation" );
+   #ifdef LIBAKRYPT_HAVE_SYSMMAN_H
+    if( mlock( sctx->masks, 2*ak_signkey_mask_pairs_count*sizeof( ak_mpzn512 )) != 0 )
+      ak_error_message( ak_error_ok, __func__ , "key masks are not locked in memory" );
+   #endif
+  }
+
+ /* вырабатываем маски и вычисляем их произведения (произведения хранятся на месте
+    обратных значений) */
+  for( i = 0; i < ak_signkey_mask_pairs_count; i++ ) {
+     zeta = sctx->masks + 2*i*ak_mpzn512_size;
+     prod = zeta + ak_mpzn512_size;
+     if(( error = ak_random_context_random( &sctx->key.generator, zeta,
+                                               (ssize_t)sctx->key.key_size )) != ak_error_ok ) {
+       sctx->masks_count = 0;
+       return ak_error_message( error, __func__ , "wrong mask generation for key buffer" );
+     }
+     ak_mpzn_rem( zeta, zeta, wc->q, wc->size );
+     if( ak_mpzn_cmp_ui( zeta, wc->size, 0 )) ak_mpzn_set_ui( zeta, wc->size, 1 );
+     if( i == 0 ) ak_mpzn_set( prod, zeta, wc->size );
+      else ak_mpzn_mul_montgomery( prod, prod - 2*ak_mpzn512_size, zeta, wc->q, wc->nq, wc->size );
+  }
+
+ /* обращаем произведение всех масок и вычисляем обратные значения */
+  ak_mpzn_inverse_montgomery( inv, prod, wc->q, wc->nq, wc->r2q, wc->size );
+  for( i = ak_signkey_mask_pairs_count - 1; i > 0; i-- ) {
+     zeta = sctx->masks + 2*i*ak_mpzn512_size;
+     prod = zeta + ak_mpzn512_size;
+     ak_mpzn_mul_montgomery( tmp, inv, prod - 2*ak_mpzn512_size, wc->q, wc->nq, wc->size );
+     ak_mpzn_mul_montgomery( inv, inv, zeta, wc->q, wc->nq, wc->size );
+     ak_mpzn_set( prod, tmp, wc->size );
+  }
+  ak_mpzn_set( sctx->masks + ak_mpzn512_size, inv, wc->size );
+  sctx->masks_count = ak_signkey_mask_pairs_count;
+
+  ak_ptr_context_wipe( inv, sizeof( inv ), &sctx->key.generator );
+  ak_ptr_context_wipe( tmp, sizeof( tmp ), &sctx->key.generator );
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Смена маски секретного ключа после выработки электронных подписей.
+
+    Функция учитывает выработку `count` подписей и, если с момента последней смены маски
+    выработано не менее `sctx->remask_period` подписей, заменяет значение ключа \f$ k \f$
+    и маски \f$ m \f$ на значения \f$ k\zeta \f$ и \f$ m\zeta^{-1} \f$. В отличие от функции
+    ak_signkey_context_set_mask_multiplicative(), пара \f$ (\zeta, \zeta^{-1}) \f$ берется из
+    запаса, вычисленного заранее функцией ak_signkey_context_compute_masks(), поэтому смена маски
+    требует только двух умножений.
+
+    @param sctx Контекст секретного ключа алгоритма электронной подписи.
+    @param count Количество выработанных подписей.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае,
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_signkey_context_remask( ak_signkey sctx, const size_t count )
+{
+  ak_uint64 *pair = NULL;
+  ak_wcurve wc = ( ak_wcurve ) sctx->key.data;
+
+  if((( sctx->key.flags )&ak_key_flag_set_mask ) == 0 ) return sctx->key.set_mask( &sctx->key );
+  if(( sctx->remask_counter += count ) < sctx->remask_period ) return ak_error_ok;
+  sctx->remask_counter = 0;
+
+  if(( sctx->masks_count == 0 ) &&
+     ( ak_signkey_context_compute_masks( sctx ) != ak_error_ok ))
+    return sctx->key.set_mask( &sctx->key );
+
+  pair = sctx->masks + 2*( --sctx->masks_count )*ak_mpzn512_size;
+  ak_mpzn_mul_montgomery(( ak_uint64 * )sctx->key.key,
+                                ( ak_uint64 * )sctx->key.key, pair, wc->q, wc->nq, wc->size );
+  ak_mpzn_mul_montgomery(( ak_uint64 * )( sctx->key.key + sctx->key.key_size ),
+                                ( ak_uint64 * )( sctx->key.key + sctx->key.key_size ),
+                                               pair + ak_mpzn512_size, wc->q, wc->nq, wc->size );
+ return ak_ptr_context_wipe( pair, 2*sizeof( ak_mpzn512 ), &sctx->key.generator );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*                    функции для работы с секретными ключами электронной подписи                  */
 /* ----------------------------------------------------------------------------------------------- */
@@ -311,6 +418,9 @@
    sk->key.flags |= ak_key_flag_data_not_free;
   /* устанавливаем время жизни ключа по-умолчанию */
    ak_signkey_context_set_validity( sk, 0, 0 );
+  /* устанавливаем частоту смены маски ключа */
+   sk->remask_period = ( size_t )
+                    ak_libakrypt_get_option_by_index( ak_option_signkey_remask_period );
 
   /* в заключение определяем указатели на методы */
    sk->key.set_mask = ak_signkey_context_set_mask_multiplicative;
@@ -352,10 +462,15 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_signkey_context_set_curve( ak_signkey sctx, const ak_wcurve wc )
 {
+   int error = ak_error_ok;
+
    if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
                                     "using null pointer to digital signature secret key context" );
    if( wc == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
                                                   "using null pointer to elliptic curve context" );
+  /* для встроенных параметров проверка выполняется один раз, результат хранится в кэше */
+   if(( error = ak_wcurve_is_ok( wc )) != ak_error_ok )
+     return ak_error_message( error, __func__ , "using elliptic curve with wrong parameters" );
    if( wc->size != ( sctx->ctx.data.sctx.hsize >> 3 ))
     return ak_error_message_fmt( ak_error_curve_not_supported, __func__ ,
                               "%u bits elliptic curve is not applicable for algorithm %s",
@@ -424,6 +539,17 @@
   int error = ak_error_ok;
   if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
                            "destroying a null pointer to digital signature secret key context" );
+  if(( error = ak_signkey_context_disable_pool( sctx )) != ak_error_ok )
+    ak_error_message( error, __func__ , "incorrect destroying of precomputed values pool" );
+  if( sctx->masks != NULL ) {
+    ak_ptr_context_wipe( sctx->masks,
+               2*ak_signkey_mask_pairs_count*sizeof( ak_mpzn512 ), &sctx->key.generator );
+   #ifdef LIBAKRYPT_HAVE_SYSMMAN_H
+    munlock( sctx->masks, 2*ak_signkey_mask_pairs_count*sizeof( ak_mpzn512 ));
+   #endif
+    free( sctx->masks );
+    sctx->masks = NULL;
+  }
   if(( error = ak_skey_context_destroy( &sctx->key )) != ak_error_ok )
     ak_error_message( error, __func__ , "incorrect destroying of digital signature secret key" );
   if(( error = ak_hash_context_destroy( &sctx->ctx )) != ak_error_ok )
@@ -461,6 +587,40 @@
   return 2*sctx->ctx.data.sctx.hsize;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Установка ресурса секретного ключа электронной подписи.
+
+    Ресурс ключа определяет количество подписей, которые могут быть выработаны на ключе,
+    и задается опцией `digital_signature_count_resource`. Временной интервал действия ключа
+    функцией не изменяется.
+
+    @param sctx контекст секретного ключа алгоритма электронной подписи.                          */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_signkey_context_set_resource( ak_signkey sctx )
+{
+  sctx->key.resource.value.type = key_using_resource;
+  sctx->key.resource.value.counter = ( ssize_t )
+            ak_libakrypt_get_option_by_index( ak_option_digital_signature_count_resource );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Уменьшение ресурса секретного ключа электронной подписи.
+
+    Ресурс учитывается только для ключей, значение которых присвоено функциями
+    ak_signkey_context_set_key() или ak_signkey_context_set_key_random(), либо для ключей,
+    ресурс которых был сохранен вместе с ключом.
+
+    @param sctx контекст секретного ключа алгоритма электронной подписи.
+    @param count количество вырабатываемых подписей.
+    @return В случае успеха функция возвращает \ref ak_error_ok. При недостатке ресурса
+    возвращается \ref ak_error_low_key_resource.                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_signkey_context_use_resource( ak_signkey sctx, const size_t count )
+{
+  if( sctx->key.resource.value.type != key_using_resource ) return ak_error_ok;
+ return ak_skey_context_use_resource( &sctx->key, ( ssize_t ) count );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param sctx контекст секретного ключа алгоритма электронной подписи.
     @param ptr указатель на область памяти, содержащей значение секретного ключа.
@@ -483,6 +643,7 @@
  /* присваиваем ключевой буффер */
   if(( error = ak_skey_context_set_key( &sctx->key, ptr, size )) != ak_error_ok )
     return ak_error_message( error, __func__ , "incorrect assigning of key data" );
+  ak_signkey_context_set_resource( sctx );
 
  /*
     ... в процессе присвоения ключа, он приводится по модулю и маскируется
@@ -510,6 +671,7 @@
  /* присваиваем секретный ключ */
   if(( error = ak_skey_context_set_key_random( &sctx->key, generator )) != ak_error_ok )
     return ak_error_message( error, __func__ , "wrong generation a secret key context" );
+  ak_signkey_context_set_resource( sctx );
 
  /*
     ... в процессе присвоения ключа, он приводится по модулю и маскируется
@@ -517,6 +679,29 @@
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция задает количество подписей, после выработки которых изменяется маска секретного ключа.
+    Значение по-умолчанию определяется опцией `signkey_remask_period` и равно единице,
+    т.е. маска ключа изменяется после выработки каждой подписи. Увеличение периода
+    уменьшает время выработки подписи, однако одно и то же маскированное значение ключа
+    используется при выработке нескольких подписей.
+
+    @param sctx контекст секретного ключа алгоритма электронной подписи.
+    @param period количество подписей; значение должно быть больше нуля.
+    @return В случае успеха возвращается ноль (\ref ak_error_ok). В противном случае возвращается
+    код ошибки.                                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_context_set_remask_period( ak_signkey sctx, const size_t period )
+{
+  if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                     "using null pointer to secret key context" );
+  if( period == 0 ) return ak_error_message( ak_error_zero_length, __func__ ,
+                                                              "using zero value of remask period" );
+  sctx->remask_period = period;
+  sctx->remask_counter = 0;
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Присвоение времени происходит следующим образом. Если `not_before` равно нулю, то
     устанавливается текущее время. Если `not_after` равно нулю или меньше, чем `not_before`,
@@ -573,6 +758,460 @@
  return ak_tlv_context_add_string_to_global_name( sk->name, ni, string );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                   функции для работы с пулом заранее вычисленных значений                       */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Пул заранее вычисленных значений, используемых при выработке электронной подписи.
+
+    Значение \f$ r \equiv x([k]P) \pmod{q} \f$ не зависит от подписываемого сообщения, поэтому
+    наиболее трудоемкая часть выработки подписи может быть выполнена заранее.
+    Каждый элемент пула содержит три вычета длины `wc->size` слов: значение \f$ r \f$,
+    значение \f$ r \f$ в представлении Монтгомери и значение \f$ k \f$ в представлении
+    Монтгомери, на которое наложена маска. Маски хранятся в отдельном массиве, который,
+    при наличии такой возможности, блокируется в оперативной памяти; тем самым, содержимое
+    одного массива не позволяет восстановить значения \f$ k \f$.                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ struct signkey_pool {
+ /*! \brief эллиптическая кривая, для которой вычислены элементы пула */
+  ak_wcurve wc;
+ /*! \brief генератор, используемый для выработки случайных значений \f$ k \f$ и масок */
+  struct random generator;
+ /*! \brief массив элементов пула */
+  ak_uint64 *values;
+ /*! \brief массив масок, наложенных на значения \f$ k \f$ */
+  ak_uint64 *masks;
+ /*! \brief максимальное количество элементов пула */
+  size_t capacity;
+ /*! \brief текущее количество элементов пула */
+  size_t count;
+ /*! \brief флаг завершения работы потока, заполняющего пул */
+  bool_t stop;
+ /*! \brief код ошибки, после которой поток прекратил заполнение пула */
+  int error;
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+ /*! \brief мьютекс, защищающий массив элементов и генератор */
+  pthread_mutex_t mutex;
+ /*! \brief условная переменная, сигнализирующая об изъятии элементов из пула */
+  pthread_cond_t cond;
+ /*! \brief поток, заполняющий пул */
+  pthread_t thread;
+ /*! \brief флаг запуска потока */
+  bool_t started;
+#endif
+};
+
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_signkey_pool_lock( ak_signkey_pool pool )
+{
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &pool->mutex );
+#else
+  (void) pool;
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_signkey_pool_unlock( ak_signkey_pool pool )
+{
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &pool->mutex );
+#else
+  (void) pool;
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление одного элемента пула и помещение его в пул.
+
+    Вычисление кратной точки выполняется без блокировки пула, поэтому функция может вызываться
+    одновременно из нескольких потоков. Если за время вычисления пул был заполнен,
+    то вычисленный элемент уничтожается.
+
+    @param pool Контекст пула.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_signkey_pool_compute( ak_signkey_pool pool )
+{
+  size_t i = 0;
+  struct wpoint wr;
+  ak_mpzn512 k, mask;
+  int error = ak_error_ok;
+  ak_wcurve wc = pool->wc;
+  ak_uint64 entry[3*ak_mpzn512_size];
+  const size_t size = wc->size;
+
+ /* вырабатываем случайное число и маску */
+  ak_signkey_pool_lock( pool );
+  if(( error = ak_mpzn_set_random_modulo( k, wc->q, size, &pool->generator )) == ak_error_ok )
+    error = ak_random_context_random( &pool->generator,
+                                                   mask, ( ssize_t )( size*sizeof( ak_uint64 )));
+  if( error != ak_error_ok ) {
+    ak_ptr_context_wipe( k, sizeof( ak_mpzn512 ), &pool->generator );
+    ak_ptr_context_wipe( mask, sizeof( ak_mpzn512 ), &pool->generator );
+    ak_signkey_pool_unlock( pool );
+    return ak_error_message( error, __func__ , "invalid generation of random value" );
+  }
+  ak_signkey_pool_unlock( pool );
+
+ /* вычисляем r, r и k в представлении Монтгомери, накладываем маску на k */
+  ak_wpoint_pow_base( &wr, k, size, wc );
+  ak_wpoint_reduce( &wr, wc );
+  ak_mpzn_rem( entry, wr.x, wc->q, size );
+  ak_mpzn_mul_montgomery( entry+size, entry, wc->r2q, wc->q, wc->nq, size );
+  ak_mpzn_mul_montgomery( entry+2*size, k, wc->r2q, wc->q, wc->nq, size );
+  for( i = 0; i < size; i++ ) entry[2*size+i] ^= mask[i];
+
+ /* помещаем элемент и маску в пул */
+  ak_signkey_pool_lock( pool );
+  if( pool->count < pool->capacity ) {
+    memcpy( pool->values + 3*size*pool->count, entry, 3*size*sizeof( ak_uint64 ));
+    memcpy( pool->masks + size*pool->count, mask, size*sizeof( ak_uint64 ));
+    pool->count++;
+  }
+ /* генератор пула используется только при заблокированном мьютексе */
+  ak_ptr_context_wipe( &wr, sizeof( struct wpoint ), &pool->generator );
+  ak_ptr_context_wipe( k, sizeof( ak_mpzn512 ), &pool->generator );
+  ak_ptr_context_wipe( mask, sizeof( ak_mpzn512 ), &pool->generator );
+  ak_ptr_context_wipe( entry, sizeof( entry ), &pool->generator );
+  ak_signkey_pool_unlock( pool );
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Изъятие элемента из пула.
+
+    Элемент пула уничтожается, маска снимается со значения \f$ k \f$ после копирования.
+
+    @param pool Контекст пула.
+    @param wc Эллиптическая кривая, для которой вырабатывается подпись.
+    @param entry Массив, куда помещаются значения \f$ r \f$, \f$ r \f$ и \f$ k \f$
+    в представлении Монтгомери; должен вмещать три вычета длины `wc->size` слов.
+    @return Функция возвращает \ref ak_true, если элемент был изъят из пула. Если пул пуст,
+    либо вычислен для другой кривой, то возвращается \ref ak_false.                               */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_signkey_pool_get( ak_signkey_pool pool, ak_wcurve wc, ak_uint64 *entry )
+{
+  size_t i = 0;
+  ak_mpzn512 mask;
+  ak_uint64 *ptr = NULL;
+  bool_t result = ak_false;
+  const size_t size = wc->size;
+
+  ak_signkey_pool_lock( pool );
+  if(( pool->wc == wc ) && ( pool->count > 0 )) {
+    --pool->count;
+    ptr = pool->values + 3*size*pool->count;
+    memcpy( entry, ptr, 3*size*sizeof( ak_uint64 ));
+    ak_ptr_context_wipe( ptr, 3*size*sizeof( ak_uint64 ), &pool->generator );
+    ptr = pool->masks + size*pool->count;
+    memcpy( mask, ptr, size*sizeof( ak_uint64 ));
+    ak_ptr_context_wipe( ptr, size*sizeof( ak_uint64 ), &pool->generator );
+    for( i = 0; i < size; i++ ) entry[2*size+i] ^= mask[i];
+    ak_ptr_context_wipe( mask, sizeof( ak_mpzn512 ), &pool->generator );
+    result = ak_true;
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+    pthread_cond_signal( &pool->cond );
+#endif
+  }
+  ak_signkey_pool_unlock( pool );
+ return result;
+}
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Максимальное количество идущих подряд неудачных попыток вычисления элемента пула,
+    после которого поток прекращает заполнение пула. */
+ #define ak_signkey_pool_max_failures   (3)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция потока, заполняющего пул по мере изъятия из него элементов.
+    \details Если вычисление элемента пула завершилось ошибкой, то попытка повторяется;
+    после \ref ak_signkey_pool_max_failures неудачных попыток подряд код ошибки сохраняется
+    в контексте пула (см. ak_signkey_context_get_pool_error()) и поток завершается.              */
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_signkey_pool_thread( void *ptr )
+{
+  int error = ak_error_ok;
+  size_t failures = 0;
+  ak_signkey_pool pool = ( ak_signkey_pool ) ptr;
+
+  pthread_mutex_lock( &pool->mutex );
+  while( !pool->stop ) {
+     if( pool->count == pool->capacity ) {
+       pthread_cond_wait( &pool->cond, &pool->mutex );
+       continue;
+     }
+     pthread_mutex_unlock( &pool->mutex );
+     if(( error = ak_signkey_pool_compute( pool )) == ak_error_ok ) failures = 0;
+      else failures++;
+     pthread_mutex_lock( &pool->mutex );
+     if( failures == ak_signkey_pool_max_failures ) {
+       pool->error = error;
+       break;
+     }
+  }
+  pthread_mutex_unlock( &pool->mutex );
+ return NULL;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция создает пул, содержащий не более `size` заранее вычисленных пар \f$ (k, r) \f$,
+    где \f$ r \equiv x([k]P) \pmod{q} \f$. При выработке подписи функцией
+    ak_signkey_context_sign_hash() пара изымается из пула и уничтожается, после чего
+    вычисление подписи сводится к нескольким умножениям по модулю \f$ q \f$.
+    Если пул пуст, то пара вычисляется непосредственно при выработке подписи.
+
+    При наличии поддержки потоков пул заполняется отдельным потоком, который пополняет пул
+    по мере изъятия из него элементов. В противном случае пул заполняется при создании,
+    а также при вызове функции ak_signkey_context_fill_pool().
+
+    Значения \f$ k \f$ вырабатываются генератором, создаваемым для пула, и хранятся
+    в представлении Монтгомери с наложенной маской; маски размещаются в отдельной области памяти,
+    которая, по возможности, блокируется от выгрузки на диск.
+
+    @param sctx Контекст секретного ключа алгоритма электронной подписи.
+    @param size Максимальное количество элементов пула.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_context_enable_pool( ak_signkey sctx, const size_t size )
+{
+  ak_signkey_pool pool = NULL;
+  int error = ak_error_ok;
+  ak_wcurve wc = NULL;
+
+  if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                    "using null pointer to digital signature secret key context" );
+  if(( wc = ( ak_wcurve ) sctx->key.data ) == NULL )
+    return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                 "using internal null pointer to elliptic curve" );
+  if( size == 0 ) return ak_error_message( ak_error_zero_length, __func__ ,
+                                                                  "using pool with zero length" );
+  if( sctx->pool != NULL ) ak_signkey_context_disable_pool( sctx );
+
+  if(( pool = calloc( 1, sizeof( struct signkey_pool ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__ , "incorrect memory allocation" );
+  if(( pool->values = malloc( 3*size*wc->size*sizeof( ak_uint64 ))) == NULL ) {
+    free( pool );
+    return ak_error_message( ak_error_out_of_memory, __func__ , "incorrect memory allocation" );
+  }
+  if(( pool->masks = malloc( size*wc->size*sizeof( ak_uint64 ))) == NULL ) {
+    free( pool->values );
+    free( pool );
+    return ak_error_message( ak_error_out_of_memory, __func__ , "incorrect memory allocation" );
+  }
+#ifdef LIBAKRYPT_HAVE_SYSMMAN_H
+  if( mlock( pool->masks, size*wc->size*sizeof( ak_uint64 )) != 0 )
+    ak_error_message( ak_error_ok, __func__ , "pool masks are not locked in memory" );
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+  error = ak_random_context_create_urandom( &pool->generator );
+#else
+  error = ak_random_context_create_winrtl( &pool->generator );
+#endif
+  if( error != ak_error_ok ) {
+   #ifdef LIBAKRYPT_HAVE_SYSMMAN_H
+    munlock( pool->masks, size*wc->size*sizeof( ak_uint64 ));
+   #endif
+    free( pool->masks );
+    free( pool->values );
+    free( pool );
+    return ak_error_message( error, __func__ , "wrong creation of random generator" );
+  }
+  pool->wc = wc;
+  pool->capacity = size;
+  pool->count = 0;
+  pool->stop = ak_false;
+  pool->error = ak_error_ok;
+  sctx->pool = pool;
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_init( &pool->mutex, NULL );
+  pthread_cond_init( &pool->cond, NULL );
+  if(( pool->started = ( pthread_create( &pool->thread, NULL,
+                                              ak_signkey_pool_thread, pool ) == 0 )) == ak_true )
+    return ak_error_ok;
+  ak_error_message( ak_error_ok, __func__ , "pool is filled without background thread" );
+#endif
+ return ak_signkey_context_fill_pool( sctx );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет недостающие элементы пула в вызывающем потоке. Функция может вызываться
+    как при отсутствии поддержки потоков, так и одновременно с работой потока, заполняющего пул.
+
+    @param sctx Контекст секретного ключа алгоритма электронной подписи.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки. Если пул заполнен, но поток, заполняющий пул, завершился
+    с ошибкой, то возвращается код этой ошибки.                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_context_fill_pool( ak_signkey sctx )
+{
+  int error = ak_error_ok;
+
+  if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                    "using null pointer to digital signature secret key context" );
+  if( sctx->pool == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                   "using secret key context without nonce pool" );
+  while( ak_signkey_context_get_pool_count( sctx ) < sctx->pool->capacity )
+    if(( error = ak_signkey_pool_compute( sctx->pool )) != ak_error_ok )
+      return ak_error_message( error, __func__ , "incorrect computation of pool element" );
+  if(( error = ak_signkey_context_get_pool_error( sctx )) != ak_error_ok )
+    return ak_error_message( error, __func__ , "background thread stopped filling the pool" );
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Поток, заполняющий пул, повторяет вычисление элемента пула при возникновении ошибки
+    и завершается после нескольких неудачных попыток подряд; в этом случае пул больше
+    не пополняется автоматически, а подписи вырабатываются без использования пула.
+    Функция позволяет обнаружить такую ситуацию.
+
+    @param sctx Контекст секретного ключа алгоритма электронной подписи.
+    @return Функция возвращает код ошибки, после которой поток прекратил заполнение пула.
+    Если поток работает, либо пул не создан, то возвращается \ref ak_error_ok.                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_context_get_pool_error( ak_signkey sctx )
+{
+  int error = ak_error_ok;
+
+  if(( sctx == NULL ) || ( sctx->pool == NULL )) return ak_error_ok;
+  ak_signkey_pool_lock( sctx->pool );
+  error = sctx->pool->error;
+  ak_signkey_pool_unlock( sctx->pool );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! @param sctx Контекст секретного ключа алгоритма электронной подписи.
+    @return Функция возвращает текущее количество элементов пула. Если пул не создан,
+    то возвращается ноль.                                                                          */
+/* ----------------------------------------------------------------------------------------------- */
+ size_t ak_signkey_context_get_pool_count( ak_signkey sctx )
+{
+  size_t count = 0;
+
+  if(( sctx == NULL ) || ( sctx->pool == NULL )) return 0;
+  ak_signkey_pool_lock( sctx->pool );
+  count = sctx->pool->count;
+  ak_signkey_pool_unlock( sctx->pool );
+ return count;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция останавливает поток, заполняющий пул, уничтожает все элементы пула и освобождает
+    занимаемую им память. Функция вызывается при уничтожении контекста секретного ключа.
+
+    @param sctx Контекст секретного ключа алгоритма электронной подписи.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_context_disable_pool( ak_signkey sctx )
+{
+  ak_signkey_pool pool = NULL;
+
+  if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                    "using null pointer to digital signature secret key context" );
+  if(( pool = sctx->pool ) == NULL ) return ak_error_ok;
+
+  ak_signkey_pool_lock( pool );
+  pool->stop = ak_true;
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_cond_broadcast( &pool->cond );
+#endif
+  ak_signkey_pool_unlock( pool );
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  if( pool->started ) pthread_join( pool->thread, NULL );
+  pthread_cond_destroy( &pool->cond );
+  pthread_mutex_destroy( &pool->mutex );
+#endif
+
+  ak_ptr_context_wipe( pool->values,
+                   3*pool->capacity*pool->wc->size*sizeof( ak_uint64 ), &pool->generator );
+  ak_ptr_context_wipe( pool->masks,
+                     pool->capacity*pool->wc->size*sizeof( ak_uint64 ), &pool->generator );
+#ifdef LIBAKRYPT_HAVE_SYSMMAN_H
+  munlock( pool->masks, pool->capacity*pool->wc->size*sizeof( ak_uint64 ));
+#endif
+  free( pool->masks );
+  free( pool->values );
+  ak_random_context_destroy( &pool->generator );
+  free( pool );
+  sctx->pool = NULL;
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Завершение вычисления электронной подписи по заданному значению \f$ rd \pmod{q} \f$.
+
+    Функция вычисляет значение \f$ s \equiv rd + ke \pmod{q}\f$ и помещает в буффер `out`
+    конкатенацию векторов `s` и `r`.
+
+    @param wc эллиптическая кривая, на которой вырабатывается подпись.
+    @param s вычет \f$ rd \pmod{q} \f$ в представлении Монтгомери; значение изменяется функцией.
+    @param r вычет \f$ r \f$ в обычной форме.
+    @param km вычет \f$ k \f$ в представлении Монтгомери.
+    @param e целое число, соотвествующее хеш-коду подписываемого сообщения.
+    @param out массив, куда помещается результат.                                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_signkey_context_sign_values_rd( ak_wcurve wc, ak_uint64 *s,
+                                          ak_uint64 *r, ak_uint64 *km, ak_uint64 *e, ak_pointer out )
+{
+  ak_mpzn512 t;
+
+ /* приводим e к виду Монтгомери и помещаем во временную переменную t <- e */
+  ak_mpzn_rem( t, e, wc->q, wc->size );
+  if( ak_mpzn_cmp_ui( t, wc->size, 0 )) ak_mpzn_set_ui( t, wc->size, 1 );
+  ak_mpzn_mul_montgomery( t, t, wc->r2q, wc->q, wc->nq, wc->size );
+
+ /* вычисляем k*e (mod q) и вычисляем s = r*d + k*e (mod q) (в форме Монтгомери) */
+  ak_mpzn_mul_montgomery( t, km, t, wc->q, wc->nq, wc->size ); /* t <- k*e */
+  ak_mpzn_add_montgomery( s, s, t, wc->q, wc->size );
+
+ /* приводим s к обычной форме */
+  ak_mpzn_mul_montgomery( s, s,  wc->point.z, /* для экономии памяти пользуемся равенством z = 1 */
+                                 wc->q, wc->nq, wc->size );
+ /* экспортируем результат */
+  ak_mpzn_to_little_endian( s, wc->size, out, sizeof(ak_uint64)*wc->size, ak_true );
+  ak_mpzn_to_little_endian( r, wc->size, (ak_uint64 *)out + wc->size,
+                                                             sizeof(ak_uint64)*wc->size, ak_true );
+  memset( t, 0, sizeof( ak_mpzn512 ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление второй половинки электронной подписи по заданным значениям
+    \f$ r \f$ и \f$ k \f$.
+
+    Функция вычисляет значение \f$ rd \pmod{q}\f$, вызывает функцию
+    ak_signkey_context_sign_values_rd(), после чего, при необходимости, изменяет маску
+    секретного ключа (см. ak_signkey_context_remask()).
+
+    @param sctx контекст секретного ключа алгоритма электронной подписи.
+    @param r вычет \f$ r \f$ в обычной форме.
+    @param rm вычет \f$ r \f$ в представлении Монтгомери.
+    @param km вычет \f$ k \f$ в представлении Монтгомери.
+    @param e целое число, соотвествующее хеш-коду подписываемого сообщения.
+    @param out массив, куда помещается результат.                                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_signkey_context_sign_values( ak_signkey sctx, ak_uint64 *r,
+                                        ak_uint64 *rm, ak_uint64 *km, ak_uint64 *e, ak_pointer out )
+{
+  ak_mpzn512 s;
+  ak_wcurve wc = ( ak_wcurve ) sctx->key.data;
+
+ /* вычисляем значение s <- r*d (mod q) (сначала домножаем на ключ, потом на его маску) */
+  ak_mpzn_mul_montgomery( s, rm, (ak_uint64 *)sctx->key.key, wc->q, wc->nq, wc->size );
+  ak_mpzn_mul_montgomery( s, s,
+              (ak_uint64 *)(sctx->key.key+sctx->key.key_size), wc->q, wc->nq, wc->size );
+  ak_signkey_context_sign_values_rd( wc, s, r, km, e, out );
+
+ /* завершаемся */
+  ak_signkey_context_remask( sctx, 1 );
+  memset( s, 0, sizeof( ak_mpzn512 ));
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция вырабатывает электронную подпись для \f$ e \f$ - вычисленного хеш-кода подписываемого
     сообщения и заданного случайного числа \f$ k \f$. Для этого
@@ -610,48 +1249,28 @@
  void ak_signkey_context_sign_const_values( ak_signkey sctx,
                                                        ak_uint64 *k, ak_uint64 *e, ak_pointer out )
 {
-  ak_mpzn512 r, s;
+  ak_mpzn512 r, rm, km;
   struct wpoint wr;
   ak_wcurve wc = ( ak_wcurve ) sctx->key.data;
 
  /* поскольку функция не экспортируется, мы оставляем все проверки функциям верхнего уровня */
  /* вычисляем r */
-  ak_wpoint_pow( &wr, &wc->point, k, wc->size, wc );
+  ak_wpoint_pow_base( &wr, k, wc->size, wc );
   ak_wpoint_reduce( &wr, wc );
   ak_mpzn_rem( r, wr.x, wc->q, wc->size );
 
- /* приводим r к виду Монтгомери и помещаем во временную переменную wr.x <- r */
-  ak_mpzn_mul_montgomery( wr.x, r, wc->r2q, wc->q, wc->nq, wc->size );
-
- /* вычисляем значение s <- r*d (mod q) (сначала домножаем на ключ, потом на его маску) */
-  ak_mpzn_mul_montgomery( s, wr.x, (ak_uint64 *)sctx->key.key, wc->q, wc->nq, wc->size );
-  ak_mpzn_mul_montgomery( s, s,
-              (ak_uint64 *)(sctx->key.key+sctx->key.key_size), wc->q, wc->nq, wc->size );
-
- /* приводим k к виду Монтгомери и помещаем во временную переменную wr.y <- k */
-  ak_mpzn_mul_montgomery( wr.y, k, wc->r2q, wc->q, wc->nq, wc->size );
+ /* приводим r и k к виду Монтгомери */
+  ak_mpzn_mul_montgomery( rm, r, wc->r2q, wc->q, wc->nq, wc->size );
+  ak_mpzn_mul_montgomery( km, k, wc->r2q, wc->q, wc->nq, wc->size );
 
- /* приводим e к виду Монтгомери и помещаем во временную переменную wr.z <- e */
-  ak_mpzn_rem( wr.z, e, wc->q, wc->size );
-  if( ak_mpzn_cmp_ui( wr.z, wc->size, 0 )) ak_mpzn_set_ui( wr.z, wc->size, 1 );
-  ak_mpzn_mul_montgomery( wr.z, wr.z, wc->r2q, wc->q, wc->nq, wc->size );
-
- /* вычисляем k*e (mod q) и вычисляем s = r*d + k*e (mod q) (в форме Монтгомери) */
-  ak_mpzn_mul_montgomery( wr.y, wr.y, wr.z, wc->q, wc->nq, wc->size ); /* wr.y <- k*e */
-  ak_mpzn_add_montgomery( s, s, wr.y, wc->q, wc->size );
+ /* вычисляем вторую половинку подписи и экспортируем результат */
+  ak_signkey_context_sign_values( sctx, r, rm, km, e, out );
 
- /* приводим s к обычной форме */
-  ak_mpzn_mul_montgomery( s, s,  wc->point.z, /* для экономии памяти пользуемся равенством z = 1 */
-                                 wc->q, wc->nq, wc->size );
- /* экспортируем результат */
-  ak_mpzn_to_little_endian( s, wc->size, out, sizeof(ak_uint64)*wc->size, ak_true );
-  ak_mpzn_to_little_endian( r, wc->size, (ak_uint64 *)out + wc->size,
-                                                             sizeof(ak_uint64)*wc->size, ak_true );
  /* завершаемся */
   memset( &wr, 0, sizeof( struct wpoint ));
-  sctx->key.set_mask( &sctx->key );
   memset( r, 0, sizeof( ak_mpzn512 ));
-  memset( s, 0, sizeof( ak_mpzn512 ));
+  memset( rm, 0, sizeof( ak_mpzn512 ));
+  memset( km, 0, sizeof( ak_mpzn512 ));
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -676,6 +1295,7 @@
   size_t lb = 0;
   ak_mpzn512 k, h;
   int error = ak_error_ok;
+  ak_uint64 entry[3*ak_mpzn512_size];
  /* нужен нам для доступа к системному генератору случайных чисел */
   ak_context_manager manager = NULL;
 
@@ -688,6 +1308,22 @@
                                                             "using hash value with wrong length" );
   if( out_size < 2*lb ) return ak_error_message( ak_error_wrong_length, __func__,
                                                        "using small buffer for digital sigature" );
+  if( ak_signkey_context_use_resource( sctx, 1 ) != ak_error_ok )
+    return ak_error_message( ak_error_low_key_resource, __func__,
+                                                "using digital signature key with low resource" );
+
+ /* превращаем хеш от сообщения в последовательность 64х битных слов  */
+  memcpy( h, hash, sctx->ctx.data.sctx.hsize );
+#ifndef LIBAKRYPT_LITTLE_ENDIAN
+  for( i = 0; i < (( ak_wcurve )sctx->key.data)->size; i++ ) h[i] = bswap_64( h[i] );
+#endif
+
+ /* если пул содержит заранее вычисленные значения, то используем их */
+  if(( sctx->pool != NULL ) && ak_signkey_pool_get( sctx->pool, sctx->key.data, entry )) {
+    ak_signkey_context_sign_values( sctx, entry, entry+lb/8, entry+lb/4, h, out );
+    ak_ptr_context_wipe( entry, 3*lb, &sctx->key.generator );
+    return ak_error_ok;
+  }
 
  /* получаем доступ к генератору случайных чисел */
   if(( manager = ak_libakrypt_get_context_manager()) == NULL )
@@ -699,12 +1335,6 @@
                   (( ak_wcurve )sctx->key.data)->size, &manager->key_generator )) != ak_error_ok )
     return ak_error_message( error, __func__ , "invalid generation of random value");
 
- /* превращаем хеш от сообщения в последовательность 64х битных слов  */
-  memcpy( h, hash, sctx->ctx.data.sctx.hsize );
-#ifndef LIBAKRYPT_LITTLE_ENDIAN
-  for( i = 0; i < (( ak_wcurve )sctx->key.data)->size; i++ ) h[i] = bswap_64( h[i] );
-#endif
-
  /* и только теперь вычисляем электронную подпись */
   ak_signkey_context_sign_const_values( sctx, k, h, out );
   ak_ptr_context_wipe( k, sizeof( ak_uint64 )*ak_mpzn512_size, &sctx->key.generator );
@@ -785,12 +1415,273 @@
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*                     функции для работы с открытыми ключами электронной подписи                  */
-/* ----------------------------------------------------------------------------------------------- */
-/*! @param pctx Контекст открытого ключа электронной подписи
-    @param wc Контекст эллиптической кривой.
+/*! Функция начинает вычисление электронной подписи для данных, поступающих фрагментами,
+    например, из сетевого соединения или канала. Данные обрабатываются функциями
+    ak_signkey_context_update() и ak_signkey_context_finalize(); при этом хеш-код
+    вычисляется с помощью контекста функции хеширования, содержащегося в секретном ключе,
+    и сообщение целиком в памяти не хранится.
 
-    @return В случае успеха возвращается \ref ak_error_ok. В противном случае
+    \note Функции ak_signkey_context_sign_ptr() и ak_signkey_context_sign_file() используют
+    тот же контекст функции хеширования, поэтому их вызов прерывает начатое вычисление.
+
+    @param sctx Контекст секретного ключа алгоритма электронной подписи.
+    @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_context_clean( ak_signkey sctx )
+{
+  if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                      "using null pointer to secret key context" );
+ return ak_hash_context_clean( &sctx->ctx );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! @param sctx Контекст секретного ключа алгоритма электронной подписи.
+    @param in Указатель на очередной фрагмент подписываемых данных.
+    @param size Размер фрагмента в байтах. Размер может принимать произвольное значение.
+    @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_context_update( ak_signkey sctx, const ak_pointer in, const size_t size )
+{
+  if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                      "using null pointer to secret key context" );
+ return ak_hash_context_update( &sctx->ctx, in, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция обрабатывает последний фрагмент данных, завершает вычисление хеш-кода
+    и вырабатывает электронную подпись с помощью функции ak_signkey_context_sign_hash().
+    После выполнения функции контекст готов к обработке следующего сообщения.
+
+    @param sctx Контекст секретного ключа алгоритма электронной подписи.
+    @param in Указатель на последний фрагмент подписываемых данных (может быть NULL).
+    @param size Размер фрагмента в байтах.
+    @param out Область памяти, куда будет помещен результат. Память должна быть заранее выделена.
+    @param out_size Размер выделенной под выработанную ЭП памяти.
+    @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_context_finalize( ak_signkey sctx, const ak_pointer in, const size_t size,
+                                                                   ak_pointer out, size_t out_size )
+{
+  int error = ak_error_ok;
+  ak_uint8 hash[64];
+
+  if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                      "using null pointer to secret key context" );
+  if( sctx->ctx.data.sctx.hsize > sizeof( hash )) return ak_error_message( ak_error_wrong_length,
+                                __func__, "using hash function with very large hash code size" );
+  memset( hash, 0, sizeof( hash ));
+  if(( error = ak_hash_context_finalize( &sctx->ctx, in, size,
+                                                           hash, sizeof( hash ))) != ak_error_ok )
+    return ak_error_message( error, __func__, "wrong calculation of hash value" );
+  ak_hash_context_clean( &sctx->ctx );
+
+ return ak_signkey_context_sign_hash( sctx, hash, sctx->ctx.data.sctx.hsize, out, out_size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                              пакетная выработка электронной подписи                             */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество подписей, обрабатываемых функцией ak_signkey_context_sign_batch()
+    за один проход. */
+ #define ak_sign_batch_chunk_count   (64)
+/*! \brief Минимальное количество кратных точек, вычисляемых одним потоком. */
+ #define ak_sign_batch_thread_min_count   (8)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Фрагмент пакета, для которого вычисляются кратные образующей точки. */
+ struct sign_batch_task {
+ /*! \brief эллиптическая кривая */
+  ak_wcurve wc;
+ /*! \brief массив степеней кратности (каждая степень занимает ak_mpzn512_size слов) */
+  ak_uint64 *k;
+ /*! \brief массив вычисляемых точек */
+  ak_wpoint wp;
+ /*! \brief количество точек */
+  size_t count;
+};
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление кратных образующей точки для фрагмента пакета. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_signkey_context_sign_batch_task( struct sign_batch_task *task )
+{
+  size_t i = 0;
+  for( i = 0; i < task->count; i++ )
+     ak_wpoint_pow_base( task->wp+i, task->k + i*ak_mpzn512_size, task->wc->size, task->wc );
+}
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция потока, вычисляющего кратные точки для фрагмента пакета. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_signkey_context_sign_batch_thread( void *ptr )
+{
+  ak_signkey_context_sign_batch_task(( struct sign_batch_task * ) ptr );
+ return NULL;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление кратных образующей точки, при необходимости, несколькими потоками. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_signkey_context_sign_batch_points( ak_wcurve wc,
+                                                 ak_uint64 *k, ak_wpoint wp, const size_t count )
+{
+  size_t i = 0, threads = 1, offset = 0;
+  struct sign_batch_task tasks[ ak_sign_batch_chunk_count/ak_sign_batch_thread_min_count ];
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_t handles[ ak_sign_batch_chunk_count/ak_sign_batch_thread_min_count ];
+  bool_t started[ ak_sign_batch_chunk_count/ak_sign_batch_thread_min_count ];
+
+  threads = ak_min( count/ak_sign_batch_thread_min_count,
+             ( size_t ) ak_libakrypt_get_option_by_index( ak_option_sign_batch_thread_count ));
+  if( threads < 1 ) threads = 1;
+#endif
+  for( i = 0; i < threads; i++ ) {
+     tasks[i].wc = wc;
+     tasks[i].count = count/threads + ( i < count%threads ? 1 : 0 );
+     tasks[i].k = k + offset*ak_mpzn512_size;
+     tasks[i].wp = wp + offset;
+     offset += tasks[i].count;
+  }
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+ /* первый фрагмент обрабатывается в вызывающем потоке */
+  for( i = 1; i < threads; i++ )
+     started[i] = ( pthread_create( handles+i, NULL,
+                                      ak_signkey_context_sign_batch_thread, tasks+i ) == 0 );
+  ak_signkey_context_sign_batch_task( tasks );
+  for( i = 1; i < threads; i++ ) {
+     if( started[i] ) pthread_join( handles[i], NULL );
+      else ak_signkey_context_sign_batch_task( tasks+i );
+  }
+#else
+  ak_signkey_context_sign_batch_task( tasks );
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вырабатывает электронные подписи для `count` заранее вычисленных хеш-кодов
+    на одном секретном ключе. Результат совпадает с последовательным вызовом функции
+    ak_signkey_context_sign_hash(), однако общие для всех подписей действия выполняются
+    однократно:
+
+    \li ресурс ключа уменьшается на `count` за одно обращение к счетчику,
+    \li произведение ключа и его маски вычисляется один раз для всего пакета, а смена маски
+    ключа (см. ak_signkey_context_remask()) выполняется после выработки всех подписей,
+    \li если для ключа создан пул заранее вычисленных пар \f$ (k, r) \f$, то пары изымаются из пула,
+    \li остальные кратные точки \f$ [k]P \f$ вычисляются несколькими потоками (количество потоков
+    ограничено опцией `sign_batch_thread_count`) и приводятся к аффинной форме одним обращением
+    вычета с помощью функции ak_wpoint_reduce_batch().
+
+    @param sctx Контекст секретного ключа алгоритма электронной подписи.
+    @param hashes Последовательность хеш-кодов подписываемых сообщений; размер каждого хеш-кода
+    равен половине размера подписи (см. ak_signkey_context_get_tag_size()).
+    @param count Количество хеш-кодов.
+    @param out Область памяти, куда последовательно помещаются подписи.
+    @param out_size Размер области памяти `out`, должен быть не меньше произведения `count`
+    на размер подписи.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_context_sign_batch( ak_signkey sctx, const ak_pointer hashes,
+                                              const size_t count, ak_pointer out, size_t out_size )
+{
+#ifndef LIBAKRYPT_LITTLE_ENDIAN
+  size_t j = 0;
+#endif
+  ak_wcurve wc = NULL;
+  size_t i, n, len, lb = 0, offset = 0;
+  int error = ak_error_ok;
+  ak_mpzn512 dm, s, h;
+  size_t idx[ ak_sign_batch_chunk_count ];
+  struct wpoint wp[ ak_sign_batch_chunk_count ];
+  ak_uint64 k[ ak_sign_batch_chunk_count*ak_mpzn512_size ],
+            entry[ ak_sign_batch_chunk_count*3*ak_mpzn512_size ];
+ /* нужен нам для доступа к системному генератору случайных чисел */
+  ak_context_manager manager = NULL;
+
+  if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                      "using null pointer to secret key context" );
+  if( hashes == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                             "using null pointer to hash values" );
+  if( out == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                    "using null pointer to digital signatures" );
+  if( count == 0 ) return ak_error_ok;
+  wc = ( ak_wcurve ) sctx->key.data;
+  lb = sizeof( ak_uint64 )*wc->size;
+  if( out_size/( 2*lb ) < count ) return ak_error_message( ak_error_wrong_length, __func__,
+                                                      "using small buffer for digital sigatures" );
+  if(( manager = ak_libakrypt_get_context_manager()) == NULL )
+    return ak_error_message( ak_error_null_pointer, __func__,
+                                                "using null pointer to internal context manager" );
+  if( ak_signkey_context_use_resource( sctx, count ) != ak_error_ok )
+    return ak_error_message( ak_error_low_key_resource, __func__,
+                                                "using digital signature key with low resource" );
+
+ /* вычисляем произведение ключа на его маску один раз для всего пакета */
+  ak_mpzn_mul_montgomery( dm, (ak_uint64 *)sctx->key.key,
+              (ak_uint64 *)(sctx->key.key+sctx->key.key_size), wc->q, wc->nq, wc->size );
+
+  for( offset = 0; offset < count; offset += len ) {
+     len = ak_min( count - offset, ak_sign_batch_chunk_count );
+
+    /* изымаем пары из пула, для остальных подписей вырабатываем случайные числа */
+     for( i = 0, n = 0; i < len; i++ ) {
+        ak_uint64 *ptr = entry + 3*i*wc->size;
+        if(( sctx->pool != NULL ) && ak_signkey_pool_get( sctx->pool, wc, ptr )) continue;
+        memset( k + n*ak_mpzn512_size, 0, sizeof( ak_mpzn512 ));
+        if(( error = ak_mpzn_set_random_modulo( k + n*ak_mpzn512_size,
+                                  wc->q, wc->size, &manager->key_generator )) != ak_error_ok ) {
+          ak_error_message( error, __func__ , "invalid generation of random value" );
+          goto labex;
+        }
+        idx[n++] = i;
+     }
+
+    /* вычисляем кратные точки и одновременно приводим их к аффинной форме */
+     ak_signkey_context_sign_batch_points( wc, k, wp, n );
+     ak_wpoint_reduce_batch( wp, n, wc );
+     for( i = 0; i < n; i++ ) {
+        ak_uint64 *ptr = entry + 3*idx[i]*wc->size;
+        ak_mpzn_rem( ptr, wp[i].x, wc->q, wc->size );
+        ak_mpzn_mul_montgomery( ptr+wc->size, ptr, wc->r2q, wc->q, wc->nq, wc->size );
+        ak_mpzn_mul_montgomery( ptr+2*wc->size,
+                               k + i*ak_mpzn512_size, wc->r2q, wc->q, wc->nq, wc->size );
+     }
+
+    /* вычисляем подписи */
+     for( i = 0; i < len; i++ ) {
+        ak_uint64 *ptr = entry + 3*i*wc->size;
+        memcpy( h, ( ak_uint8 * )hashes + ( offset+i )*lb, lb );
+#ifndef LIBAKRYPT_LITTLE_ENDIAN
+        for( j = 0; j < wc->size; j++ ) h[j] = bswap_64( h[j] );
+#endif
+        ak_mpzn_mul_montgomery( s, ptr+wc->size, dm, wc->q, wc->nq, wc->size );
+        ak_signkey_context_sign_values_rd( wc, s, ptr, ptr+2*wc->size, h,
+                                                        ( ak_uint8 * )out + 2*( offset+i )*lb );
+     }
+  }
+
+  labex:
+   ak_ptr_context_wipe( k, sizeof( k ), &sctx->key.generator );
+   ak_ptr_context_wipe( entry, sizeof( entry ), &sctx->key.generator );
+   ak_ptr_context_wipe( dm, sizeof( ak_mpzn512 ), &sctx->key.generator );
+   memset( s, 0, sizeof( ak_mpzn512 ));
+   memset( wp, 0, sizeof( wp ));
+   ak_signkey_context_remask( sctx, count );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                     функции для работы с открытыми ключами электронной подписи                  */
+/* ----------------------------------------------------------------------------------------------- */
+/*! @param pctx Контекст открытого ключа электронной подписи
+    @param wc Контекст эллиптической кривой.
+
+    @return В случае успеха возвращается \ref ak_error_ok. В противном случае
     возвращается код ошибки.                                                                       */
 /* ----------------------------------------------------------------------------------------------- */
  int ak_verifykey_context_create( ak_verifykey pctx, const ak_wcurve wc )
@@ -878,6 +1769,12 @@
   ak_wpoint_pow( &pctx->qpoint, &pctx->qpoint, k, pctx->wc->size, pctx->wc );
   ak_wpoint_reduce( &pctx->qpoint, pctx->wc );
 
+ /* вычисляем таблицу нечетных кратных, используемую при проверке подписи */
+  if(( error = ak_verifykey_context_precompute_table( pctx )) != ak_error_ok ) {
+    ak_verifykey_context_destroy( pctx );
+    return ak_error_message( error, __func__, "incorrect computation of public key table" );
+  }
+
  /* разбираемся с ресурсом */
   pctx->time.not_before = sctx->key.resource.time.not_before;
   pctx->time.not_after = sctx->key.resource.time.not_after;
@@ -931,6 +1828,50 @@
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет нечетные кратные \f$ Q, [3]Q, \ldots, [2^{w-1}-1]Q \f$ точки \f$ Q \f$,
+    являющейся открытым ключом, и сохраняет их в контексте открытого ключа. Таблица используется
+    всеми последующими вызовами функции ak_verifykey_context_verify_hash(), что позволяет
+    не вычислять кратные точки при каждой проверке подписи.
+
+    Ширина окна \f$ w \f$ определяется опцией `verifykey_wnaf_width`; таблица занимает
+    \f$ 2^{w-2} \f$ точек кривой. Если значение опции меньше трех, то ранее вычисленная
+    таблица удаляется и при проверке подписи таблица не используется.
+
+    Таблица вычисляется при создании открытого ключа функцией
+    ak_verifykey_context_create_from_signkey() и при импорте открытого ключа; функции проверки
+    подписи таблицу не изменяют, что позволяет использовать один контекст открытого ключа
+    в нескольких потоках одновременно. Функция должна вызываться повторно, если значение
+    открытого ключа или опции `verifykey_wnaf_width` было изменено.
+
+    \param pctx Контекст открытого ключа.
+    \return В случае успеха функция возвращает \ref ak_error_ok. В противном случае,
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_verifykey_context_precompute_table( ak_verifykey pctx )
+{
+  size_t width = 0, count = 0;
+
+  if( pctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                            "using a null pointer to public key" );
+  if( pctx->table != NULL ) {
+    free( pctx->table );
+    pctx->table = NULL;
+    pctx->table_width = 0;
+  }
+  if(( width = ( size_t ) ak_libakrypt_get_option_by_index( ak_option_verifykey_wnaf_width )) < 3 )
+    return ak_error_ok;
+
+  count = ( size_t )1 << ( width-2 );
+  if(( pctx->table = malloc( count*sizeof( struct wpoint ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                               "incorrect memory allocation for public key table" );
+  ak_wpoint_odd_multiples( pctx->table, count, &pctx->qpoint, ak_true, pctx->wc );
+  pctx->table_width = width;
+
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param pctx контекст открытого ключа алгоритма электронной подписи.
     @return В случае успеха возвращается ноль (\ref ak_error_ok). В противном случае возвращается
@@ -946,6 +1887,8 @@
 
  /* если обобщенное имя владельца было определено, то удаляем его */
   if( pctx->name != NULL ) pctx->name = ak_tlv_context_delete( pctx->name );
+ /* удаляем таблицу нечетных кратных открытого ключа */
+  if( pctx->table != NULL ) free( pctx->table );
 
   memset( pctx, 0, sizeof( struct verifykey ));
  return error;
@@ -966,11 +1909,116 @@
  return NULL;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция считывает значения подписи \f$ (r, s) \f$ и вычисляет вычет
+    \f$ e \equiv h \pmod{q} \f$, соответствующий хеш-коду \f$ h \f$, в представлении Монтгомери.
+    \details Проверка корректности аргументов функции не производится.                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_verifykey_context_import_values( ak_verifykey pctx, const ak_pointer hash,
+                              ak_pointer sign, ak_uint64 *e, ak_uint64 *r, ak_uint64 *s )
+{
+#ifndef LIBAKRYPT_LITTLE_ENDIAN
+  int i = 0;
+#endif
+  ak_mpzn512 h;
+
+ /* импортируем подпись */
+  ak_mpzn_set_little_endian( s, pctx->wc->size, sign, sizeof(ak_uint64)*pctx->wc->size, ak_true );
+  ak_mpzn_set_little_endian( r, pctx->wc->size, ( ak_uint64* )sign + pctx->wc->size,
+                                                      sizeof(ak_uint64)*pctx->wc->size, ak_true );
+
+  memcpy( h, hash, sizeof( ak_uint64 )*pctx->wc->size );
+#ifndef LIBAKRYPT_LITTLE_ENDIAN
+  for( i = 0; i < pctx->wc->size; i++ ) h[i] = bswap_64( h[i] );
+#endif
+
+  ak_mpzn_set( e, h, pctx->wc->size );
+  ak_mpzn_rem( e, e, pctx->wc->q, pctx->wc->size );
+  if( ak_mpzn_cmp_ui( e, pctx->wc->size, 0 )) ak_mpzn_set_ui( e, pctx->wc->size, 1 );
+  ak_mpzn_mul_montgomery( e, e, pctx->wc->r2q, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет, что значения подписи \f$ r \f$ и \f$ s \f$ принадлежат
+    интервалу \f$ (0, q) \f$.
+    \details Проверка выполняется до вычисления точек; без нее, например, нулевая подпись
+    \f$ r = s = 0 \f$ принимается для любого хеш-кода, поскольку \f$ [0]P + [0]Q = \mathcal O \f$.
+    Функция используется всеми способами проверки подписи, что обеспечивает совпадение
+    результатов одиночной, пакетной проверки и проверки цепочки сертификатов.
+
+    @param wc Эллиптическая кривая.
+    @param r Первая часть подписи.
+    @param s Вторая часть подписи.
+    @return Функция возвращает истину, если значения принадлежат интервалу.                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_verifykey_context_check_values( ak_wcurve wc, ak_uint64 *r, ak_uint64 *s )
+{
+  if( ak_mpzn_cmp_ui( r, wc->size, 0 ) || ak_mpzn_cmp_ui( s, wc->size, 0 )) return ak_false;
+  if(( ak_mpzn_cmp( r, wc->q, wc->size ) >= 0 ) ||
+     ( ak_mpzn_cmp( s, wc->q, wc->size ) >= 0 )) return ak_false;
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет степени кратности \f$ z_1 \equiv sv \pmod{q} \f$ и
+    \f$ z_2 \equiv -rv \pmod{q} \f$, где \f$ v \equiv e^{-1} \pmod{q} \f$.
+
+    @param pctx Контекст открытого ключа.
+    @param v Вычет \f$ v \f$ в представлении Монтгомери.
+    @param r Первая часть подписи.
+    @param s Вторая часть подписи.
+    @param z1 Вычет \f$ z_1 \f$ (в естественном представлении).
+    @param z2 Вычет \f$ z_2 \f$ (в естественном представлении).                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_verifykey_context_verify_scalars( ak_verifykey pctx, ak_uint64 *v,
+                                    ak_uint64 *r, ak_uint64 *s, ak_uint64 *z1, ak_uint64 *z2 )
+{
+  /* вычисляем z1 */
+  ak_mpzn_mul_montgomery( z1, s, pctx->wc->r2q, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
+  ak_mpzn_mul_montgomery( z1, z1, v, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
+  ak_mpzn_mul_montgomery( z1, z1, pctx->wc->point.z, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
+
+  /* вычисляем z2 */
+  ak_mpzn_mul_montgomery( z2, r, pctx->wc->r2q, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
+  ak_mpzn_sub( z2, pctx->wc->q, z2, pctx->wc->size );
+  ak_mpzn_mul_montgomery( z2, z2, v, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
+  ak_mpzn_mul_montgomery( z2, z2, pctx->wc->point.z, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет точку \f$ C = [z_1]P + [z_2]Q \f$, где \f$ z_1 \equiv sv \pmod{q} \f$,
+    \f$ z_2 \equiv -rv \pmod{q} \f$, а \f$ v \equiv e^{-1} \pmod{q} \f$.
+    \details Если контекст открытого ключа содержит таблицу нечетных кратных, то она
+    используется при вычислениях; новая таблица функцией не вычисляется.
+
+    @param pctx Контекст открытого ключа.
+    @param v Вычет \f$ v \f$ в представлении Монтгомери.
+    @param r Первая часть подписи.
+    @param s Вторая часть подписи.
+    @param cpoint Точка \f$ C \f$, в которую помещается результат (в проективной форме).          */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_verifykey_context_verify_point( ak_verifykey pctx, ak_uint64 *v,
+                                                  ak_uint64 *r, ak_uint64 *s, ak_wpoint cpoint )
+{
+  ak_mpzn512 z1, z2;
+
+  ak_verifykey_context_verify_scalars( pctx, v, r, s, z1, z2 );
+
+ /* сложение точек */
+  if( pctx->table != NULL )
+    ak_wpoint_pow_joint_table( cpoint, z1, pctx->table, pctx->table_width,
+                                                                 z2, pctx->wc->size, pctx->wc );
+   else ak_wpoint_pow_joint( cpoint, z1, &pctx->qpoint, z2, pctx->wc->size, pctx->wc );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param pctx контекст открытого ключа.
     @param hash хеш-код сообщения (последовательность байт), для которого проверяется электронная подпись.
     @param hsize размер хеш-кода, в байтах.
     @param sign электронная подпись, для которой выполняется проверка.
+    Подпись считается неверной, если значения \f$ r \f$ или \f$ s \f$ не принадлежат
+    интервалу \f$ (0, q) \f$; в этом случае вычисление точек не выполняется.
+
     @return Функция возыращает истину, если подпись верна. Если функция не верна или если
     возникла ошибка, то возвращается ложь. Код Ошибки может получен с помощью
     вызова функции ak_error_get_value().                                                           */
@@ -978,11 +2026,8 @@
  bool_t ak_verifykey_context_verify_hash( ak_verifykey pctx,
                                         const ak_pointer hash, const size_t hsize, ak_pointer sign )
 {
-#ifndef LIBAKRYPT_LITTLE_ENDIAN
-  int i = 0;
-#endif
-  ak_mpzn512 v, z1, z2, u, r, s, h;
-  struct wpoint cpoint, tpoint;
+  ak_mpzn512 v, r, s;
+  struct wpoint cpoint;
 
   if( pctx == NULL ) {
     ak_error_message( ak_error_null_pointer, __func__,
@@ -1002,41 +2047,15 @@
     return ak_false;
   }
 
- /* импортируем подпись */
-  ak_mpzn_set_little_endian( s, pctx->wc->size, sign, sizeof(ak_uint64)*pctx->wc->size, ak_true );
-  ak_mpzn_set_little_endian( r, pctx->wc->size, ( ak_uint64* )sign + pctx->wc->size,
-                                                      sizeof(ak_uint64)*pctx->wc->size, ak_true );
-
-  memcpy( h, hash, sizeof( ak_uint64 )*pctx->wc->size );
-#ifndef LIBAKRYPT_LITTLE_ENDIAN
-  for( i = 0; i < pctx->wc->size; i++ ) h[i] = bswap_64( h[i] );
-#endif
-
-  ak_mpzn_set( v, h, pctx->wc->size );
-  ak_mpzn_rem( v, v, pctx->wc->q, pctx->wc->size );
-  if( ak_mpzn_cmp_ui( v, pctx->wc->size, 0 )) ak_mpzn_set_ui( v, pctx->wc->size, 1 );
-  ak_mpzn_mul_montgomery( v, v, pctx->wc->r2q, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
+ /* импортируем подпись и хеш-код */
+  ak_verifykey_context_import_values( pctx, hash, sign, v, r, s );
+  if( !ak_verifykey_context_check_values( pctx->wc, r, s )) return ak_false;
 
   /* вычисляем v (в представлении Монтгомери) */
-  ak_mpzn_set_ui( u, pctx->wc->size, 2 );
-  ak_mpzn_sub( u, pctx->wc->q, u, pctx->wc->size );
-  ak_mpzn_modpow_montgomery( v, v, u, pctx->wc->q, pctx->wc->nq, pctx->wc->size ); // v <- v^{q-2} (mod q)
-
-  /* вычисляем z1 */
-  ak_mpzn_mul_montgomery( z1, s, pctx->wc->r2q, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
-  ak_mpzn_mul_montgomery( z1, z1, v, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
-  ak_mpzn_mul_montgomery( z1, z1, pctx->wc->point.z, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
-
-  /* вычисляем z2 */
-  ak_mpzn_mul_montgomery( z2, r, pctx->wc->r2q, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
-  ak_mpzn_sub( z2, pctx->wc->q, z2, pctx->wc->size );
-  ak_mpzn_mul_montgomery( z2, z2, v, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
-  ak_mpzn_mul_montgomery( z2, z2, pctx->wc->point.z, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
+  ak_mpzn_inverse_montgomery( v, v, pctx->wc->q, pctx->wc->nq, pctx->wc->r2q, pctx->wc->size );
 
  /* сложение точек и проверка */
-  ak_wpoint_pow( &cpoint, &pctx->wc->point, z1, pctx->wc->size, pctx->wc );
-  ak_wpoint_pow( &tpoint, &pctx->qpoint, z2, pctx->wc->size, pctx->wc );
-  ak_wpoint_add( &cpoint, &tpoint, pctx->wc );
+  ak_verifykey_context_verify_point( pctx, v, r, s, &cpoint );
   ak_wpoint_reduce( &cpoint, pctx->wc );
   ak_mpzn_rem( cpoint.x, cpoint.x, pctx->wc->q, pctx->wc->size );
 
@@ -1047,6 +2066,593 @@
  return ak_true;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                              пакетная проверка электронной подписи                              */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Минимальное количество подписей, проверяемых одним потоком. */
+ #define ak_verify_batch_thread_min_count   (16)
+/*! \brief Максимальное количество потоков, используемых при проверке пакета подписей. */
+ #define ak_verify_batch_thread_max_count   (64)
+/*! \brief Минимальное количество подписей одной кривой, точки которых вычисляются векторной
+    реализацией одновременно; меньшие группы проверяются последовательно. */
+ #define ak_verify_batch_lanes_min_count     (3)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Фрагмент пакета подписей, проверяемый одним потоком. */
+ struct verify_batch_task {
+  /*! \brief Проверяемые подписи. */
+   ak_verify_batch_item items;
+  /*! \brief Количество проверяемых подписей. */
+   size_t count;
+  /*! \brief Массив вычетов \f$ e \f$ (а после обращения -- вычетов \f$ v = e^{-1}\f$). */
+   ak_uint64 *v;
+  /*! \brief Массив произведений вычетов \f$ e \f$. */
+   ak_uint64 *w;
+  /*! \brief Массив индексов подписей, принадлежащих одной кривой. */
+   size_t *group;
+  /*! \brief Массив состояний подписей: ноль -- подпись неверна, единица -- вычислен вычет
+      \f$ e \f$, двойка -- вычислен вычет \f$ v \f$, тройка -- подпись проверена. */
+   ak_uint8 *state;
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет, что аффинная \f$ x \f$-координата точки \f$ C \f$, взятая по
+    модулю \f$ q \f$, совпадает с \f$ r \f$.
+    \details Вместо приведения точки к аффинной форме проверяются сравнения
+    \f$ x \equiv (r + tq)z \pmod{p} \f$ для всех \f$ t \geq 0 \f$, удовлетворяющих
+    неравенству \f$ r + tq < p \f$; это позволяет обойтись без обращения \f$ z \f$.         */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_verifykey_context_check_point( ak_wpoint cpoint, ak_uint64 *r, ak_wcurve wc )
+{
+  ak_mpzn512 c, u;
+
+  if( ak_mpzn_cmp_ui( cpoint->z, wc->size, 0 )) return ak_false;
+  ak_mpzn_set( c, r, wc->size );
+  while( ak_mpzn_cmp( c, wc->p, wc->size ) < 0 ) {
+    ak_wcurve_mul( u, c, wc->r2, wc );
+    ak_wcurve_mul( u, u, cpoint->z, wc );
+    if( ak_mpzn_cmp( u, cpoint->x, wc->size ) == 0 ) return ak_true;
+    if( ak_mpzn_add( c, c, wc->q, wc->size )) break;
+  }
+ return ak_false;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция одновременно проверяет до \ref ak_wpoint_lanes_count подписей фрагмента,
+    начиная с подписи с заданным индексом, которые проверяются на той же кривой.
+    \details Точки \f$ C = [z_1]P + [z_2]Q \f$ для всех подписей группы вычисляются
+    векторной реализацией функцией ak_wpoint_pow_joint_lanes(). Проверенные подписи отмечаются
+    состоянием 3; если группа слишком мала или векторная реализация недоступна,
+    то состояния подписей не изменяются.                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_verifykey_context_verify_batch_lanes( struct verify_batch_task *task,
+                                                                               const size_t start )
+{
+  ak_mpzn512 u, s;
+  size_t j, m = 0, index[ ak_wpoint_lanes_count ];
+  ak_wcurve wc = task->items[start].key->wc;
+  ak_verify_batch_item items = task->items;
+  ak_wpoint qpoints[ ak_wpoint_lanes_count ];
+  struct wpoint cpoints[ ak_wpoint_lanes_count ];
+  ak_uint64 r[ ak_wpoint_lanes_count*ak_mpzn512_size ],
+           z1[ ak_wpoint_lanes_count*ak_mpzn512_size ], z2[ ak_wpoint_lanes_count*ak_mpzn512_size ];
+
+  for( j = start; ( j < task->count ) && ( m < ak_wpoint_lanes_count ); j++ ) {
+     ak_verifykey pctx = items[j].key;
+     if(( task->state[j] != 2 ) || ( pctx->wc != wc )) continue;
+
+     ak_verifykey_context_import_values( pctx, items[j].hash, items[j].sign,
+                                                               u, r + m*ak_mpzn512_size, s );
+     ak_verifykey_context_verify_scalars( pctx, task->v + j*ak_mpzn512_size,
+                     r + m*ak_mpzn512_size, s, z1 + m*ak_mpzn512_size, z2 + m*ak_mpzn512_size );
+     qpoints[m] = &pctx->qpoint;
+     index[m++] = j;
+  }
+  if( m < ak_verify_batch_lanes_min_count ) return;
+  if( ak_wpoint_pow_joint_lanes( cpoints, z1, qpoints, z2, m, wc ) != ak_error_ok ) return;
+
+  for( j = 0; j < m; j++ ) {
+     items[index[j]].result =
+                   ak_verifykey_context_check_point( cpoints+j, r + j*ak_mpzn512_size, wc );
+     task->state[index[j]] = 3;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет фрагмент пакета электронных подписей.
+    \details Вычеты \f$ v = e^{-1} \pmod{q} \f$ для всех подписей, проверяемых на одной кривой,
+    вычисляются одновременно с помощью метода Монтгомери: одно обращение и
+    \f$ 3(m-1) \f$ умножений вместо \f$ m \f$ возведений в степень.                                */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_verifykey_context_verify_batch_task( struct verify_batch_task *task )
+{
+  ak_wcurve wc = NULL;
+  struct wpoint cpoint;
+  ak_mpzn512 r, s, u, inv, tmp;
+  bool_t lanes = ak_false;
+  size_t i, j, m, size = ak_mpzn512_size;
+  ak_uint8 *state = task->state;
+  ak_verify_batch_item items = task->items;
+
+ /* проверяем корректность аргументов и вычисляем вычеты e */
+  for( i = 0; i < task->count; i++ ) {
+     ak_verifykey pctx = items[i].key;
+     items[i].result = ak_false;
+     state[i] = 0;
+     if(( pctx == NULL ) || ( pctx->wc == NULL ) ||
+        ( items[i].hash == NULL ) || ( items[i].sign == NULL )) continue;
+     if( items[i].hsize != sizeof( ak_uint64 )*pctx->wc->size ) continue;
+
+     ak_verifykey_context_import_values( pctx, items[i].hash, items[i].sign,
+                                                                      task->v + i*size, r, s );
+     if( !ak_verifykey_context_check_values( pctx->wc, r, s )) continue;
+     state[i] = 1;
+  }
+
+ /* для каждой кривой обращаем все вычеты e одновременно */
+  for( i = 0; i < task->count; i++ ) {
+     if( state[i] != 1 ) continue;
+     wc = items[i].key->wc;
+
+    /* формируем группу подписей и вычисляем произведения w_j = e_0e_1...e_j */
+     for( j = i, m = 0; j < task->count; j++ ) {
+        if(( state[j] != 1 ) || ( items[j].key->wc != wc )) continue;
+        if( m == 0 ) ak_mpzn_set( task->w + j*size, task->v + j*size, wc->size );
+         else ak_mpzn_mul_montgomery( task->w + j*size, task->w + task->group[m-1]*size,
+                                                   task->v + j*size, wc->q, wc->nq, wc->size );
+        task->group[m++] = j;
+     }
+
+    /* обращаем произведение всех вычетов */
+     ak_mpzn_inverse_montgomery( inv, task->w + task->group[m-1]*size,
+                                                         wc->q, wc->nq, wc->r2q, wc->size );
+
+    /* вычисляем обратные значения: e_j^{-1} = w_j^{-1}w_{j-1} и w_{j-1}^{-1} = w_j^{-1}e_j */
+     for( j = m-1; j > 0; j-- ) {
+        ak_uint64 *e = task->v + task->group[j]*size;
+        ak_mpzn_mul_montgomery( tmp, inv, task->w + task->group[j-1]*size,
+                                                                     wc->q, wc->nq, wc->size );
+        ak_mpzn_mul_montgomery( inv, inv, e, wc->q, wc->nq, wc->size );
+        ak_mpzn_set( e, tmp, wc->size );
+        state[task->group[j]] = 2;
+     }
+     ak_mpzn_set( task->v + task->group[0]*size, inv, wc->size );
+     state[task->group[0]] = 2;
+  }
+
+ /* вычисляем точки и проверяем подписи; при возможности точки для подписей одной кривой
+    вычисляются векторной реализацией одновременно */
+  lanes = ( ak_libakrypt_get_option_by_index( ak_option_verify_batch_lanes ) != 0 );
+  for( i = 0; i < task->count; i++ ) {
+     ak_verifykey pctx = items[i].key;
+     if( state[i] != 2 ) continue;
+     if( lanes && ak_wcurve_lanes_is_available( pctx->wc )) {
+       ak_verifykey_context_verify_batch_lanes( task, i );
+       if( state[i] != 2 ) continue;
+     }
+
+     ak_verifykey_context_import_values( pctx, items[i].hash, items[i].sign, u, r, s );
+     ak_verifykey_context_verify_point( pctx, task->v + i*size, r, s, &cpoint );
+     items[i].result = ak_verifykey_context_check_point( &cpoint, r, pctx->wc );
+  }
+}
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция потока, проверяющего фрагмент пакета электронных подписей. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_verifykey_context_verify_batch_thread( void *ptr )
+{
+  ak_verifykey_context_verify_batch_task(( struct verify_batch_task * ) ptr );
+ return NULL;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция проверяет пакет электронных подписей, каждая из которых задается тройкой
+    (открытый ключ, хеш-код, подпись), и помещает результат проверки каждой подписи в поле
+    `result` соответствующего элемента пакета. Подписи пакета могут быть выработаны на разных
+    ключах и на разных эллиптических кривых.
+
+    По сравнению с последовательным вызовом функции ak_verifykey_context_verify_hash()
+    \li вычеты \f$ v = e^{-1} \pmod{q} \f$ всех подписей, проверяемых на одной кривой,
+    вычисляются одним обращением с помощью метода Монтгомери,
+    \li вычисленные точки не приводятся к аффинной форме: \f$ x \f$-координата точки сравнивается
+    со значением \f$ r \f$ в проективных координатах,
+    \li если процессор поддерживает инструкции AVX-512 IFMA, то точки для подписей,
+    проверяемых на одной кривой, вычисляются одновременно группами по \ref ak_wpoint_lanes_count
+    подписей функцией ak_wpoint_pow_joint_lanes(); использование векторной реализации
+    определяется опцией `verify_batch_lanes`. В противном случае точки вычисляются по одной
+    с вычетами по основанию \f$ 2^{64} \f$: функцией ak_wpoint_pow_joint_table(), если
+    в контексте открытого ключа вычислена таблица кратных точек (поле `table` отлично от NULL),
+    и функцией ak_wpoint_pow_joint() в противном случае (векторная реализация для процессоров,
+    поддерживающих только AVX2, отсутствует),
+    \li если пакет содержит достаточно много подписей, то проверка выполняется несколькими
+    потоками; количество потоков ограничено опцией `verify_batch_thread_count`.
+
+    Подпись считается неверной, если хотя бы один из элементов тройки не определен,
+    длина хеш-кода не соответствует ключу, либо значения \f$ r \f$ или \f$ s \f$ не принадлежат
+    интервалу \f$ (0, q) \f$.
+
+    @param items Массив проверяемых подписей.
+    @param count Количество элементов массива.
+    @return В случае успеха функция возвращает \ref ak_error_ok. При этом значения
+    результатов проверки подписей помещаются в поля `result` элементов массива.
+    В противном случае возвращается код ошибки, а все подписи считаются неверными.                */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_verifykey_context_verify_batch( ak_verify_batch_item items, const size_t count )
+{
+  ak_uint64 *values = NULL;
+  ak_uint8 *state = NULL;
+  size_t i, threads = 1, *group = NULL;
+  struct verify_batch_task tasks[ ak_verify_batch_thread_max_count ];
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  size_t offset = 0;
+  pthread_t handles[ ak_verify_batch_thread_max_count ];
+  bool_t started[ ak_verify_batch_thread_max_count ];
+#endif
+
+  if( items == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                   "using a null pointer to array of signatures" );
+  if( count == 0 ) return ak_error_ok;
+  for( i = 0; i < count; i++ ) items[i].result = ak_false;
+
+  if(( values = malloc( 2*count*sizeof( ak_mpzn512 ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                                            "incorrect memory allocation" );
+  if(( group = malloc( count*( sizeof( size_t ) + 1 ))) == NULL ) {
+    free( values );
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                                            "incorrect memory allocation" );
+  }
+  state = ( ak_uint8 * )( group + count );
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  threads = ak_min( count/ak_verify_batch_thread_min_count, ak_verify_batch_thread_max_count );
+  threads = ak_min( threads,
+             ( size_t ) ak_libakrypt_get_option_by_index( ak_option_verify_batch_thread_count ));
+  if( threads < 1 ) threads = 1;
+  for( i = 0; i < threads; i++ ) {
+     size_t len = count/threads + ( i < count%threads ? 1 : 0 );
+     tasks[i].items = items + offset;
+     tasks[i].count = len;
+     tasks[i].v = values + offset*ak_mpzn512_size;
+     tasks[i].w = values + ( count + offset )*ak_mpzn512_size;
+     tasks[i].group = group + offset;
+     tasks[i].state = state + offset;
+     offset += len;
+  }
+ /* первый фрагмент проверяется в вызывающем потоке */
+  for( i = 1; i < threads; i++ )
+     started[i] = ( pthread_create( handles+i, NULL,
+                               ak_verifykey_context_verify_batch_thread, tasks+i ) == 0 );
+  ak_verifykey_context_verify_batch_task( tasks );
+  for( i = 1; i < threads; i++ ) {
+     if( started[i] ) pthread_join( handles[i], NULL );
+      else ak_verifykey_context_verify_batch_task( tasks+i );
+  }
+#else
+  tasks[0].items = items;
+  tasks[0].count = count;
+  tasks[0].v = values;
+  tasks[0].w = values + count*ak_mpzn512_size;
+  tasks[0].group = group;
+  tasks[0].state = state;
+  ak_verifykey_context_verify_batch_task( tasks );
+#endif
+
+  free( group );
+  free( values );
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                        проверка открытых ключей и цепочек сертификатов                          */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество открытых ключей, результаты проверки которых хранятся в кэше. */
+ #define ak_verifykey_check_cache_max_size  (64)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Элемент кэша открытых ключей, для которых выполнены проверки принадлежности точки
+    кривой и равенства ее порядка величине \f$ q \f$. */
+ struct verifykey_check_entry {
+  /*! \brief Эллиптическая кривая (NULL соответствует пустому элементу). */
+   ak_wcurve wc;
+  /*! \brief Аффинная \f$ x \f$-координата точки. */
+   ak_mpzn512 x;
+  /*! \brief Аффинная \f$ y \f$-координата точки. */
+   ak_mpzn512 y;
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Кэш проверенных открытых ключей. */
+ static struct verifykey_check_entry verifykey_check_cache[ ak_verifykey_check_cache_max_size ];
+/*! \brief Индекс элемента кэша, который будет заменен при добавлении нового ключа. */
+ static size_t verifykey_check_cache_next = 0;
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+ static pthread_mutex_t verifykey_check_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция ищет в кэше точку, заданную в аффинной форме, либо добавляет ее в кэш.
+    @param wp Точка кривой в аффинной форме.
+    @param wc Эллиптическая кривая.
+    @param add Если значение истинно, то точка добавляется в кэш (при заполненном кэше
+    заменяется наиболее давно добавленный элемент).
+    @return Функция возвращает истину, если точка содержится в кэше.                               */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_verifykey_check_cache_lookup( ak_wpoint wp, ak_wcurve wc, bool_t add )
+{
+  size_t idx = 0;
+  bool_t result = ak_false;
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &verifykey_check_cache_mutex );
+#endif
+  for( idx = 0; idx < ak_verifykey_check_cache_max_size; idx++ ) {
+     struct verifykey_check_entry *entry = verifykey_check_cache + idx;
+     if(( entry->wc == wc ) && ( ak_mpzn_cmp( entry->x, wp->x, wc->size ) == 0 ) &&
+        ( ak_mpzn_cmp( entry->y, wp->y, wc->size ) == 0 )) {
+       result = ak_true;
+       break;
+     }
+  }
+  if(( result != ak_true ) && add ) {
+    struct verifykey_check_entry *entry = verifykey_check_cache + verifykey_check_cache_next;
+    entry->wc = wc;
+    ak_mpzn_set( entry->x, wp->x, wc->size );
+    ak_mpzn_set( entry->y, wp->y, wc->size );
+    verifykey_check_cache_next = ( verifykey_check_cache_next + 1 )%
+                                                                ak_verifykey_check_cache_max_size;
+    result = ak_true;
+  }
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &verifykey_check_cache_mutex );
+#endif
+
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция удаляет из кэша результаты проверки всех открытых ключей.
+    Вызывается при завершении работы с библиотекой.
+
+    @return Функция возвращает \ref ak_error_ok (ноль).                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_verifykey_check_cache_clear( void )
+{
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &verifykey_check_cache_mutex );
+#endif
+  memset( verifykey_check_cache, 0, sizeof( verifykey_check_cache ));
+  verifykey_check_cache_next = 0;
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &verifykey_check_cache_mutex );
+#endif
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет, что открытый ключ является точкой кривой порядка \f$ q \f$.
+    \details Флаги контекста открытого ключа функцией не изменяются, что позволяет проверять
+    ключ одновременно с проверкой подписей, выполняемой другими потоками.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_verifykey_context_check_qpoint( ak_verifykey pctx )
+{
+  struct wpoint wp;
+
+  if( ak_mpzn_cmp_ui( pctx->qpoint.z, pctx->wc->size, 0 ))
+    return ak_error_message( ak_error_curve_point, __func__,
+                                               "the public key is equal to the point at infinity" );
+
+  ak_wpoint_set_wpoint( &wp, &pctx->qpoint, pctx->wc );
+  ak_wpoint_reduce( &wp, pctx->wc );
+  if( ak_verifykey_check_cache_lookup( &wp, pctx->wc, ak_false )) return ak_error_ok;
+
+  if( ak_wpoint_is_ok( &wp, pctx->wc ) != ak_true )
+    return ak_error_message( ak_error_curve_point, __func__,
+                                                   "the public key isn't on given elliptic curve" );
+ /* если кофактор равен единице, то порядок группы точек равен q и
+    любая отличная от бесконечно удаленной точка кривой имеет порядок q */
+  if(( pctx->wc->cofactor != 1 ) && ( ak_wpoint_check_order( &wp, pctx->wc ) != ak_true ))
+    return ak_error_message( ak_error_curve_point_order, __func__,
+                                                    "the public key has wrong order of the point" );
+  ak_verifykey_check_cache_lookup( &wp, pctx->wc, ak_true );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция проверяет, что точка \f$ Q \f$, являющаяся открытым ключом, принадлежит
+    эллиптической кривой и удовлетворяет равенству \f$ [q]Q = \mathcal O \f$.
+    Последняя проверка требует вычисления кратной точки, поэтому результаты успешных проверок
+    сохраняются
+    \li в контексте открытого ключа (флаг \ref ak_key_flag_public_key_checked), и
+    \li в кэше библиотеки, что позволяет не выполнять проверки повторно при создании нового
+    контекста для того же открытого ключа (например, при повторном импорте сертификата).
+
+    @param pctx Контекст открытого ключа.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_verifykey_context_validate( ak_verifykey pctx )
+{
+  int error = ak_error_ok;
+
+  if( pctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using a null pointer to public key" );
+  if( pctx->wc == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                              "using public key with undefined elliptic curve" );
+  if( pctx->flags&ak_key_flag_public_key_checked ) return ak_error_ok;
+
+  if(( error = ak_verifykey_context_check_qpoint( pctx )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect validation of public key" );
+  pctx->flags |= ak_key_flag_public_key_checked;
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Фрагмент цепочки сертификатов, проверяемый одним потоком. */
+ struct verify_chain_task {
+  /*! \brief Проверяемые звенья цепочки. */
+   ak_verify_batch_item links;
+  /*! \brief Количество проверяемых звеньев. */
+   size_t count;
+  /*! \brief Открытые ключи, проверяемые данным потоком. */
+   ak_verifykey *keys;
+  /*! \brief Результаты проверки открытых ключей. */
+   int *errors;
+  /*! \brief Количество проверяемых открытых ключей. */
+   size_t keys_count;
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет открытые ключи и подписи звеньев фрагмента цепочки. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_verifykey_context_verify_chain_task( struct verify_chain_task *task )
+{
+  size_t i = 0;
+
+  for( i = 0; i < task->keys_count; i++ ) {
+     if( task->keys[i]->flags&ak_key_flag_public_key_checked ) task->errors[i] = ak_error_ok;
+      else task->errors[i] = ak_verifykey_context_check_qpoint( task->keys[i] );
+  }
+  for( i = 0; i < task->count; i++ ) {
+     ak_verify_batch_item link = task->links+i;
+     if(( link->key == NULL ) || ( link->key->wc == NULL )) link->result = ak_false;
+      else link->result = ak_verifykey_context_verify_hash( link->key,
+                                                              link->hash, link->hsize, link->sign );
+  }
+}
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция потока, проверяющего фрагмент цепочки сертификатов. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_verifykey_context_verify_chain_thread( void *ptr )
+{
+  ak_verifykey_context_verify_chain_task(( struct verify_chain_task * ) ptr );
+ return NULL;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция проверяет цепочку сертификатов, каждое звено которой задается тройкой
+    (открытый ключ издателя, хеш-код подписанной части сертификата, подпись). Порядок звеньев
+    в массиве значения не имеет; для корневого (самоподписанного) сертификата в качестве
+    ключа издателя указывается его собственный открытый ключ.
+
+    В отличие от последовательной проверки сертификатов
+    \li каждый из различных открытых ключей цепочки проверяется один раз функцией,
+    аналогичной ak_verifykey_context_validate(), при этом используются результаты проверок,
+    сохраненные ранее в контексте ключа или в кэше библиотеки;
+    \li проверки открытых ключей и подписей всех звеньев выполняются одновременно несколькими
+    потоками, количество которых ограничено опцией `verify_batch_thread_count`. Потоки создаются
+    при каждом вызове функции и завершаются до возврата из нее; постоянный пул потоков
+    библиотекой не поддерживается.
+
+    Звено считается верным, если верна его подпись и открытый ключ издателя прошел проверку.
+    Подписи, у которых значение r или s равно нулю или не меньше порядка q подгруппы точек,
+    отвергаются функцией ak_verifykey_context_verify_hash() до выполнения операций с точками.
+
+    @param links Массив звеньев цепочки; результат проверки каждого звена помещается
+    в поле `result`.
+    @param count Количество звеньев.
+    @return Функция возвращает истину, если верны все звенья цепочки. В противном случае, а также
+    в случае возникновения ошибки, возвращается ложь. Код ошибки может быть получен с помощью
+    вызова функции ak_error_get_value().                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_verifykey_context_verify_chain( ak_verify_batch_item links, const size_t count )
+{
+  int *errors = NULL;
+  ak_verifykey *keys = NULL;
+  bool_t result = ak_true;
+  size_t i, j, kcount = 0, threads = 1;
+  struct verify_chain_task tasks[ ak_verify_batch_thread_max_count ];
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  size_t offset = 0, koffset = 0;
+  pthread_t handles[ ak_verify_batch_thread_max_count ];
+  bool_t started[ ak_verify_batch_thread_max_count ];
+#endif
+
+  if( links == NULL ) {
+    ak_error_message( ak_error_null_pointer, __func__, "using a null pointer to certificate chain" );
+    return ak_false;
+  }
+  if( count == 0 ) {
+    ak_error_message( ak_error_zero_length, __func__, "using certificate chain of zero length" );
+    return ak_false;
+  }
+  for( i = 0; i < count; i++ ) links[i].result = ak_false;
+
+  if(( keys = malloc( count*( sizeof( ak_verifykey ) + sizeof( int )))) == NULL ) {
+    ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+    return ak_false;
+  }
+  errors = ( int * )( keys + count );
+
+ /* формируем множество различных ключей */
+  for( i = 0; i < count; i++ ) {
+     ak_verifykey pctx = links[i].key;
+     if(( pctx == NULL ) || ( pctx->wc == NULL )) continue;
+     for( j = 0; j < kcount; j++ ) if( keys[j] == pctx ) break;
+     if( j < kcount ) continue;
+     keys[kcount++] = pctx;
+  }
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  threads = ak_min( count, ak_verify_batch_thread_max_count );
+  threads = ak_min( threads,
+             ( size_t ) ak_libakrypt_get_option_by_index( ak_option_verify_batch_thread_count ));
+  if( threads < 1 ) threads = 1;
+  for( i = 0; i < threads; i++ ) {
+     size_t len = count/threads + ( i < count%threads ? 1 : 0 ),
+            klen = kcount/threads + ( i < kcount%threads ? 1 : 0 );
+     tasks[i].links = links + offset;
+     tasks[i].count = len;
+     tasks[i].keys = keys + koffset;
+     tasks[i].errors = errors + koffset;
+     tasks[i].keys_count = klen;
+     offset += len;
+     koffset += klen;
+  }
+ /* первый фрагмент проверяется в вызывающем потоке */
+  for( i = 1; i < threads; i++ )
+     started[i] = ( pthread_create( handles+i, NULL,
+                               ak_verifykey_context_verify_chain_thread, tasks+i ) == 0 );
+  ak_verifykey_context_verify_chain_task( tasks );
+  for( i = 1; i < threads; i++ ) {
+     if( started[i] ) pthread_join( handles[i], NULL );
+      else ak_verifykey_context_verify_chain_task( tasks+i );
+  }
+#else
+  tasks[0].links = links;
+  tasks[0].count = count;
+  tasks[0].keys = keys;
+  tasks[0].errors = errors;
+  tasks[0].keys_count = kcount;
+  ak_verifykey_context_verify_chain_task( tasks );
+#endif
+
+ /* сохраняем результаты проверки ключей и отбрасываем звенья с неверными ключами */
+  for( j = 0; j < kcount; j++ )
+     if( errors[j] == ak_error_ok ) keys[j]->flags |= ak_key_flag_public_key_checked;
+  for( i = 0; i < count; i++ ) {
+     if( links[i].result == ak_true ) {
+       for( j = 0; j < kcount; j++ ) if( keys[j] == links[i].key ) break;
+       if( errors[j] != ak_error_ok ) links[i].result = ak_false;
+     }
+     if( links[i].result != ak_true ) result = ak_false;
+  }
+
+  free( keys );
+ return result;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param pctx контекст открытого ключа.
     @param in область памяти для которой проверяется электронная подпись.
@@ -1128,6 +2734,79 @@
  return ak_verifykey_context_verify_hash( pctx, hash, pctx->ctx.data.sctx.hsize, sign );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция начинает проверку электронной подписи для данных, поступающих фрагментами.
+    Данные обрабатываются функциями ak_verifykey_context_update() и
+    ak_verifykey_context_finalize(); при этом хеш-код вычисляется с помощью контекста
+    функции хеширования, содержащегося в открытом ключе, и сообщение целиком в памяти не хранится.
+
+    \note Функции ak_verifykey_context_verify_ptr() и ak_verifykey_context_verify_file()
+    используют тот же контекст функции хеширования, поэтому их вызов прерывает начатое вычисление.
+
+    @param pctx Контекст открытого ключа.
+    @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_verifykey_context_clean( ak_verifykey pctx )
+{
+  if( pctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                      "using null pointer to public key context" );
+ return ak_hash_context_clean( &pctx->ctx );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! @param pctx Контекст открытого ключа.
+    @param in Указатель на очередной фрагмент проверяемых данных.
+    @param size Размер фрагмента в байтах. Размер может принимать произвольное значение.
+    @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_verifykey_context_update( ak_verifykey pctx, const ak_pointer in, const size_t size )
+{
+  if( pctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                      "using null pointer to public key context" );
+ return ak_hash_context_update( &pctx->ctx, in, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция обрабатывает последний фрагмент данных, завершает вычисление хеш-кода
+    и проверяет электронную подпись с помощью функции ak_verifykey_context_verify_hash().
+    После выполнения функции контекст готов к обработке следующего сообщения.
+
+    @param pctx Контекст открытого ключа.
+    @param in Указатель на последний фрагмент проверяемых данных (может быть NULL).
+    @param size Размер фрагмента в байтах.
+    @param sign Электронная подпись.
+    @return Функция возвращает истину, если подпись верна. Функция возвращает ложь, если
+    подпись не проходит проверку или если произошла ошибка. Код ошибки может быть получен с
+    помощью вызова функции ak_error_get_value().                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_verifykey_context_finalize( ak_verifykey pctx, const ak_pointer in,
+                                                              const size_t size, ak_pointer sign )
+{
+  ak_uint8 hash[64];
+  int error = ak_error_ok;
+
+  if( pctx == NULL ) {
+    ak_error_message( ak_error_null_pointer, __func__, "using null pointer to public key context" );
+    return ak_false;
+  }
+  if( pctx->ctx.data.sctx.hsize > sizeof( hash )) {
+    ak_error_message( ak_error_wrong_length, __func__,
+                                            "using hash function with large hash code size" );
+    return ak_false;
+  }
+  memset( hash, 0, sizeof( hash ));
+  if(( error = ak_hash_context_finalize( &pctx->ctx, in, size,
+                                                           hash, sizeof( hash ))) != ak_error_ok ) {
+    ak_error_message( error, __func__, "wrong calculation of hash value" );
+    return ak_false;
+  }
+  ak_hash_context_clean( &pctx->ctx );
+
+ return ak_verifykey_context_verify_hash( pctx, hash, pctx->ctx.data.sctx.hsize, sign );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param vk контекст открытого ключа электронной подписи
     @param ni строка, содержащая имя или идентификатор, определяющий тип помещаемых
@@ -1540,7 +3219,8 @@
 /* ----------------------------------------------------------------------------------------------- */
 /*! \example test-sign01.c
     \example test-sign02.c
-    \example test-sign03.c                                                                         */
+    \example test-sign03.c
+    \example test-sign04.c                                                                         */
 /* ----------------------------------------------------------------------------------------------- */
 /*                                                                                      ak_sign.c  */
 /* ----------------------------------------------------------------------------------------------- */
@@ -11,6 +11,10 @@
  #include <ak_hmac.h>
  #include <ak_asn1.h>
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Пул заранее вычисленных значений, используемых при выработке электронной подписи. */
+ typedef struct signkey_pool *ak_signkey_pool;
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Секретный ключ алгоритма выработки электронной подписи ГОСТ Р 34.10-2012.
 
@@ -31,6 +35,16 @@
   ak_tlv name;
  /*! \brief номер открытого ключа, выработанного из данного секретного ключа. */
   ak_uint8 verifykey_number[32];
+ /*! \brief пул заранее вычисленных пар \f$ (k, r) \f$ (по-умолчанию не используется) */
+  ak_signkey_pool pool;
+ /*! \brief запас заранее вычисленных пар масок \f$ (\zeta, \zeta^{-1}) \f$ секретного ключа */
+  ak_uint64 *masks;
+ /*! \brief количество неиспользованных пар масок */
+  size_t masks_count;
+ /*! \brief количество подписей, после выработки которых изменяется маска ключа */
+  size_t remask_period;
+ /*! \brief количество подписей, выработанных после последней смены маски ключа */
+  size_t remask_counter;
 } *ak_signkey;
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -57,6 +71,8 @@
  int ak_signkey_context_set_curve_str( ak_signkey sctx, const char * );
 /*! \brief Функция устанавливает временной интервал действия секретного ключа. */
  int ak_signkey_context_set_validity( ak_signkey , time_t , time_t );
+/*! \brief Функция устанавливает частоту смены маски секретного ключа. */
+ int ak_signkey_context_set_remask_period( ak_signkey , const size_t );
 /*! \brief Уничтожение контекста секретного ключа. */
  int ak_signkey_context_destroy( ak_signkey );
 /*! \brief Освобождение памяти из под контекста секретного ключа. */
@@ -82,6 +98,28 @@
  int ak_signkey_context_sign_ptr( ak_signkey , const ak_pointer , const size_t , ak_pointer , size_t );
 /*! \brief Выработка электронной подписи для заданного файла. */
  int ak_signkey_context_sign_file( ak_signkey , const char * , ak_pointer , size_t );
+/*! \brief Начало выработки электронной подписи для данных, поступающих фрагментами. */
+ int ak_signkey_context_clean( ak_signkey );
+/*! \brief Обработка очередного фрагмента подписываемых данных. */
+ int ak_signkey_context_update( ak_signkey , const ak_pointer , const size_t );
+/*! \brief Обработка последнего фрагмента данных и выработка электронной подписи. */
+ int ak_signkey_context_finalize( ak_signkey , const ak_pointer , const size_t ,
+                                                                           ak_pointer , size_t );
+/*! \brief Пакетная выработка электронных подписей для последовательности хеш-кодов. */
+ int ak_signkey_context_sign_batch( ak_signkey , const ak_pointer , const size_t ,
+                                                                           ak_pointer , size_t );
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Создание пула заранее вычисленных пар \f$ (k, r) \f$ для выработки подписи. */
+ int ak_signkey_context_enable_pool( ak_signkey , const size_t );
+/*! \brief Заполнение пула заранее вычисленных пар \f$ (k, r) \f$ в вызывающем потоке. */
+ int ak_signkey_context_fill_pool( ak_signkey );
+/*! \brief Количество пар \f$ (k, r) \f$, содержащихся в пуле. */
+ size_t ak_signkey_context_get_pool_count( ak_signkey );
+/*! \brief Код ошибки, после которой поток прекратил заполнение пула. */
+ int ak_signkey_context_get_pool_error( ak_signkey );
+/*! \brief Уничтожение пула заранее вычисленных пар \f$ (k, r) \f$. */
+ int ak_signkey_context_disable_pool( ak_signkey );
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Открытый ключ алгоритма проверки электронной подписи ГОСТ Р 34.10-2012.
@@ -109,6 +147,12 @@
   ak_oid oid;
  /*! \brief точка кривой, являющаяся открытым ключом электронной подписи */
   struct wpoint qpoint;
+ /*! \brief таблица нечетных кратных точки qpoint, используемая при проверке подписи
+    (вычисляется при создании или импорте открытого ключа, либо вызовом функции
+     ak_verifykey_context_precompute_table()) */
+  ak_wpoint table;
+ /*! \brief ширина окна, которой соответствует таблица нечетных кратных */
+  size_t table_width;
  /*! \brief временной интервал использования ключа  */
   struct time_interval time;
  /*! \brief ASN.1 дерево, содержащее в себе последовательность расширенных имен
@@ -127,6 +171,8 @@
  int ak_verifykey_context_create_from_signkey( ak_verifykey , ak_signkey );
 /*! \brief Функция устанавливает временной интервал действия открытого ключа. */
  int ak_verifykey_context_set_validity( ak_verifykey , time_t , time_t );
+/*! \brief Вычисление таблицы нечетных кратных открытого ключа. */
+ int ak_verifykey_context_precompute_table( ak_verifykey );
 /*! \brief Функция вырабатывает номер открытого ключа. */
  int ak_verifykey_context_set_number( ak_verifykey );
 /*! \brief Функция добавляет к расширенному имени владельца ключа новую строку. */
@@ -143,6 +189,38 @@
                                                                        const size_t , ak_pointer );
 /*! \brief Проверка электронной подписи для заданного файла. */
  bool_t ak_verifykey_context_verify_file( ak_verifykey , const char * , ak_pointer );
+/*! \brief Начало проверки электронной подписи для данных, поступающих фрагментами. */
+ int ak_verifykey_context_clean( ak_verifykey );
+/*! \brief Обработка очередного фрагмента проверяемых данных. */
+ int ak_verifykey_context_update( ak_verifykey , const ak_pointer , const size_t );
+/*! \brief Обработка последнего фрагмента данных и проверка электронной подписи. */
+ bool_t ak_verifykey_context_finalize( ak_verifykey , const ak_pointer ,
+                                                                       const size_t , ak_pointer );
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Элемент пакета электронных подписей, проверяемых функцией
+    ak_verifykey_context_verify_batch(). */
+ typedef struct verify_batch_item {
+ /*! \brief контекст открытого ключа */
+  ak_verifykey key;
+ /*! \brief хеш-код сообщения */
+  ak_pointer hash;
+ /*! \brief размер хеш-кода (в октетах) */
+  size_t hsize;
+ /*! \brief электронная подпись */
+  ak_pointer sign;
+ /*! \brief результат проверки подписи (устанавливается функцией) */
+  bool_t result;
+} *ak_verify_batch_item;
+
+/*! \brief Пакетная проверка электронных подписей. */
+ int ak_verifykey_context_verify_batch( ak_verify_batch_item , const size_t );
+/*! \brief Проверка принадлежности открытого ключа кривой и порядка точки. */
+ int ak_verifykey_context_validate( ak_verifykey );
+/*! \brief Одновременная проверка всех звеньев цепочки сертификатов. */
+ bool_t ak_verifykey_context_verify_chain( ak_verify_batch_item , const size_t );
+/*! \brief Очистка кэша проверенных открытых ключей. */
+ int ak_verifykey_check_cache_clear( void );
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Выполнение тестовых примеров для алгоритмов выработки и проверки электронной подписи */
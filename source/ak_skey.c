@@ -39,6 +39,71 @@
  static pthread_mutex_t session_unique_number_mutex = PTHREAD_MUTEX_INITIALIZER;
 #endif
 
+#if !defined( LIBAKRYPT_HAVE_BUILTIN_ATOMIC_GCC ) && defined( LIBAKRYPT_HAVE_PTHREAD )
+/*! \brief Мьютекс, защищающий общие счетчики ресурса ключей при отсутствии атомарных операций. */
+ static pthread_mutex_t resource_counter_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция изымает из счетчика ресурса не более `count` единиц ресурса.
+    \details Изъятие выполняется атомарно, поэтому функция может вызываться одновременно из
+    нескольких потоков для одного и того же счетчика.
+    \param counter Указатель на счетчик ресурса.
+    \param count Запрашиваемое количество единиц ресурса (положительная величина).
+    \param partial Если значение истинно, то при недостатке ресурса изымается весь остаток;
+    в противном случае при недостатке ресурса счетчик не изменяется.
+    \return Функция возвращает количество изъятых единиц ресурса.                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ static ssize_t ak_skey_context_take_resource( ssize_t *counter,
+                                                            const ssize_t count, bool_t partial )
+{
+  ssize_t value = 0, take = 0;
+
+#ifdef LIBAKRYPT_HAVE_BUILTIN_ATOMIC_GCC
+  value = __atomic_load_n( counter, __ATOMIC_ACQUIRE );
+  do {
+      if(( value < count ) && ( partial != ak_true )) return 0;
+      if(( take = ak_min( value, count )) <= 0 ) return 0;
+  } while( !__atomic_compare_exchange_n( counter, &value, value - take, 0,
+                                                             __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE ));
+#else
+ #ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &resource_counter_mutex );
+ #endif
+  value = *counter;
+  if(( value >= count ) || ( partial == ak_true )) {
+    if(( take = ak_min( value, count )) > 0 ) *counter -= take;
+      else take = 0;
+  }
+ #ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &resource_counter_mutex );
+ #endif
+#endif
+
+ return take;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция возвращает в счетчик ресурса заданное количество единиц ресурса.
+    \param counter Указатель на счетчик ресурса.
+    \param count Возвращаемое количество единиц ресурса.                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_skey_context_return_resource( ssize_t *counter, const ssize_t count )
+{
+  if( count <= 0 ) return;
+#ifdef LIBAKRYPT_HAVE_BUILTIN_ATOMIC_GCC
+  __atomic_fetch_add( counter, count, __ATOMIC_ACQ_REL );
+#else
+ #ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_lock( &resource_counter_mutex );
+ #endif
+  *counter += count;
+ #ifdef LIBAKRYPT_HAVE_PTHREAD
+  pthread_mutex_unlock( &resource_counter_mutex );
+ #endif
+#endif
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \details Функция выделяет массив памяти, достаточный для размещения секретного ключа и
     его маски (размер выделяемой памяти в точности равен удвленному разхмеру секретного ключа).
@@ -222,7 +287,11 @@
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \param skey контекст секретного ключа, для которого вырабатывается уникальный номер
+/*! Помимо присвоения номера функция устанавливает флаг \ref ak_key_flag_schedule_cache,
+    разрешающий повторное использование развернутых раундовых ключей с тем же номером.
+    Флаг сбрасывается при последующей замене значения ключа.
+
+    \param skey контекст секретного ключа, для которого вырабатывается уникальный номер
     \param ptr указатель на область памяти, содержащей номер ключа
     \param size размер области памяти в октетах
     \return В случае успеха функция возвращает \ref ak_error_ok (ноль). В противном случае, возвращается
@@ -241,6 +310,10 @@
   memset( skey->number, 0, sizeof( skey->number ));
   memcpy( skey->number, ptr, ak_min( size, sizeof( skey->number )));
 
+ /* ключ с явно заданным номером считается долговременным,
+    поэтому его развернутые раундовые ключи могут храниться в кэше */
+  skey->flags |= ak_key_flag_schedule_cache;
+
  return ak_error_ok;
 }
 
@@ -279,6 +352,7 @@
   skey->icode = 0; /* контрольная сумма ключа не задана */
   skey->data = NULL; /* внутренние данные ключа не определены */
   memset( &(skey->resource), 0, sizeof( struct resource )); /* ресурс ключа не определен */
+  skey->shared_counter = NULL; /* ресурс ключа не связан с ресурсом другого ключа */
 
  /* инициализируем генератор масок */
   if(( error = ak_random_context_create_lcg( &skey->generator )) != ak_error_ok ) {
@@ -326,6 +400,10 @@
 
   if( skey == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
                                                          "destroying null pointer to secret key" );
+ /* возвращаем неиспользованную часть зарезервированного ресурса */
+  if((( skey->flags )&ak_key_flag_shared_resource ) && ( skey->shared_counter != NULL ))
+    ak_skey_context_return_resource( skey->shared_counter, skey->resource.value.counter );
+
   if(( error = ak_skey_context_free_memory( skey )) != ak_error_ok )
     ak_error_message( error, __func__, "incorrect freeing of internal key buffer" );
 
@@ -352,6 +430,64 @@
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция инициализирует контекст `dst` и копирует в него маскированное значение ключа,
+    маску, номер, контрольную сумму, ресурс и методы контекста `src`. После копирования
+    маска ключа в контексте `dst` сменяется, так что два контекста не содержат одинаковых
+    последовательностей в памяти. Генератор масок у копии собственный.
+
+    Внутренние данные ключа (поле `data`) функцией не копируются, это выполняется
+    функциями классов-наследников, например, ak_bckey_context_clone().
+
+    @param dst Контекст секретного ключа, в который помещается копия. Контекст не должен
+    быть инициализирован ранее.
+    @param src Контекст копируемого секретного ключа.
+    @return Функция возвращает \ref ak_error_ok (ноль) в случае успеха.
+    В противном случае возвращается код ошибки.                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_skey_context_clone( ak_skey dst, ak_skey src )
+{
+  int error = ak_error_ok;
+
+  if( dst == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                 "using a null pointer to destination secret key" );
+  if( src == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "using a null pointer to source secret key" );
+  if( src->key == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                "using source secret key with undefined buffer" );
+  if(( error = ak_skey_context_create( dst, src->key_size )) != ak_error_ok )
+    return ak_error_message( error, __func__, "wrong creation of secret key context" );
+
+ /* копируем ключ вместе с маской */
+  memcpy( dst->key, src->key, src->key_size << 1 );
+  memcpy( dst->number, src->number, sizeof( dst->number ));
+  memcpy( &dst->resource, &src->resource, sizeof( struct resource ));
+ /* зарезервированный рабочей копией ресурс не размножается */
+  if(( src->flags )&ak_key_flag_shared_resource ) {
+    dst->resource.value.counter = 0;
+    dst->shared_counter = src->shared_counter;
+  }
+  dst->icode = src->icode;
+  dst->oid = src->oid;
+ /* внутренние данные у копии пока отсутствуют */
+  dst->flags = ( src->flags )&( ~ak_key_flag_data_not_free );
+
+  dst->set_mask = src->set_mask;
+  dst->unmask = src->unmask;
+  dst->set_icode = src->set_icode;
+  dst->check_icode = src->check_icode;
+
+ /* сменяем маску */
+  if(( dst->flags )&ak_key_flag_set_mask ) {
+    if(( error = dst->set_mask( dst )) != ak_error_ok ) {
+      ak_error_message( error, __func__, "wrong remasking of secret key copy" );
+      ak_skey_context_destroy( dst );
+    }
+  }
+
+ return error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция вырабатывает случайный вектор \f$ v \f$ длины, совпадающей с длиной ключа,
     и заменяет значение ключа \f$ k \f$ на величину \f$ k \oplus v \f$.
@@ -598,6 +734,89 @@
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция уменьшает значение счетчика ресурса ключа на величину `count`. Для обычного ключа
+    уменьшение счетчика выполняется атомарно, что позволяет корректно учитывать ресурс
+    даже при одновременном обращении к ключу из нескольких потоков.
+
+    Если ключ является рабочей копией, ресурс которой связан с ресурсом ключа-родителя
+    (установлен флаг \ref ak_key_flag_shared_resource), то поле `resource.value.counter` содержит
+    только зарезервированную данной копией квоту. Пока квоты достаточно, обращения к общему
+    счетчику не происходит; при исчерпании квоты из общего счетчика атомарно резервируется
+    очередная порция, размер которой определяется опцией `bckey_resource_quota`.
+
+    Функция не выводит сообщений об ошибках, это возлагается на вызывающую функцию.
+
+    \param skey Контекст секретного ключа.
+    \param count Количество использованных единиц ресурса (например, блоков).
+    \return В случае успеха функция возвращает \ref ak_error_ok. При недостатке ресурса
+    возвращается \ref ak_error_low_key_resource.                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_skey_context_use_resource( ak_skey skey, const ssize_t count )
+{
+  ssize_t local = 0, quota = 0;
+
+  if( skey == NULL ) return ak_error_null_pointer;
+  if( count <= 0 ) return ak_error_ok;
+
+ /* обычный ключ: атомарно уменьшаем собственный счетчик */
+  if( !(( skey->flags )&ak_key_flag_shared_resource ) || ( skey->shared_counter == NULL )) {
+    if( ak_skey_context_take_resource( &skey->resource.value.counter,
+                                                             count, ak_false ) != count )
+      return ak_error_low_key_resource;
+    return ak_error_ok;
+  }
+
+ /* рабочая копия: локальная квота используется только одним потоком */
+  if(( local = skey->resource.value.counter ) < count ) {
+    if(( quota = ( ssize_t )
+           ak_libakrypt_get_option_by_index( ak_option_bckey_resource_quota )) <= 0 ) quota = 1;
+    local += ak_skey_context_take_resource( skey->shared_counter,
+                                                        ak_max( count - local, quota ), ak_true );
+    if( local < count ) {
+      skey->resource.value.counter = local;
+      return ak_error_low_key_resource;
+    }
+  }
+  skey->resource.value.counter = local - count;
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция переводит ключ `skey` в режим, при котором его ресурс резервируется порциями из общего
+    счетчика ресурса ключа `parent` (см. ak_skey_context_use_resource()). Если `parent` сам
+    является рабочей копией, то используется общий счетчик его родителя.
+
+    \note Ключ-родитель должен существовать все время жизни рабочих копий; при уничтожении
+    рабочей копии неиспользованная часть ее квоты возвращается в общий счетчик.
+
+    \param skey Контекст секретного ключа (рабочая копия).
+    \param parent Контекст ключа-родителя.
+    \return В случае успеха функция возвращает \ref ak_error_ok. В противном случае,
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_skey_context_share_resource( ak_skey skey, ak_skey parent )
+{
+  if(( skey == NULL ) || ( parent == NULL )) return ak_error_message( ak_error_null_pointer,
+                                                 __func__ , "using a null pointer to secret key" );
+  if( skey == parent ) return ak_error_message( ak_error_undefined_value, __func__ ,
+                                                   "using the same key as parent and as a copy" );
+ /* возвращаем ранее зарезервированную квоту */
+  if((( skey->flags )&ak_key_flag_shared_resource ) && ( skey->shared_counter != NULL ))
+    ak_skey_context_return_resource( skey->shared_counter, skey->resource.value.counter );
+
+  if((( parent->flags )&ak_key_flag_shared_resource ) && ( parent->shared_counter != NULL ))
+    skey->shared_counter = parent->shared_counter;
+   else skey->shared_counter = &parent->resource.value.counter;
+
+  skey->resource.value.type = parent->resource.value.type;
+  skey->resource.value.counter = 0;
+  skey->flags |= ak_key_flag_shared_resource;
+
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*                             функции установки ключевой информации                               */
 /* ----------------------------------------------------------------------------------------------- */
@@ -644,6 +863,11 @@
   memcpy( skey->key, ptr, size );            /* копируем данные */
   memset( skey->key+size, 0, size ); /* обнуляем массив масок */
 
+ /* при замене ранее присвоенного значения номер ключа перестает ему соответствовать,
+    поэтому повторное использование развернутых раундовых ключей запрещается */
+  if( skey->flags&ak_key_flag_set_key )
+    skey->flags &= (0xFFFFFFFFFFFFFFFFLL ^ ak_key_flag_schedule_cache );
+
  /* очищаем флаг начальной инициализации */
   skey->flags &= (0xFFFFFFFFFFFFFFFFLL ^ ak_key_flag_set_mask );
 
@@ -686,6 +910,11 @@
                                                            "using a key buffer with zero length" );
   if( generator == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
                                                 "using a null pointer to random number generator" );
+ /* при замене ранее присвоенного значения номер ключа перестает ему соответствовать,
+    поэтому повторное использование развернутых раундовых ключей запрещается */
+  if( skey->flags&ak_key_flag_set_key )
+    skey->flags &= (0xFFFFFFFFFFFFFFFFLL ^ ak_key_flag_schedule_cache );
+
  /* присваиваем случайный ключ и случайную маску
     тем самым точное значение ключа ни как не фигурирует */
   if(( error = ak_random_context_random( generator, skey->key,
@@ -741,11 +970,16 @@
                                                              "using a password with zero length" );
  /* присваиваем буффер и маскируем его */
   if(( error = ak_hmac_context_pbkdf2_streebog512( pass, pass_size, salt, salt_size,
-                   (const size_t) ak_libakrypt_get_option("pbkdf2_iteration_count"),
+          (const size_t) ak_libakrypt_get_option_by_index( ak_option_pbkdf2_iteration_count ),
                                                      skey->key_size, skey->key )) != ak_error_ok )
     return ak_error_message( error, __func__ , "wrong generation a secret key data" );
   memset( skey->key+skey->key_size, 0, skey->key_size ); /* обнуляем массив масок */
 
+ /* при замене ранее присвоенного значения номер ключа перестает ему соответствовать,
+    поэтому повторное использование развернутых раундовых ключей запрещается */
+  if( skey->flags&ak_key_flag_set_key )
+    skey->flags &= (0xFFFFFFFFFFFFFFFFLL ^ ak_key_flag_schedule_cache );
+
  /* очищаем флаг начальной инициализации */
   skey->flags &= (0xFFFFFFFFFFFFFFFFLL ^ ak_key_flag_set_mask );
 
@@ -27,6 +27,8 @@
  typedef int ( ak_function_skey )( ak_skey );
 /*! \brief Однопараметрическая функция для проведения действий с секретным ключом, возвращает истину или ложь. */
  typedef bool_t ( ak_function_skey_check )( ak_skey );
+/*! \brief Функция копирования внутренних данных одного секретного ключа в другой, возвращает код ошибки. */
+ typedef int ( ak_function_skey_clone )( ak_skey , ak_skey );
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Перечисление определяет возможные типы счетчиков ресурса секретного ключа. */
@@ -98,6 +100,18 @@
 /*! \brief Флаг, который определяет, можно ли использовать значение внутреннего буффера в режиме omac. */
  #define ak_key_flag_omac_buffer_used   (0x0000000000000200ULL)
 
+/*! \brief Флаг, который разрешает хранение развернутых раундовых ключей в кэше библиотеки.
+    Устанавливается при явном присвоении ключу номера (например, при чтении ключа с носителя). */
+ #define ak_key_flag_schedule_cache     (0x0000000000000400ULL)
+
+/*! \brief Флаг, который означает, что ресурс ключа резервируется порциями из общего счетчика
+    ресурса ключа-родителя (используется рабочими копиями ключа в многопоточных приложениях). */
+ #define ak_key_flag_shared_resource    (0x0000000000000800ULL)
+
+/*! \brief Флаг, который означает, что для открытого ключа выполнены проверки принадлежности
+    точки эллиптической кривой и равенства ее порядка величине q. */
+ #define ak_key_flag_public_key_checked (0x0000000000001000ULL)
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Способ выделения памяти для хранения секретной информации. */
  typedef enum {
@@ -149,6 +163,9 @@
    struct random generator;
   /*! \brief ресурс использования ключа */
    struct resource resource;
+  /*! \brief указатель на общий счетчик ресурса ключа-родителя
+      (определен только при установленном флаге \ref ak_key_flag_shared_resource) */
+   ssize_t *shared_counter;
   /*! \brief указатель на внутренние данные ключа */
    ak_pointer data;
  /*! \brief Флаги текущего состояния ключа */
@@ -174,6 +191,8 @@
  int ak_skey_context_create( ak_skey , size_t );
 /*! \brief Очистка структуры секретного ключа. */
  int ak_skey_context_destroy( ak_skey );
+/*! \brief Инициализация структуры секретного ключа копией другого секретного ключа. */
+ int ak_skey_context_clone( ak_skey , ak_skey );
 /*! \brief Генерация случайного уникального вектора, рассматриваемого как номер ключа. */
  int ak_skey_context_generate_unique_number( ak_pointer , const size_t );
 /*! \brief Присвоение секретному ключу уникального номера. */
@@ -207,6 +226,10 @@
 /*! \brief Функция устанавливает ресурс и временной итервал действия ключа. */
  int ak_skey_context_set_resource_values( ak_skey ,
                                              counter_resource_t , const char * , time_t , time_t );
+/*! \brief Функция атомарно уменьшает ресурс ключа на заданную величину. */
+ int ak_skey_context_use_resource( ak_skey , const ssize_t );
+/*! \brief Функция связывает ресурс ключа с общим счетчиком ресурса ключа-родителя. */
+ int ak_skey_context_share_resource( ak_skey , ak_skey );
 
 /* ----------------------------------------------------------------------------------------------- */
 #ifdef LIBAKRYPT_HAVE_DEBUG_FUNCTIONS
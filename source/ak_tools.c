@@ -118,33 +118,72 @@
  } *ak_option;
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! Константные значения опций (значения по-умолчанию) */
- static struct option options[] = {
-     { "log_level", ak_log_standard, 0, 2 },
-     { "context_manager_size", 32, 32, 65536 },
-     { "context_manager_max_size", 4096, 4096, 2147483648 },
-     { "pbkdf2_iteration_count", 2000, 1000, 65536 },
-     { "hmac_key_count_resource", 65536, 1024, 2147483648 },
-     { "digital_signature_count_resource", 65536, 1024, 2147483648 },
+/*! Константные значения опций (значения по-умолчанию).
+    Положение каждой опции в таблице определяется ее индексом (см. \ref option_index_t). */
+ static struct option options[ ak_option_count + 1 ] = {
+     [ak_option_log_level] = { "log_level", ak_log_standard, 0, 2 },
+     [ak_option_context_manager_size] = { "context_manager_size", 32, 32, 65536 },
+     [ak_option_context_manager_max_size] = { "context_manager_max_size", 4096, 4096, 2147483648 },
+     [ak_option_pbkdf2_iteration_count] = { "pbkdf2_iteration_count", 2000, 1000, 65536 },
+     [ak_option_hmac_key_count_resource] = { "hmac_key_count_resource", 65536, 1024, 2147483648 },
+     [ak_option_digital_signature_count_resource] =
+         { "digital_signature_count_resource", 65536, 1024, 2147483648 },
 
   /* значение константы задает максимальный объем зашифрованной информации на одном ключе в 4 Mб:
                                  524288 блока x 8 байт на блок = 4.194.304 байт = 4096 Кб = 4 Mб   */
-     { "magma_cipher_resource", 524288, 1024, 2147483648 },
+     [ak_option_magma_cipher_resource] = { "magma_cipher_resource", 524288, 1024, 2147483648 },
 
   /* значение константы задает максимальный объем зашифрованной информации на одном ключе в 32 Mб:
                              2097152 блока x 16 байт на блок = 33.554.432 байт = 32768 Кб = 32 Mб  */
-     { "kuznechik_cipher_resource", 2097152, 8196, 2147483648 },
-     { "acpkm_message_count", 4096, 128, 65536 },
-     { "acpkm_section_magma_block_count", 128, 128, 16777216 },
-     { "acpkm_section_kuznechik_block_count", 512, 512, 16777216 },
+     [ak_option_kuznechik_cipher_resource] =
+         { "kuznechik_cipher_resource", 2097152, 8196, 2147483648 },
+     [ak_option_acpkm_message_count] = { "acpkm_message_count", 4096, 128, 65536 },
+     [ak_option_acpkm_section_magma_block_count] =
+         { "acpkm_section_magma_block_count", 128, 128, 16777216 },
+     [ak_option_acpkm_section_kuznechik_block_count] =
+         { "acpkm_section_kuznechik_block_count", 512, 512, 16777216 },
+
+  /* количество развернутых раундовых ключей, хранящихся в кэше (ноль запрещает кэширование) */
+     [ak_option_bckey_schedule_cache_size] = { "bckey_schedule_cache_size", 16, 0, 64 },
+  /* количество блоков, резервируемых рабочей копией ключа за одно обращение к общему ресурсу */
+     [ak_option_bckey_resource_quota] = { "bckey_resource_quota", 1024, 1, 65536 },
+  /* ширина окна таблицы нечетных кратных, хранящейся в контексте открытого ключа; таблица
+     содержит 2^{w-2} точек, значения, меньшие трех, запрещают использование таблицы */
+     [ak_option_verifykey_wnaf_width] = { "verifykey_wnaf_width", 6, 0, 8 },
+  /* максимальное количество потоков, используемых при пакетной проверке электронных подписей */
+     [ak_option_verify_batch_thread_count] = { "verify_batch_thread_count", 4, 1, 64 },
+  /* флаг одновременного вычисления точек нескольких подписей векторной реализацией
+     (используется, если процессор поддерживает инструкции AVX-512 IFMA) */
+     [ak_option_verify_batch_lanes] = { "verify_batch_lanes", 1, 0, 1 },
+  /* максимальное количество потоков, используемых при пакетной выработке электронных подписей */
+     [ak_option_sign_batch_thread_count] = { "sign_batch_thread_count", 4, 1, 64 },
+  /* количество подписей, после выработки которых изменяется маска секретного ключа подписи */
+     [ak_option_signkey_remask_period] = { "signkey_remask_period", 1, 1, 65536 },
+  /* способ вычисления кратных точек эллиптических кривых (0 - лесенка Монтгомери,
+     1 - метод фиксированного окна) и ширина окна, отдельно для кривых длины 256 и 512 бит */
+     [ak_option_wcurve256_pow_engine] = { "wcurve256_pow_engine", 1, 0, 1 },
+     [ak_option_wcurve256_pow_width] = { "wcurve256_pow_width", 4, 1, 6 },
+     [ak_option_wcurve512_pow_engine] = { "wcurve512_pow_engine", 1, 0, 1 },
+     [ak_option_wcurve512_pow_width] = { "wcurve512_pow_width", 4, 1, 6 },
 
   /* при значении равным единицы, формат шифрования данных соответствует варианту OpenSSL */
-     { "openssl_compability", 0, 0, 1 },
+     [ak_option_openssl_compability] = { "openssl_compability", 0, 0, 1 },
   /* флаг использования цвета при выводе сообщений библиотеки */
-     { "use_color_output", 1, 0, 1 },
-     { NULL, 0, 0, 0 } /* завершающая константа, должна всегда принимать нулевые значения */
+     [ak_option_use_color_output] = { "use_color_output", 1, 0, 1 },
+     [ak_option_count] =
+         { NULL, 0, 0, 0 } /* завершающая константа, должна всегда принимать нулевые значения */
  };
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Чтение и запись значения опции, выполняемые атомарно (если это возможно). */
+#ifdef LIBAKRYPT_HAVE_BUILTIN_ATOMIC_GCC
+ #define ak_option_load( idx )         __atomic_load_n( &options[idx].value, __ATOMIC_RELAXED )
+ #define ak_option_store( idx, val )   __atomic_store_n( &options[idx].value, val, __ATOMIC_RELAXED )
+#else
+ #define ak_option_load( idx )         ( options[idx].value )
+ #define ak_option_store( idx, val )   ( options[idx].value = ( val ))
+#endif
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \b Внимание. Функция экспортируется.
 
@@ -165,11 +204,43 @@
   size_t i = 0;
   ak_int64 result = ak_error_wrong_option;
   for( i = 0; i < ak_libakrypt_options_count(); i++ ) {
-     if( strncmp( name, options[i].name, strlen( options[i].name )) == 0 ) result = options[i].value;
+     if( strncmp( name, options[i].name, strlen( options[i].name )) == 0 )
+       result = ak_option_load( i );
   }
  return result;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция предназначена для использования внутри библиотеки вместо функции
+    ak_libakrypt_get_option(): поиск опции по имени не производится, а значение
+    считывается атомарно, что позволяет вызывать функцию одновременно из нескольких потоков.
+
+    \param index Индекс опции.
+    \return Значение опции с заданным индексом. Если индекс указан неверно, то возвращается
+    ошибка \ref ak_error_wrong_option.                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ ak_int64 ak_libakrypt_get_option_by_index( const option_index_t index )
+{
+  if(( size_t )index >= ak_option_count ) return ak_error_wrong_option;
+ return ak_option_load( index );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \b Внимание! Функция не проверяет и не интерпретирует значение устанавливааемой опции.
+
+    \param index Индекс опции
+    \param value Значение опции
+
+    \return В случае удачного установления значения опции возввращается \ref ak_error_ok.
+     Если индекс опции указан неверно, то возвращается ошибка \ref ak_error_wrong_option.         */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_libakrypt_set_option_by_index( const option_index_t index, const ak_int64 value )
+{
+  if(( size_t )index >= ak_option_count ) return ak_error_wrong_option;
+  ak_option_store( index, value );
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \b Внимание! Функция не проверяет и не интерпретирует значение устанавливааемой опции.
 
@@ -185,7 +256,7 @@
   int result = ak_error_wrong_option;
   for( i = 0; i < ak_libakrypt_options_count(); i++ ) {
      if( strncmp( name, options[i].name, strlen( options[i].name )) == 0 ) {
-       options[i].value = value;
+       ak_option_store( i, value );
        result = ak_error_ok;
      }
   }
@@ -202,13 +273,13 @@
 {
   if( flag ) { /* устанавливаем цветной вывод */
  #ifndef _WIN32
-    ak_libakrypt_set_option( "use_color_output", 1 );
+    ak_libakrypt_set_option_by_index( ak_option_use_color_output, 1 );
     ak_error_code_start_red_string = LIBAKRYPT_START_RED_STRING;
     ak_error_code_end_red_string = LIBAKRYPT_END_RED_STRING;
  #endif
   } else {
  #ifndef _WIN32
-    ak_libakrypt_set_option( "use_color_output", 0 );
+    ak_libakrypt_set_option_by_index( ak_option_use_color_output, 0 );
     ak_error_code_start_string = ak_error_code_start_red_string = "";
     ak_error_code_end_string = ak_error_code_end_red_string = "";
  #endif
@@ -275,7 +346,7 @@
  ak_int64 ak_libakrypt_get_option_value( const size_t index )
 {
  if( index >= ak_libakrypt_options_count() ) return ak_error_wrong_option;
-  else return options[index].value;
+  else return ak_option_load( index );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -579,7 +650,7 @@
    ak_file_close( &fd );
    if(( error = ak_libakrypt_ini_parse( name,
                                      ak_libakrypt_load_option_from_file, NULL )) == ak_error_ok ) {
-     if( ak_libakrypt_get_option( "log_level" ) > ak_log_standard )
+     if( ak_libakrypt_get_option_by_index( ak_option_log_level ) > ak_log_standard )
        ak_error_message_fmt( ak_error_ok, __func__, "all options was read from %s file", name );
      return ak_true;
    } else {
@@ -599,7 +670,7 @@
    ak_file_close( &fd );
    if(( error = ak_libakrypt_ini_parse( name,
                                      ak_libakrypt_load_option_from_file, NULL )) == ak_error_ok ) {
-     if( ak_libakrypt_get_option( "log_level" ) > ak_log_standard )
+     if( ak_libakrypt_get_option_by_index( ak_option_log_level ) > ak_log_standard )
        ak_error_message_fmt( ak_error_ok, __func__, "all options was read from %s file", name );
      return ak_true;
    } else {
@@ -623,7 +694,7 @@
  void ak_libakrypt_log_options( void )
 {
  /* выводим сообщение об установленных параметрах библиотеки */
-  if( ak_libakrypt_get_option( "log_level" ) >= ak_log_maximum ) {
+  if( ak_libakrypt_get_option_by_index( ak_option_log_level ) >= ak_log_maximum ) {
     size_t i = 0;
     ak_error_message_fmt( ak_error_ok, __func__, "libakrypt version: %s", ak_libakrypt_version( ));
    /* далее мы пропускаем вывод информации об архитектуре,
@@ -790,7 +861,8 @@
 /*! \hidecallgraph
     \hidecallergraph                                                                               */
 /* ----------------------------------------------------------------------------------------------- */
- int ak_log_get_level( void ) { return (int)ak_libakrypt_get_option("log_level"); }
+ int ak_log_get_level( void )
+                                { return (int)ak_libakrypt_get_option_by_index( ak_option_log_level ); }
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! Все сообщения библиотеки могут быть разделены на три уровня.
@@ -824,9 +896,9 @@
 {
  int value = ak_max( level, ak_log_get_level( ));
 
-   if( value < 0 ) return ak_libakrypt_set_option("log_level", ak_log_none );
+   if( value < 0 ) return ak_libakrypt_set_option_by_index( ak_option_log_level, ak_log_none );
    if( value > 16 ) value = 16;
- return ak_libakrypt_set_option("log_level", value );
+ return ak_libakrypt_set_option_by_index( ak_option_log_level, value );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -1664,6 +1736,7 @@
 /* ----------------------------------------------------------------------------------------------- */
 /*! \example example-hello.c                                                                       */
 /*! \example example-log.c                                                                         */
+/*! \example test-options01.c                                                                      */
 /* ----------------------------------------------------------------------------------------------- */
 /*                                                                                     ak_tools.c  */
 /* ----------------------------------------------------------------------------------------------- */
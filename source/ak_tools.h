@@ -56,6 +56,67 @@
  ssize_t ak_file_write( ak_file , ak_const_pointer , size_t );
 
 /* ----------------------------------------------------------------------------------------------- */
+/*! \brief Перечисление, определяющее индексы опций библиотеки.
+    \details Индексы позволяют получать значения опций за константное время, без поиска
+    опции по имени. Порядок следования индексов совпадает с порядком опций в таблице. */
+ typedef enum {
+  /*! \brief Уровень аудита. */
+   ak_option_log_level,
+  /*! \brief Начальный размер структуры управления контекстами. */
+   ak_option_context_manager_size,
+  /*! \brief Максимальный размер структуры управления контекстами. */
+   ak_option_context_manager_max_size,
+  /*! \brief Количество итераций алгоритма PBKDF2. */
+   ak_option_pbkdf2_iteration_count,
+  /*! \brief Ресурс ключа алгоритма HMAC. */
+   ak_option_hmac_key_count_resource,
+  /*! \brief Ресурс ключа электронной подписи. */
+   ak_option_digital_signature_count_resource,
+  /*! \brief Ресурс ключа алгоритма Магма. */
+   ak_option_magma_cipher_resource,
+  /*! \brief Ресурс ключа алгоритма Кузнечик. */
+   ak_option_kuznechik_cipher_resource,
+  /*! \brief Количество сообщений, обрабатываемых в режиме ACPKM. */
+   ak_option_acpkm_message_count,
+  /*! \brief Длина секции режима ACPKM для алгоритма Магма (в блоках). */
+   ak_option_acpkm_section_magma_block_count,
+  /*! \brief Длина секции режима ACPKM для алгоритма Кузнечик (в блоках). */
+   ak_option_acpkm_section_kuznechik_block_count,
+  /*! \brief Количество элементов кэша развернутых раундовых ключей. */
+   ak_option_bckey_schedule_cache_size,
+  /*! \brief Размер квоты ресурса, резервируемой рабочей копией ключа. */
+   ak_option_bckey_resource_quota,
+  /*! \brief Ширина окна таблицы нечетных кратных открытого ключа электронной подписи. */
+   ak_option_verifykey_wnaf_width,
+  /*! \brief Максимальное количество потоков, используемых при пакетной проверке подписей. */
+   ak_option_verify_batch_thread_count,
+  /*! \brief Использование векторной реализации при пакетной проверке подписей. */
+   ak_option_verify_batch_lanes,
+  /*! \brief Максимальное количество потоков, используемых при пакетной выработке подписей. */
+   ak_option_sign_batch_thread_count,
+  /*! \brief Количество подписей, после выработки которых изменяется маска секретного ключа. */
+   ak_option_signkey_remask_period,
+  /*! \brief Способ вычисления кратных точек для кривых с параметрами длины 256 бит. */
+   ak_option_wcurve256_pow_engine,
+  /*! \brief Ширина окна при вычислении кратных точек для кривых с параметрами длины 256 бит. */
+   ak_option_wcurve256_pow_width,
+  /*! \brief Способ вычисления кратных точек для кривых с параметрами длины 512 бит. */
+   ak_option_wcurve512_pow_engine,
+  /*! \brief Ширина окна при вычислении кратных точек для кривых с параметрами длины 512 бит. */
+   ak_option_wcurve512_pow_width,
+  /*! \brief Режим совместимости с OpenSSL. */
+   ak_option_openssl_compability,
+  /*! \brief Использование цвета при выводе сообщений. */
+   ak_option_use_color_output,
+  /*! \brief Общее количество опций (не является индексом опции). */
+   ak_option_count
+ } option_index_t;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция возвращает значение опции с заданным индексом. */
+ ak_int64 ak_libakrypt_get_option_by_index( const option_index_t );
+/*! \brief Функция устанавливает значение опции с заданным индексом. */
+ int ak_libakrypt_set_option_by_index( const option_index_t , const ak_int64 );
 /*! \brief Функция устанавливает значение опции с заданным именем. */
  int ak_libakrypt_set_option( const char *name, const ak_int64 value );
 /*! \brief Функция возвращает значение опции с заданным именем. */
@@ -0,0 +1,110 @@
+/* Тестовый пример иллюстрирует повторное использование развернутых раундовых ключей,
+   хранящихся в кэше библиотеки, для ключей с явно заданным номером.
+   Внимание! Используются не экспортируемые функции.
+
+   test-bckey05.c
+*/
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_bckey.h>
+ #include <ak_tools.h>
+
+ int main( void )
+{
+  int i, result = EXIT_SUCCESS;
+  ak_uint8 buf[16], number[32];
+  struct bckey first, second;
+
+ /* значение секретного ключа согласно ГОСТ Р 34.12-2015, приложение А.1 */
+  ak_uint8 key[32] = {
+    0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+    0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88
+  };
+ /* открытый текст и шифртекст из ГОСТ Р 34.12-2015, приложение А.1 */
+  ak_uint8 in[16] = {
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11 };
+  ak_uint8 out[16] = {
+    0xcd, 0xed, 0xd4, 0xb9, 0x42, 0x8d, 0x46, 0x5a, 0x30, 0x24, 0xbc, 0xbe, 0x90, 0x9d, 0x67, 0x7f };
+
+ /* значение секретного ключа согласно ГОСТ Р 34.12-2015, приложение А.2 */
+  ak_uint8 magma_key[32] = {
+    0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8, 0xf7, 0xf6, 0xf5, 0xf4, 0xf3, 0xf2, 0xf1, 0xf0,
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+  };
+ /* открытый текст и шифртекст из ГОСТ Р 34.12-2015, приложение А.2 */
+  ak_uint8 magma_in[8] = { 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe };
+  ak_uint8 magma_out[8] = { 0x3d, 0xca, 0xd8, 0xc2, 0xe5, 0x01, 0xe9, 0x4e };
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+  for( i = 0; i < 32; i++ ) number[i] = (ak_uint8)( 0x20 + i );
+
+ /* первый ключ разворачивается полностью и помещается в кэш,
+    второй - копируется из кэша с последующей сменой масок */
+  ak_bckey_context_create_kuznechik( &first );
+  ak_skey_context_set_number( &first.key, number, sizeof( number ));
+  ak_bckey_context_set_key( &first, key, sizeof( key ));
+
+  ak_bckey_context_create_kuznechik( &second );
+  ak_skey_context_set_number( &second.key, number, sizeof( number ));
+  ak_bckey_context_set_key( &second, key, sizeof( key ));
+
+  if( memcmp( first.key.data, second.key.data, 640 ) == 0 ) {
+    printf("kuznechik: round keys have the same masks\n");
+    result = EXIT_FAILURE;
+  }
+  ak_bckey_context_encrypt_ecb( &first, in, buf, sizeof( in ));
+  printf("kuznechik (first):  %s ", ak_ptr_to_hexstr( buf, 16, ak_false ));
+  if( ak_ptr_is_equal( buf, out, 16 )) printf("Ok\n"); else { printf("Wrong\n"); result = EXIT_FAILURE; }
+  ak_bckey_context_encrypt_ecb( &second, in, buf, sizeof( in ));
+  printf("kuznechik (second): %s ", ak_ptr_to_hexstr( buf, 16, ak_false ));
+  if( ak_ptr_is_equal( buf, out, 16 )) printf("Ok\n"); else { printf("Wrong\n"); result = EXIT_FAILURE; }
+  ak_bckey_context_decrypt_ecb( &second, out, buf, sizeof( out ));
+  if( !ak_ptr_is_equal( buf, in, 16 )) { printf("kuznechik: wrong decryption\n"); result = EXIT_FAILURE; }
+
+  ak_bckey_context_destroy( &first );
+  ak_bckey_context_destroy( &second );
+
+ /* тот же номер, но другое значение ключа не должно приводить к использованию кэша */
+  ak_bckey_context_create_kuznechik( &second );
+  ak_skey_context_set_number( &second.key, number, sizeof( number ));
+  ak_bckey_context_set_key( &second, magma_key, sizeof( magma_key ));
+  ak_bckey_context_encrypt_ecb( &second, in, buf, sizeof( in ));
+  if( ak_ptr_is_equal( buf, out, 16 )) {
+    printf("kuznechik: round keys of another key used\n");
+    result = EXIT_FAILURE;
+  }
+  ak_bckey_context_destroy( &second );
+
+ /* замена значения ключа запрещает использование кэша для ключа с тем же номером */
+  ak_bckey_context_create_kuznechik( &second );
+  ak_skey_context_set_number( &second.key, number, sizeof( number ));
+  ak_bckey_context_set_key( &second, key, sizeof( key ));
+  ak_bckey_context_set_key( &second, magma_key, sizeof( magma_key ));
+  if( second.key.flags&ak_key_flag_schedule_cache ) {
+    printf("kuznechik: schedule cache flag is not cleared after rekeying\n");
+    result = EXIT_FAILURE;
+  }
+  ak_bckey_context_encrypt_ecb( &second, in, buf, sizeof( in ));
+  if( ak_ptr_is_equal( buf, out, 16 )) {
+    printf("kuznechik: round keys of previous key used\n");
+    result = EXIT_FAILURE;
+  }
+  ak_bckey_context_destroy( &second );
+
+ /* то же самое для алгоритма Магма */
+  for( i = 0; i < 2; i++ ) {
+    ak_bckey_context_create_magma( &first );
+    ak_skey_context_set_number( &first.key, number, sizeof( number ));
+    ak_bckey_context_set_key( &first, magma_key, sizeof( magma_key ));
+    ak_bckey_context_encrypt_ecb( &first, magma_in, buf, sizeof( magma_in ));
+    printf("magma (%d): %s ", i, ak_ptr_to_hexstr( buf, 8, ak_false ));
+    if( ak_ptr_is_equal( buf, magma_out, 8 )) printf("Ok\n");
+      else { printf("Wrong\n"); result = EXIT_FAILURE; }
+    ak_bckey_context_destroy( &first );
+  }
+
+  ak_libakrypt_destroy();
+ return result;
+}
@@ -0,0 +1,158 @@
+/* Тестовый пример иллюстрирует создание копий ключей алгоритмов блочного шифрования
+   без повторного выполнения процедуры развертки ключа, а также использование
+   одного ключа несколькими потоками с общим ресурсом.
+   Внимание! Используются не экспортируемые функции.
+
+   test-bckey06.c
+*/
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_bckey.h>
+ #include <ak_tools.h>
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+ #include <pthread.h>
+#endif
+
+ int test_clone( ak_function_bckey_create *create, ak_uint8 *key, ak_uint8 *in, ak_uint8 *out )
+{
+  int i, result = EXIT_SUCCESS;
+  ak_uint8 buf[16];
+  struct bckey tmpl, copy[2];
+
+  create( &tmpl );
+  ak_bckey_context_set_key( &tmpl, key, 32 );
+
+  for( i = 0; i < 2; i++ ) {
+     if( ak_bckey_context_clone( &copy[i], &tmpl ) != ak_error_ok ) return EXIT_FAILURE;
+     if( ak_ptr_is_equal( copy[i].key.key, tmpl.key.key, 32 )) {
+       printf("%s: the same key masks\n", tmpl.key.oid->names[0] );
+       result = EXIT_FAILURE;
+     }
+  }
+ /* исходный ключ больше не нужен */
+  ak_bckey_context_destroy( &tmpl );
+
+  for( i = 0; i < 2; i++ ) {
+     ak_bckey_context_encrypt_ecb( &copy[i], in, buf, copy[i].bsize );
+     printf("%s (copy %d): %s ", copy[i].key.oid->names[0], i,
+                                                  ak_ptr_to_hexstr( buf, copy[i].bsize, ak_false ));
+     if( ak_ptr_is_equal( buf, out, copy[i].bsize )) printf("Ok\n");
+       else { printf("Wrong\n"); result = EXIT_FAILURE; }
+     ak_bckey_context_decrypt_ecb( &copy[i], out, buf, copy[i].bsize );
+     if( !ak_ptr_is_equal( buf, in, copy[i].bsize )) {
+       printf("%s (copy %d): wrong decryption\n", copy[i].key.oid->names[0], i );
+       result = EXIT_FAILURE;
+     }
+     ak_bckey_context_destroy( &copy[i] );
+  }
+ return result;
+}
+
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+/* количество потоков и размер шифруемых одним вызовом данных (в блоках) */
+ #define threads_count  (4)
+ #define chunk_blocks  (16)
+
+ static struct bckey shared;
+ static ak_uint8 plain[16*chunk_blocks], reference[16*chunk_blocks];
+ static ak_uint8 ctr_iv[8] = { 0x12, 0x34, 0x56, 0x78, 0x90, 0xab, 0xcd, 0xef };
+
+ typedef struct worker_result {
+   ssize_t blocks;
+   int errors;
+ } worker_result;
+
+/* каждый поток использует собственную рабочую копию ключа и шифрует до исчерпания ресурса */
+ static void *worker( void *ptr )
+{
+  struct bckey local;
+  ak_uint8 buf[sizeof( plain )];
+  worker_result *res = ( worker_result *) ptr;
+
+  res->blocks = 0; res->errors = 0;
+  if( ak_bckey_context_clone_shared( &local, &shared ) != ak_error_ok ) {
+    res->errors++;
+    return NULL;
+  }
+  while( ak_bckey_context_ctr( &local, plain, buf, sizeof( plain ),
+                                                     ctr_iv, sizeof( ctr_iv )) == ak_error_ok ) {
+    if( !ak_ptr_is_equal( buf, reference, sizeof( buf ))) res->errors++;
+    res->blocks += chunk_blocks;
+  }
+  ak_bckey_context_destroy( &local );
+ return NULL;
+}
+
+ int test_threads( ak_uint8 *key )
+{
+  int i, errors = 0;
+  ssize_t total = 0, resource = 1000*chunk_blocks + 5;
+  pthread_t tid[threads_count];
+  struct bckey local_ref;
+  worker_result res[threads_count];
+
+  for( i = 0; i < (int) sizeof( plain ); i++ ) plain[i] = (ak_uint8) i;
+  ak_bckey_context_create_kuznechik( &shared );
+  ak_bckey_context_set_key( &shared, key, 32 );
+
+ /* эталонное значение вырабатываем на копии, не затрагивая ресурс основного ключа */
+  ak_bckey_context_clone( &local_ref, &shared );
+  ak_bckey_context_ctr( &local_ref, plain, reference, sizeof( plain ), ctr_iv, sizeof( ctr_iv ));
+  ak_bckey_context_destroy( &local_ref );
+
+  shared.key.resource.value.counter = resource;
+  for( i = 0; i < threads_count; i++ ) pthread_create( &tid[i], NULL, worker, &res[i] );
+  for( i = 0; i < threads_count; i++ ) {
+     pthread_join( tid[i], NULL );
+     printf("thread %d: %5u blocks, %d errors\n", i, (unsigned int) res[i].blocks, res[i].errors );
+     total += res[i].blocks;
+     errors += res[i].errors;
+  }
+  printf("total: %u blocks, resource left: %u ", (unsigned int) total,
+                                                   (unsigned int) shared.key.resource.value.counter );
+  if(( errors == 0 ) && ( total <= resource ) &&
+     ( total > resource - threads_count*chunk_blocks ) &&
+     ( shared.key.resource.value.counter == resource - total )) printf("Ok\n");
+   else { printf("Wrong\n"); errors++; }
+
+  ak_bckey_context_destroy( &shared );
+ return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+#endif
+
+ int main( void )
+{
+  int result = EXIT_SUCCESS;
+
+ /* значения ключей, открытых текстов и шифртекстов из ГОСТ Р 34.12-2015, приложения А.1, А.2 */
+  ak_uint8 key[32] = {
+    0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+    0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88
+  };
+  ak_uint8 in[16] = {
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11 };
+  ak_uint8 out[16] = {
+    0xcd, 0xed, 0xd4, 0xb9, 0x42, 0x8d, 0x46, 0x5a, 0x30, 0x24, 0xbc, 0xbe, 0x90, 0x9d, 0x67, 0x7f };
+
+  ak_uint8 magma_key[32] = {
+    0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8, 0xf7, 0xf6, 0xf5, 0xf4, 0xf3, 0xf2, 0xf1, 0xf0,
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+  };
+  ak_uint8 magma_in[8] = { 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe };
+  ak_uint8 magma_out[8] = { 0x3d, 0xca, 0xd8, 0xc2, 0xe5, 0x01, 0xe9, 0x4e };
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+
+  if( test_clone( ak_bckey_context_create_kuznechik, key, in, out ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+  if( test_clone( ak_bckey_context_create_magma, magma_key, magma_in, magma_out ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+#ifdef LIBAKRYPT_HAVE_PTHREAD
+  if( test_threads( key ) != EXIT_SUCCESS ) result = EXIT_FAILURE;
+#endif
+
+  ak_libakrypt_destroy();
+ return result;
+}
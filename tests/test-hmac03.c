@@ -0,0 +1,69 @@
+/* Пример иллюстрирует использование копий контекстов функции хеширования и алгоритма HMAC:
+   контекст-шаблон подготавливается один раз, после чего вычисления продолжаются
+   с его копиями, полученными с помощью функций ak_hash_context_clone()
+                                              и ak_hmac_context_clone().
+   Внимание! Используются неэкспортируемые функции.
+
+   test-hmac03.c
+*/
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_hmac.h>
+ #include <ak_tools.h>
+
+ int main( void )
+{
+  size_t i;
+  struct hash hctx, hclone;
+  struct hmac mctx, mclone;
+  ak_uint8 out[64], out2[64], data[200];
+  int exitcode = EXIT_SUCCESS;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+  for( i = 0; i < sizeof( data ); i++ ) data[i] = (ak_uint8)( i*7 + 1 );
+
+ /* 1. функция хеширования: обрабатываем префикс и копируем промежуточное состояние */
+  ak_hash_context_create_streebog512( &hctx );
+  ak_hash_context_ptr( &hctx, data, sizeof( data ), out, sizeof( out ));
+
+  ak_hash_context_clean( &hctx );
+  ak_hash_context_update( &hctx, data, 64 );
+  ak_hash_context_update( &hctx, data+64, 13 ); /* часть данных остается во временном буффере */
+  ak_hash_context_clone( &hclone, &hctx );
+  ak_hash_context_destroy( &hctx ); /* копия не должна зависеть от исходного контекста */
+  ak_hash_context_finalize( &hclone, data+77, sizeof( data ) - 77, out2, sizeof( out2 ));
+
+  printf("streebog512 (original): %s\n", ak_ptr_to_hexstr( out, 64, ak_false ));
+  printf("streebog512 (clone):    %s ", ak_ptr_to_hexstr( out2, 64, ak_false ));
+  if( ak_ptr_is_equal( out, out2, 64 )) printf("Ok\n");
+    else { printf("Wrong\n"); exitcode = EXIT_FAILURE; }
+  ak_hash_context_destroy( &hclone );
+
+ /* 2. алгоритм HMAC: шаблон содержит ключ и обработанный блок ipad */
+  ak_hmac_context_create_streebog256( &mctx );
+  ak_hmac_context_set_key_random( &mctx, &mctx.key.generator );
+  ak_hmac_context_ptr( &mctx, data, sizeof( data ), out, sizeof( out ));
+  ak_hmac_context_clean( &mctx );
+
+  for( i = 0; i < 3; i++ ) {
+     memset( out2, 0, sizeof( out2 ));
+     ak_hmac_context_clone( &mclone, &mctx );
+     if( ak_ptr_is_equal( mclone.key.key, mctx.key.key, mctx.key.key_size )) {
+       printf("hmac (clone %u): the same key masks\n", (unsigned int) i );
+       exitcode = EXIT_FAILURE;
+     }
+     ak_hmac_context_update( &mclone, data, 128 );
+     ak_hmac_context_finalize( &mclone, data+128, sizeof( data ) - 128, out2, sizeof( out2 ));
+     printf("hmac-streebog256 (clone %u): %s ", (unsigned int) i,
+                                                             ak_ptr_to_hexstr( out2, 32, ak_false ));
+     if( ak_ptr_is_equal( out, out2, 32 )) printf("Ok\n");
+       else { printf("Wrong\n"); exitcode = EXIT_FAILURE; }
+     ak_hmac_context_destroy( &mclone );
+  }
+  ak_hmac_context_destroy( &mctx );
+
+  ak_libakrypt_destroy();
+ return exitcode;
+}
@@ -225,6 +225,142 @@
  return ( val == count );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/* тест для операции возведения в степень в представлении монтгомери */
+ bool_t modpow_test( size_t size, const char *prime, ak_uint64 n0, size_t count )
+{
+  size_t i = 0, val = 0;
+  mpz_t xm, km, zm, tm, pm, rm, sm;
+  ak_mpznmax x, k, z, p;
+  struct random generator;
+  clock_t tmr;
+
+  mpz_init(xm);
+  mpz_init(km);
+  mpz_init(zm);
+  mpz_init(tm);
+  mpz_init(pm);
+  mpz_init(rm);
+  mpz_init(sm);
+  ak_random_context_create_lcg( &generator );
+
+  if( ak_mpzn_set_hexstr( p, size, prime ) != ak_error_ok ) goto lab_exit;
+  ak_mpzn_to_mpz( p, size, pm );
+  mpz_set_ui( rm, 2 ); mpz_pow_ui( rm, rm, size*64 );
+  mpz_invert( sm, rm, pm );
+
+  for( i = 0; i < count; i++ ) {
+     int ok = 1;
+     ak_mpzn_set_random_modulo( x, p, size, &generator );
+     ak_mpzn_set_random( k, size, &generator );
+     if( i%2 ) ak_mpzn_set_ui( k, size, i );
+     ak_mpzn_to_mpz( x, size, xm );
+     ak_mpzn_to_mpz( k, size, km );
+     // x <- xr (mod p), т.е. переводим x в представление Монтгомери
+     mpz_mul( tm, xm, rm ); mpz_mod( tm, tm, pm );
+     ak_mpz_to_mpzn( tm, x, size );
+     mpz_powm( tm, xm, km, pm );
+
+     ak_mpzn_modpow_montgomery_vartime( z, x, k, p, n0, size );
+     ak_mpzn_to_mpz( z, size, zm );
+     mpz_mul( zm, zm, sm ); mpz_mod( zm, zm, pm );
+     if( mpz_cmp( tm, zm ) != 0 ) ok = 0;
+     val += ok;
+  }
+  printf(" correct exponentiations %ld from %ld\n", val, count );
+
+  /* тест на скорость */
+  ak_mpzn_set_random_modulo( x, p, size, &generator );
+  ak_mpzn_set_random( k, size, &generator );
+  ak_mpzn_to_mpz( x, size, xm );
+  ak_mpzn_to_mpz( k, size, km );
+
+  tmr = clock();
+  for( i = 0; i < count; i++ ) ak_mpzn_modpow_montgomery_vartime( x, x, k, p, n0, size );
+  tmr = clock() - tmr;
+  printf(" mpzn time: %.3fs [sliding window]\n", ((double) tmr) / ((double) CLOCKS_PER_SEC));
+
+  tmr = clock();
+  for( i = 0; i < count; i++ ) mpz_powm( xm, xm, km, pm );
+  tmr = clock() - tmr;
+  printf(" gmp time:  %.3fs\n\n", ((double) tmr) / ((double) CLOCKS_PER_SEC));
+
+  lab_exit: ak_random_context_destroy( &generator );
+  mpz_clear(sm);
+  mpz_clear(rm);
+  mpz_clear(pm);
+  mpz_clear(tm);
+  mpz_clear(zm);
+  mpz_clear(km);
+  mpz_clear(xm);
+
+ return ( val == count );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* тест для операции обращения вычетов (метод Бернштейна-Янга) */
+ bool_t inverse_test( size_t size, const char *prime, ak_uint64 n0, size_t count )
+{
+  size_t i = 0, val = 0;
+  mpz_t xm, zm, tm, pm;
+  ak_mpznmax x, z, p, k;
+  struct random generator;
+  clock_t tmr;
+
+  mpz_init(xm);
+  mpz_init(zm);
+  mpz_init(tm);
+  mpz_init(pm);
+  ak_random_context_create_lcg( &generator );
+
+  if( ak_mpzn_set_hexstr( p, size, prime ) != ak_error_ok ) goto lab_exit;
+  ak_mpzn_to_mpz( p, size, pm );
+
+  for( i = 0; i < count; i++ ) {
+     ak_mpzn_set_random_modulo( x, p, size, &generator );
+     if( i == 0 ) ak_mpzn_set_ui( x, size, 1 );
+     ak_mpzn_to_mpz( x, size, xm );
+     // z <- x^{-1}
+     ak_mpzn_inverse( z, x, p, n0, size );
+     ak_mpzn_to_mpz( z, size, zm );
+
+     mpz_invert( tm, xm, pm );
+     if( mpz_cmp(tm, zm) == 0 ) val++;
+  }
+  printf(" correct inversions %ld from %ld\n", val, count );
+
+  /* тест на скорость */
+  ak_mpzn_set_random_modulo( x, p, size, &generator );
+  ak_mpzn_to_mpz( x, size, xm );
+
+  tmr = clock();
+  for( i = 0; i < count; i++ ) ak_mpzn_inverse( x, x, p, n0, size );
+  tmr = clock() - tmr;
+  printf(" mpzn time: %.3fs [", ((double) tmr) / ((double) CLOCKS_PER_SEC));
+  printf("x = %s]\n", ak_mpzn_to_hexstr( x, size ));
+
+  ak_mpzn_set_ui( k, size, 2 );
+  ak_mpzn_sub( k, p, k, size );
+  tmr = clock();
+  for( i = 0; i < count; i++ ) ak_mpzn_modpow_montgomery_vartime( z, z, k, p, n0, size );
+  tmr = clock() - tmr;
+  printf(" mpzn time: %.3fs [exponentiation by p-2]\n", ((double) tmr) / ((double) CLOCKS_PER_SEC));
+
+  tmr = clock();
+  for( i = 0; i < count; i++ ) mpz_invert( xm, xm, pm );
+  tmr = clock() - tmr;
+  printf(" gmp time:  %.3fs [", ((double) tmr) / ((double) CLOCKS_PER_SEC));
+  printf("x = "); mpz_out_str( stdout, 16, xm ); printf("]\n\n");
+
+  lab_exit: ak_random_context_destroy( &generator );
+  mpz_clear(pm);
+  mpz_clear(tm);
+  mpz_clear(zm);
+  mpz_clear(xm);
+
+ return ( val == count );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
  int main( void )
 {
@@ -249,10 +385,13 @@
         printf(" - ak_mpzn_mul_montgomery() function test for ak_mpzn256 started\n");
         totalmany++;
         if( mul_montgomery_test( wc->size, str, wc->n, count )) howmany++;
+        printf(" - ak_mpzn_modpow_montgomery_vartime() function test for ak_mpzn256 started\n");
+        totalmany++;
+        if( modpow_test( wc->size, str, wc->n, count/100 )) howmany++;
+        printf(" - ak_mpzn_inverse() function test for ak_mpzn256 started\n");
+        totalmany++;
+        if( inverse_test( wc->size, str, wc->n, count/10 )) howmany++;
         if( str ) free( (void *)str );
-
-  // добавить modpow!!
-
       }
       if( wc->size == ak_mpzn512_size ) {
         printf(" - p: %s\n", str = ak_mpzn_to_hexstr_alloc( wc->p, wc->size ));
@@ -262,6 +401,12 @@
         printf(" - ak_mpzn_mul_montgomery() function test for ak_mpzn512 started\n");
         totalmany++;
         if( mul_montgomery_test( wc->size, str, wc->n, count )) howmany++;
+        printf(" - ak_mpzn_modpow_montgomery_vartime() function test for ak_mpzn512 started\n");
+        totalmany++;
+        if( modpow_test( wc->size, str, wc->n, count/100 )) howmany++;
+        printf(" - ak_mpzn_inverse() function test for ak_mpzn512 started\n");
+        totalmany++;
+        if( inverse_test( wc->size, str, wc->n, count/10 )) howmany++;
         if( str ) free( (void *)str );
       }
     }
@@ -0,0 +1,154 @@
+/* Тестовый пример, в котором сравниваются результаты работы развернутых реализаций
+   умножения и возведения в квадрат в представлении Монтгомери для модулей длины 256 и 512 бит
+   с результатами универсальной функции ak_mpzn_mul_montgomery(), арифметика
+   по модулям вида 2^n - c, обращение вычетов функциями ak_mpzn_inverse() и
+   ak_mpzn_inverse_montgomery(), а также возведение в степень методом скользящего окна.
+   Пример использует неэкспортируемые функции.
+
+   test-mpzn02.c
+*/
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_parameters.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+/* проверка умножения по модулям p и q заданной кривой */
+ int test_curve( const char *name, ak_wcurve wc, ak_random generator, const size_t count )
+{
+  size_t i = 0, errors = 0;
+  ak_mpzn512 x, y, z1, z2, k;
+
+  for( i = 0; i < count; i++ ) {
+     ak_mpzn_set_random( x, wc->size, generator );
+     ak_mpzn_set_random( y, wc->size, generator );
+     ak_mpzn_rem( x, x, wc->p, wc->size );
+     ak_mpzn_rem( y, y, wc->p, wc->size );
+
+     ak_mpzn_mul_montgomery( z1, x, y, wc->p, wc->n, wc->size );
+     if( wc->size == ak_mpzn256_size ) ak_mpzn_mul_montgomery_256( z2, x, y, wc->p, wc->n );
+      else ak_mpzn_mul_montgomery_512( z2, x, y, wc->p, wc->n );
+     if( ak_mpzn_cmp( z1, z2, wc->size ) != 0 ) errors++;
+
+    /* результат совпадает с одним из аргументов */
+     ak_mpzn_mul_montgomery( z1, z1, x, wc->p, wc->n, wc->size );
+     if( wc->size == ak_mpzn256_size ) ak_mpzn_mul_montgomery_256( z2, z2, x, wc->p, wc->n );
+      else ak_mpzn_mul_montgomery_512( z2, z2, x, wc->p, wc->n );
+     if( ak_mpzn_cmp( z1, z2, wc->size ) != 0 ) errors++;
+
+    /* возведение в квадрат */
+     ak_mpzn_mul_montgomery( z1, x, x, wc->p, wc->n, wc->size );
+     ak_mpzn_sqr_montgomery( z2, x, wc->p, wc->n, wc->size );
+     if( ak_mpzn_cmp( z1, z2, wc->size ) != 0 ) errors++;
+
+    /* арифметика по модулям вида 2^n - c */
+     if( ak_mpzn_is_pseudo_mersenne( wc->p, wc->size )) {
+       ak_mpzn_mul_montgomery( z1, x, y, wc->p, wc->n, wc->size );
+       ak_mpzn_mul_montgomery_pm( z2, x, y, wc->p, wc->n, wc->size );
+       if( ak_mpzn_cmp( z1, z2, wc->size ) != 0 ) errors++;
+       ak_mpzn_sqr_montgomery( z1, x, wc->p, wc->n, wc->size );
+       ak_mpzn_sqr_montgomery_pm( z2, x, wc->p, wc->n, wc->size );
+       if( ak_mpzn_cmp( z1, z2, wc->size ) != 0 ) errors++;
+       ak_mpzn_add_montgomery( z1, x, y, wc->p, wc->size );
+       ak_mpzn_add_pm( z2, x, y, wc->p, wc->size );
+       if( ak_mpzn_cmp( z1, z2, wc->size ) != 0 ) errors++;
+       ak_mpzn_sub_montgomery( z1, x, y, wc->p, wc->size );
+       ak_mpzn_sub_pm( z2, x, y, wc->p, wc->size );
+       if( ak_mpzn_cmp( z1, z2, wc->size ) != 0 ) errors++;
+      /* проверяем, что вычитание согласовано со сложением */
+       ak_mpzn_add_montgomery( z1, z1, y, wc->p, wc->size );
+       if( ak_mpzn_cmp( z1, x, wc->size ) != 0 ) errors++;
+     }
+
+    /* обращение по модулю p: сравниваем с возведением в степень p-2 */
+     if( i < count/10 ) {
+       ak_mpzn_set_ui( k, wc->size, 2 );
+       ak_mpzn_sub( k, wc->p, k, wc->size );
+       ak_mpzn_inverse_montgomery( z2, x, wc->p, wc->n, wc->r2, wc->size );
+       ak_mpzn_modpow_montgomery_vartime( z1, x, k, wc->p, wc->n, wc->size );
+       if( ak_mpzn_cmp( z1, z2, wc->size ) != 0 ) errors++;
+      /* проверяем, что x*x^{-1} = 1 для вычетов в естественном представлении */
+       ak_mpzn_inverse( z1, x, wc->p, wc->n, wc->size );
+       ak_mpzn_mul_montgomery( z1, z1, x, wc->p, wc->n, wc->size );
+       ak_mpzn_mul_montgomery( z1, z1, wc->r2, wc->p, wc->n, wc->size );
+       if( ak_mpzn_cmp_ui( z1, wc->size, 1 ) != ak_true ) errors++;
+     }
+
+    /* возведение в степень со скользящим окном: x^k * x^{p-1-k} = 1 */
+     if( i < count/10 ) {
+       ak_mpzn_set_random_modulo( k, wc->p, wc->size, generator );
+       if( i%4 == 1 ) ak_mpzn_set_ui( k, wc->size, i );
+       if( i%4 == 2 ) ak_mpzn_set_ui( k, wc->size, i%64 );
+       ak_mpzn_modpow_montgomery_vartime( z1, x, k, wc->p, wc->n, wc->size );
+       ak_mpzn_set_ui( z2, wc->size, 1 );
+       ak_mpzn_add( k, k, z2, wc->size );
+       ak_mpzn_sub( k, wc->p, k, wc->size );
+       ak_mpzn_modpow_montgomery_vartime( z2, x, k, wc->p, wc->n, wc->size );
+       ak_mpzn_mul_montgomery( z1, z1, z2, wc->p, wc->n, wc->size );
+       ak_mpzn_set_ui( z2, wc->size, 1 );
+       ak_mpzn_mul_montgomery( z1, z1, z2, wc->p, wc->n, wc->size );
+       if( ak_mpzn_cmp_ui( z1, wc->size, 1 ) != ak_true ) errors++;
+     }
+
+    /* умножение по модулю q */
+     ak_mpzn_rem( x, x, wc->q, wc->size );
+     ak_mpzn_rem( y, y, wc->q, wc->size );
+     ak_mpzn_mul_montgomery( z1, x, y, wc->q, wc->nq, wc->size );
+     if( wc->size == ak_mpzn256_size ) ak_mpzn_mul_montgomery_256( z2, x, y, wc->q, wc->nq );
+      else ak_mpzn_mul_montgomery_512( z2, x, y, wc->q, wc->nq );
+     if( ak_mpzn_cmp( z1, z2, wc->size ) != 0 ) errors++;
+
+    /* обращение по модулю q */
+     if( i < count/10 ) {
+       ak_mpzn_set_ui( k, wc->size, 2 );
+       ak_mpzn_sub( k, wc->q, k, wc->size );
+       ak_mpzn_modpow_montgomery_vartime( z1, x, k, wc->q, wc->nq, wc->size );
+       ak_mpzn_inverse_montgomery( z2, x, wc->q, wc->nq, wc->r2q, wc->size );
+       if( ak_mpzn_cmp( z1, z2, wc->size ) != 0 ) errors++;
+     }
+  }
+
+ /* граничные значения: 0, 1 и p-1 */
+  ak_mpzn_set_ui( x, wc->size, 0 );
+  ak_mpzn_inverse( z1, x, wc->p, wc->n, wc->size );
+  if( ak_mpzn_cmp_ui( z1, wc->size, 0 ) != ak_true ) errors++;
+  ak_mpzn_set_ui( x, wc->size, 1 );
+  ak_mpzn_inverse( z1, x, wc->p, wc->n, wc->size );
+  if( ak_mpzn_cmp_ui( z1, wc->size, 1 ) != ak_true ) errors++;
+  ak_mpzn_sub( x, wc->p, x, wc->size );
+  ak_mpzn_inverse( z1, x, wc->p, wc->n, wc->size );
+  if( ak_mpzn_cmp( z1, x, wc->size ) != 0 ) errors++;
+
+  printf("%s: %u errors in %u iterations\n",
+                                             name, (unsigned int) errors, (unsigned int) count );
+ return ( errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  struct random generator;
+  int result = EXIT_SUCCESS;
+
+  ak_random_context_create_lcg( &generator );
+
+  if( test_curve( "id_tc26_gost_3410_2012_256_paramSetA",
+      ( ak_wcurve ) &id_tc26_gost_3410_2012_256_paramSetA, &generator, 5000 ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+  if( test_curve( "id_rfc4357_gost_3410_2001_paramSetC",
+      ( ak_wcurve ) &id_rfc4357_gost_3410_2001_paramSetC, &generator, 5000 ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+  if( test_curve( "id_libakrypt_gost_3410_2012_256_paramSet_N0",
+      ( ak_wcurve ) &id_libakrypt_gost_3410_2012_256_paramSet_N0, &generator, 5000 ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+  if( test_curve( "id_tc26_gost_3410_2012_512_paramSetA",
+      ( ak_wcurve ) &id_tc26_gost_3410_2012_512_paramSetA, &generator, 5000 ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+  if( test_curve( "id_tc26_gost_3410_2012_512_paramSetTest",
+      ( ak_wcurve ) &id_tc26_gost_3410_2012_512_paramSetTest, &generator, 5000 ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+
+  ak_random_context_destroy( &generator );
+ return result;
+}
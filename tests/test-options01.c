@@ -0,0 +1,52 @@
+/* Тестовый пример, иллюстрирующий доступ к опциям библиотеки по имени и по индексу.
+   Пример использует неэкспортируемые функции.
+
+   test-options01.c
+*/
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <ak_tools.h>
+
+ int main( void )
+{
+  size_t idx = 0;
+  ak_int64 value = 0;
+  int result = EXIT_SUCCESS;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+
+ /* количество и порядок опций должны совпадать с перечислением option_index_t */
+  if( ak_libakrypt_options_count() != ak_option_count ) {
+    printf("wrong number of options: %u (expected %u)\n",
+                        (unsigned int) ak_libakrypt_options_count(), (unsigned int) ak_option_count );
+    result = EXIT_FAILURE;
+  }
+  for( idx = 0; idx < ak_libakrypt_options_count(); idx++ ) {
+     char *name = ak_libakrypt_get_option_name( idx );
+     value = ak_libakrypt_get_option_by_index(( option_index_t ) idx );
+     printf("%2u: %-42s %lld ", (unsigned int) idx, name, (long long int) value );
+     if(( value == ak_libakrypt_get_option( name )) &&
+        ( value == ak_libakrypt_get_option_value( idx ))) printf("Ok\n");
+       else { printf("Wrong\n"); result = EXIT_FAILURE; }
+  }
+
+ /* изменение значения по индексу должно быть видно при поиске по имени и наоборот */
+  value = ak_libakrypt_get_option_by_index( ak_option_acpkm_message_count );
+  ak_libakrypt_set_option_by_index( ak_option_acpkm_message_count, value + 1 );
+  if( ak_libakrypt_get_option( "acpkm_message_count" ) != value + 1 ) result = EXIT_FAILURE;
+  ak_libakrypt_set_option( "acpkm_message_count", value );
+  if( ak_libakrypt_get_option_by_index( ak_option_acpkm_message_count ) != value )
+    result = EXIT_FAILURE;
+
+ /* некорректный индекс */
+  if( ak_libakrypt_get_option_by_index( ak_option_count ) != ak_error_wrong_option )
+    result = EXIT_FAILURE;
+  if( ak_libakrypt_set_option_by_index( ak_option_count, 0 ) != ak_error_wrong_option )
+    result = EXIT_FAILURE;
+
+  if( result == EXIT_SUCCESS ) printf("all options are accessible by name and index\n");
+  ak_libakrypt_destroy();
+ return result;
+}
@@ -0,0 +1,99 @@
+/* Пример иллюстрирует пакетную проверку электронных подписей, выработанных
+   на различных ключах и различных эллиптических кривых, и сравнивает результаты
+   с результатами последовательной проверки подписей.
+   Внимание! Используются неэкспортируемые функции.
+
+   test-sign04.c
+*/
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_sign.h>
+
+/* количество проверяемых подписей */
+ #define count   (120)
+
+ int main( void )
+{
+  size_t i = 0, errors = 0;
+  int result = EXIT_SUCCESS;
+  struct signkey sk[3];
+  struct verifykey pk[3];
+  struct verify_batch_item items[count];
+  ak_uint8 hash[count][64], sign[count][128];
+  const char *curves[3] = { "id-tc26-gost-3410-2012-256-paramSetA",
+                            "id-rfc4357-gost-3410-2001-paramSetC",
+                            "id-tc26-gost-3410-2012-512-paramSetA" };
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+
+ /* создаем ключи */
+  for( i = 0; i < 3; i++ ) {
+     ak_oid oid = ak_oid_context_find_by_name( curves[i] );
+     if(( oid == NULL ) ||
+        ( ak_signkey_context_create( sk+i, (ak_wcurve) oid->data ) != ak_error_ok )) {
+       printf("incorrect creation of secret key for %s\n", curves[i] );
+       return ak_libakrypt_destroy();
+     }
+     ak_signkey_context_set_key_random( sk+i, &sk[i].key.generator );
+     ak_verifykey_context_create_from_signkey( pk+i, sk+i );
+  }
+
+ /* вырабатываем подписи */
+  for( i = 0; i < count; i++ ) {
+     size_t idx = i%3, hsize = 8*pk[idx].wc->size;
+
+     memset( hash[i], (int)( i+1 ), sizeof( hash[i] ));
+     ak_signkey_context_sign_hash( sk+idx, hash[i], hsize, sign[i], sizeof( sign[i] ));
+     items[i].key = pk+idx;
+     items[i].hash = hash[i];
+     items[i].hsize = hsize;
+     items[i].sign = sign[i];
+  }
+
+ /* портим некоторые подписи */
+  sign[5][3] ^= 0x01;      /* искаженное значение s */
+  sign[17][100] ^= 0x80;   /* искаженное значение r */
+  hash[22][0] ^= 0x01;     /* искаженный хеш-код */
+  items[31].hsize = 48;    /* неверная длина хеш-кода */
+  items[43].sign = NULL;   /* подпись не определена */
+  items[58].key = pk;      /* подпись выработана на другом ключе */
+  memset( sign[64] + 8*pk[1].wc->size, 0, 8*pk[1].wc->size ); /* r = 0 */
+ /* граничные значения подписи: результаты пакетной и одиночной проверки должны совпадать */
+  memset( sign[71], 0, sizeof( sign[71] ));                   /* r = s = 0 */
+  memset( sign[76], 0, 8*pk[1].wc->size );                    /* s = 0 */
+  memset( sign[83] + 8*pk[2].wc->size, 0xff, 8*pk[2].wc->size ); /* r > q */
+  ak_mpzn_to_little_endian( pk[0].wc->q, pk[0].wc->size,      /* s = q */
+                                                  sign[90], 8*pk[0].wc->size, ak_true );
+  ak_mpzn_to_little_endian( pk[1].wc->q, pk[1].wc->size,      /* r = q */
+                             sign[97] + 8*pk[1].wc->size, 8*pk[1].wc->size, ak_true );
+
+ /* проверяем подписи */
+  if( ak_verifykey_context_verify_batch( items, count ) != ak_error_ok ) {
+    printf("incorrect verification of signatures batch\n");
+    result = EXIT_FAILURE;
+  }
+  for( i = 0; i < count; i++ ) {
+     bool_t expected = ak_true;
+     if(( i == 5 ) || ( i == 17 ) || ( i == 22 ) || ( i == 31 ) || ( i == 43 ) ||
+        ( i == 58 ) || ( i == 64 ) || ( i == 71 ) || ( i == 76 ) || ( i == 83 ) ||
+        ( i == 90 ) || ( i == 97 )) expected = ak_false;
+     if( items[i].result != expected ) errors++;
+     if(( items[i].sign != NULL ) && ( items[i].hsize == 8*items[i].key->wc->size )) {
+       if( ak_verifykey_context_verify_hash( items[i].key,
+                                       items[i].hash, items[i].hsize, items[i].sign ) != expected )
+         errors++;
+     }
+  }
+  printf("batch verification: %u errors in %u signatures\n",
+                                                   (unsigned int) errors, (unsigned int) count );
+  if( errors ) result = EXIT_FAILURE;
+
+  for( i = 0; i < 3; i++ ) {
+     ak_verifykey_context_destroy( pk+i );
+     ak_signkey_context_destroy( sk+i );
+  }
+  ak_libakrypt_destroy();
+ return result;
+}
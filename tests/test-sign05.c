@@ -0,0 +1,81 @@
+/* Пример иллюстрирует выработку электронной подписи с использованием пула заранее
+   вычисленных пар (k, r). Подписи, выработанные с использованием элементов пула и
+   без них (после исчерпания пула), проверяются на открытом ключе.
+   Внимание! Используются неэкспортируемые функции.
+
+   test-sign05.c
+*/
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_sign.h>
+
+/* размер пула и количество вырабатываемых подписей */
+ #define pool_size   (16)
+ #define count       (40)
+
+/* ----------------------------------------------------------------------------------------------- */
+ int test_curve( const char *name )
+{
+  size_t i = 0, errors = 0;
+  struct signkey sk;
+  struct verifykey pk;
+  ak_uint8 hash[64], sign[128];
+  ak_oid oid = ak_oid_context_find_by_name( name );
+
+  if(( oid == NULL ) ||
+     ( ak_signkey_context_create( &sk, (ak_wcurve) oid->data ) != ak_error_ok )) {
+    printf("incorrect creation of secret key for %s\n", name );
+    return EXIT_FAILURE;
+  }
+  ak_signkey_context_set_key_random( &sk, &sk.key.generator );
+  ak_verifykey_context_create_from_signkey( &pk, &sk );
+
+ /* создаем и заполняем пул */
+  if( ak_signkey_context_enable_pool( &sk, pool_size ) != ak_error_ok ) errors++;
+  if( ak_signkey_context_fill_pool( &sk ) != ak_error_ok ) errors++;
+  if( ak_signkey_context_get_pool_count( &sk ) != pool_size ) errors++;
+
+ /* вырабатываем подписи: сначала с использованием пула, затем без него */
+  for( i = 0; i < count; i++ ) {
+     memset( hash, (int)( i+1 ), sizeof( hash ));
+     if( ak_signkey_context_sign_hash( &sk, hash,
+                                     8*pk.wc->size, sign, sizeof( sign )) != ak_error_ok ) errors++;
+     if( ak_verifykey_context_verify_hash( &pk, hash, 8*pk.wc->size, sign ) != ak_true ) errors++;
+    /* искаженная подпись не должна проходить проверку */
+     sign[i%( 16*pk.wc->size )] ^= 0x01;
+     if( ak_verifykey_context_verify_hash( &pk, hash, 8*pk.wc->size, sign ) != ak_false ) errors++;
+  }
+
+ /* после заполнения пул уничтожается вместе с ключом */
+  if( ak_signkey_context_fill_pool( &sk ) != ak_error_ok ) errors++;
+  if( ak_signkey_context_get_pool_count( &sk ) != pool_size ) errors++;
+  if( ak_signkey_context_get_pool_error( &sk ) != ak_error_ok ) errors++;
+  if( ak_signkey_context_disable_pool( &sk ) != ak_error_ok ) errors++;
+  if( ak_signkey_context_get_pool_count( &sk ) != 0 ) errors++;
+  if( ak_signkey_context_enable_pool( &sk, pool_size ) != ak_error_ok ) errors++;
+
+  printf("%s: %u errors in %u signatures\n", name, (unsigned int) errors, (unsigned int) count );
+  ak_verifykey_context_destroy( &pk );
+  ak_signkey_context_destroy( &sk );
+ return ( errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  int result = EXIT_SUCCESS;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+
+  if( test_curve( "id-tc26-gost-3410-2012-256-paramSetA" ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+  if( test_curve( "id-rfc4357-gost-3410-2001-paramSetC" ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+  if( test_curve( "id-tc26-gost-3410-2012-512-paramSetA" ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+
+  ak_libakrypt_destroy();
+ return result;
+}
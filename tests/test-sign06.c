@@ -0,0 +1,98 @@
+/* Пример иллюстрирует пакетную выработку электронных подписей на одном секретном ключе,
+   в том числе с использованием пула заранее вычисленных пар (k, r), и проверяет
+   выработанные подписи, а также учет ресурса ключа и смену маски ключа
+   с заданной периодичностью.
+   Внимание! Используются неэкспортируемые функции.
+
+   test-sign06.c
+*/
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_sign.h>
+
+/* количество вырабатываемых подписей */
+ #define count   (150)
+
+/* ----------------------------------------------------------------------------------------------- */
+ int test_curve( const char *name )
+{
+  ssize_t resource = 0;
+  size_t i = 0, errors = 0, lb = 0;
+  struct signkey sk;
+  struct verifykey pk;
+  ak_uint8 hash[count*64], sign[count*128], mask[64];
+  ak_oid oid = ak_oid_context_find_by_name( name );
+
+  if(( oid == NULL ) ||
+     ( ak_signkey_context_create( &sk, (ak_wcurve) oid->data ) != ak_error_ok )) {
+    printf("incorrect creation of secret key for %s\n", name );
+    return EXIT_FAILURE;
+  }
+  ak_signkey_context_set_key_random( &sk, &sk.key.generator );
+  ak_verifykey_context_create_from_signkey( &pk, &sk );
+  lb = 8*pk.wc->size;
+  for( i = 0; i < count; i++ ) memset( hash + i*lb, (int)( i+1 ), lb ); /* хеш-коды идут подряд */
+
+ /* подписи вырабатываются частично с использованием пула */
+  ak_signkey_context_enable_pool( &sk, 20 );
+  ak_signkey_context_fill_pool( &sk );
+  resource = sk.key.resource.value.counter;
+  if( ak_signkey_context_sign_batch( &sk, hash, count, sign, sizeof( sign )) != ak_error_ok )
+    errors++;
+  if( sk.key.resource.value.counter != resource - count ) errors++;
+
+ /* подписи проверяются на открытом ключе */
+  for( i = 0; i < count; i++ )
+     if( ak_verifykey_context_verify_hash( &pk, hash + i*lb, lb, sign + 2*i*lb ) != ak_true )
+       errors++;
+
+ /* маска изменяется после выработки каждой подписи с использованием запаса пар масок */
+  for( i = 0; i < count/2; i++ ) {
+     memcpy( mask, sk.key.key + sk.key.key_size, lb );
+     if( ak_signkey_context_sign_hash( &sk, hash + i*lb, lb, sign, 2*lb ) != ak_error_ok ) errors++;
+     if( ak_verifykey_context_verify_hash( &pk, hash + i*lb, lb, sign ) != ak_true ) errors++;
+     if( memcmp( mask, sk.key.key + sk.key.key_size, lb ) == 0 ) errors++;
+  }
+
+ /* маска изменяется после выработки каждой третьей подписи */
+  ak_signkey_context_set_remask_period( &sk, 3 );
+  for( i = 0; i < 9; i++ ) {
+     memcpy( mask, sk.key.key + sk.key.key_size, lb );
+     ak_signkey_context_sign_hash( &sk, hash + i*lb, lb, sign, 2*lb );
+     if( ak_verifykey_context_verify_hash( &pk, hash + i*lb, lb, sign ) != ak_true ) errors++;
+     if(( memcmp( mask, sk.key.key + sk.key.key_size, lb ) == 0 ) != ( i%3 != 2 )) errors++;
+  }
+  if( ak_signkey_context_set_remask_period( &sk, 0 ) == ak_error_ok ) errors++;
+
+ /* при недостатке ресурса подписи не вырабатываются */
+  sk.key.resource.value.counter = count - 1;
+  if( ak_signkey_context_sign_batch( &sk, hash, count, sign, sizeof( sign ))
+                                                             != ak_error_low_key_resource ) errors++;
+  if( ak_signkey_context_sign_batch( &sk, hash, count, sign, 2*lb ) != ak_error_wrong_length )
+    errors++;
+
+  printf("%s: %u errors in %u signatures\n", name, (unsigned int) errors, (unsigned int) count );
+  ak_verifykey_context_destroy( &pk );
+  ak_signkey_context_destroy( &sk );
+ return ( errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  int result = EXIT_SUCCESS;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+
+  if( test_curve( "id-tc26-gost-3410-2012-256-paramSetA" ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+  if( test_curve( "id-rfc4357-gost-3410-2001-paramSetC" ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+  if( test_curve( "id-tc26-gost-3410-2012-512-paramSetA" ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+
+  ak_libakrypt_destroy();
+ return result;
+}
@@ -0,0 +1,81 @@
+/* Пример иллюстрирует выработку и проверку электронной подписи для данных, поступающих
+   фрагментами произвольной длины. Результаты сравниваются с результатами функций,
+   обрабатывающих сообщение целиком.
+   Внимание! Используются неэкспортируемые функции.
+
+   test-sign07.c
+*/
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_sign.h>
+
+/* длина сообщения */
+ #define length   (3000)
+
+/* ----------------------------------------------------------------------------------------------- */
+ int test_curve( const char *name, ak_uint8 *data )
+{
+  size_t i = 0, errors = 0, offset = 0, chunk = 0;
+  struct signkey sk;
+  struct verifykey pk;
+  ak_uint8 sign[128];
+  ak_oid oid = ak_oid_context_find_by_name( name );
+
+  if(( oid == NULL ) ||
+     ( ak_signkey_context_create( &sk, (ak_wcurve) oid->data ) != ak_error_ok )) {
+    printf("incorrect creation of secret key for %s\n", name );
+    return EXIT_FAILURE;
+  }
+  ak_signkey_context_set_key_random( &sk, &sk.key.generator );
+  ak_verifykey_context_create_from_signkey( &pk, &sk );
+
+  for( i = 0; i < 4; i++ ) {
+    /* подпись данных, поступающих фрагментами, проверяется для сообщения целиком */
+     ak_signkey_context_clean( &sk );
+     for( offset = 0, chunk = 1; offset + chunk < length - i; offset += chunk, chunk = 7*chunk+i )
+        if( ak_signkey_context_update( &sk, data + offset, chunk ) != ak_error_ok ) errors++;
+     if( ak_signkey_context_finalize( &sk, data + offset,
+                                      length - i - offset, sign, sizeof( sign )) != ak_error_ok )
+       errors++;
+     if( ak_verifykey_context_verify_ptr( &pk, data, length - i, sign ) != ak_true ) errors++;
+
+    /* подпись сообщения целиком проверяется для данных, поступающих фрагментами */
+     ak_signkey_context_sign_ptr( &sk, data, length - i, sign, sizeof( sign ));
+     ak_verifykey_context_clean( &pk );
+     for( offset = 0, chunk = 64; offset + chunk < length - i; offset += chunk, chunk += 13 )
+        if( ak_verifykey_context_update( &pk, data + offset, chunk ) != ak_error_ok ) errors++;
+     if( ak_verifykey_context_finalize( &pk, data + offset,
+                                                  length - i - offset, sign ) != ak_true ) errors++;
+
+    /* искаженные данные не проходят проверку */
+     ak_verifykey_context_clean( &pk );
+     ak_verifykey_context_update( &pk, data, length - i - 1 );
+     if( ak_verifykey_context_finalize( &pk, NULL, 0, sign ) != ak_false ) errors++;
+  }
+
+  printf("%s: %u errors\n", name, (unsigned int) errors );
+  ak_verifykey_context_destroy( &pk );
+  ak_signkey_context_destroy( &sk );
+ return ( errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  size_t i = 0;
+  ak_uint8 data[length];
+  int result = EXIT_SUCCESS;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+  for( i = 0; i < length; i++ ) data[i] = ( ak_uint8 )( i*i + 7 );
+
+  if( test_curve( "id-tc26-gost-3410-2012-256-paramSetA", data ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+  if( test_curve( "id-tc26-gost-3410-2012-512-paramSetA", data ) != EXIT_SUCCESS )
+    result = EXIT_FAILURE;
+
+  ak_libakrypt_destroy();
+ return result;
+}
@@ -0,0 +1,109 @@
+/* Пример иллюстрирует проверку открытых ключей и одновременную проверку всех звеньев
+   цепочки сертификатов, а также сравнивает результаты с последовательной проверкой подписей.
+   Внимание! Используются неэкспортируемые функции.
+
+   test-sign08.c
+*/
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_sign.h>
+
+/* количество звеньев цепочки */
+ #define count   (6)
+
+ int main( void )
+{
+  size_t i = 0, errors = 0;
+  int result = EXIT_SUCCESS;
+  struct signkey sk[count];
+  struct verifykey pk[count], vk;
+  struct verify_batch_item links[count];
+  ak_uint8 hash[count][64], sign[count][128], saved[2][128];
+  const char *curves[3] = { "id-tc26-gost-3410-2012-256-paramSetA",
+                            "id-rfc4357-gost-3410-2001-paramSetC",
+                            "id-tc26-gost-3410-2012-512-paramSetA" };
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+
+ /* создаем ключи: ключ с индексом 0 является корневым */
+  for( i = 0; i < count; i++ ) {
+     ak_oid oid = ak_oid_context_find_by_name( curves[i%3] );
+     if(( oid == NULL ) ||
+        ( ak_signkey_context_create( sk+i, (ak_wcurve) oid->data ) != ak_error_ok )) {
+       printf("incorrect creation of secret key for %s\n", curves[i%3] );
+       return ak_libakrypt_destroy();
+     }
+     ak_signkey_context_set_key_random( sk+i, &sk[i].key.generator );
+     ak_verifykey_context_create_from_signkey( pk+i, sk+i );
+  }
+
+ /* звено i подписывается ключом издателя i-1, корневое звено -- собственным ключом */
+  for( i = 0; i < count; i++ ) {
+     size_t issuer = ( i == 0 ) ? 0 : i-1, hsize = 8*pk[issuer].wc->size;
+
+     memset( hash[i], (int)( i+1 ), sizeof( hash[i] ));
+     ak_signkey_context_sign_hash( sk+issuer, hash[i], hsize, sign[i], sizeof( sign[i] ));
+     links[i].key = pk+issuer;
+     links[i].hash = hash[i];
+     links[i].hsize = hsize;
+     links[i].sign = sign[i];
+  }
+
+ /* проверяем корректную цепочку дважды: второй раз ключи не проверяются */
+  if( ak_verifykey_context_verify_chain( links, count ) != ak_true ) errors++;
+  for( i = 0; i < count; i++ ) /* ключ последнего звена не используется для проверки */
+     if((( pk[i].flags&ak_key_flag_public_key_checked ) == 0 ) != ( i == count-1 )) errors++;
+  if( ak_verifykey_context_verify_chain( links, count ) != ak_true ) errors++;
+
+ /* искажаем подпись одного звена */
+  sign[3][5] ^= 0x01;
+  if( ak_verifykey_context_verify_chain( links, count ) != ak_false ) errors++;
+  for( i = 0; i < count; i++ ) {
+     if( links[i].result != ( i == 3 ? ak_false : ak_true )) errors++;
+     if( links[i].result != ak_verifykey_context_verify_hash( links[i].key,
+                                         links[i].hash, links[i].hsize, links[i].sign )) errors++;
+  }
+  sign[3][5] ^= 0x01;
+
+ /* нулевая подпись одного звена и значение r, равное q, в подписи другого звена */
+  memcpy( saved[0], sign[4], sizeof( sign[4] ));
+  memcpy( saved[1], sign[5], sizeof( sign[5] ));
+  memset( sign[4], 0, sizeof( sign[4] ));
+  ak_mpzn_to_little_endian( links[5].key->wc->q, links[5].key->wc->size,
+                       sign[5] + links[5].hsize, links[5].hsize, ak_true );
+  if( ak_verifykey_context_verify_chain( links, count ) != ak_false ) errors++;
+  for( i = 0; i < count; i++ ) {
+     if( links[i].result != ( i >= 4 ? ak_false : ak_true )) errors++;
+     if( links[i].result != ak_verifykey_context_verify_hash( links[i].key,
+                                         links[i].hash, links[i].hsize, links[i].sign )) errors++;
+  }
+  memcpy( sign[4], saved[0], sizeof( sign[4] ));
+  memcpy( sign[5], saved[1], sizeof( sign[5] ));
+
+ /* новый контекст для того же ключа проверяется с использованием кэша */
+  ak_verifykey_context_create( &vk, pk[1].wc );
+  ak_wpoint_set_wpoint( &vk.qpoint, &pk[1].qpoint, vk.wc );
+  if( ak_verifykey_context_validate( &vk ) != ak_error_ok ) errors++;
+
+ /* точка, не принадлежащая кривой */
+  vk.flags = 0;
+  vk.qpoint.y[0] ^= 0x01;
+  if( ak_verifykey_context_validate( &vk ) != ak_error_curve_point ) errors++;
+  links[2].key = &vk;
+  if( ak_verifykey_context_verify_chain( links, count ) != ak_false ) errors++;
+  if(( links[2].result != ak_false ) || ( links[1].result != ak_true )) errors++;
+  if(( vk.flags&ak_key_flag_public_key_checked ) != 0 ) errors++;
+
+  printf("chain verification: %u errors in %u links\n", (unsigned int) errors, count );
+  if( errors ) result = EXIT_FAILURE;
+
+  ak_verifykey_context_destroy( &vk );
+  for( i = 0; i < count; i++ ) {
+     ak_verifykey_context_destroy( pk+i );
+     ak_signkey_context_destroy( sk+i );
+  }
+  ak_libakrypt_destroy();
+ return result;
+}
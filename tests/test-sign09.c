@@ -0,0 +1,138 @@
+/* Пример иллюстрирует одновременное вычисление сумм кратных точек векторной реализацией
+   (функция ak_wpoint_pow_joint_lanes()) и пакетную проверку электронных подписей с ее
+   использованием; результаты сравниваются с последовательными вычислениями.
+   Если процессор не поддерживает инструкции AVX-512 IFMA, то проверяется только
+   пакетная проверка подписей.
+   Внимание! Используются неэкспортируемые функции.
+
+   test-sign09.c
+*/
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_tools.h>
+ #include <ak_sign.h>
+
+/* количество проверяемых подписей */
+ #define count   (40)
+
+/* ----------------------------------------------------------------------------------------------- */
+/* сравнение сумм кратных точек, вычисленных одновременно и последовательно */
+ static size_t test_lanes( ak_wcurve wc, ak_random generator, const size_t number )
+{
+  ak_mpzn512 k;
+  size_t i = 0, errors = 0;
+  struct wpoint points[ ak_wpoint_lanes_count ], results[ ak_wpoint_lanes_count ], wr;
+  ak_wpoint qpoints[ ak_wpoint_lanes_count ];
+  ak_uint64 k1[ ak_wpoint_lanes_count*ak_mpzn512_size ],
+            k2[ ak_wpoint_lanes_count*ak_mpzn512_size ];
+
+  memset( k1, 0, sizeof( k1 ));
+  memset( k2, 0, sizeof( k2 ));
+  for( i = 0; i < number; i++ ) {
+     ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+     ak_wpoint_pow( points+i, &wc->point, k, wc->size, wc );
+     ak_wpoint_reduce( points+i, wc );
+     qpoints[i] = points+i;
+     ak_mpzn_set_random_modulo( k1 + i*ak_mpzn512_size, wc->q, wc->size, generator );
+     ak_mpzn_set_random_modulo( k2 + i*ak_mpzn512_size, wc->q, wc->size, generator );
+  }
+ /* граничные значения: нулевые степени, единица, q-1 и равные слагаемые */
+  ak_mpzn_set_ui( k1, wc->size, 0 );
+  ak_mpzn_set_ui( k2 + ak_mpzn512_size, wc->size, 0 );
+  ak_mpzn_set_ui( k1 + 2*ak_mpzn512_size, wc->size, 1 );
+  ak_mpzn_set_ui( k, wc->size, 1 );
+  ak_mpzn_sub( k2 + 2*ak_mpzn512_size, wc->q, k, wc->size );
+  ak_wpoint_set( points+3, wc );
+  ak_mpzn_set( k2 + 3*ak_mpzn512_size, k1 + 3*ak_mpzn512_size, wc->size );
+
+  if( ak_wpoint_pow_joint_lanes( results, k1, qpoints, k2, number, wc ) != ak_error_ok )
+    return number;
+  for( i = 0; i < number; i++ ) {
+     ak_wpoint_pow_joint( &wr, k1 + i*ak_mpzn512_size,
+                                             qpoints[i], k2 + i*ak_mpzn512_size, wc->size, wc );
+     ak_wpoint_reduce( &wr, wc );
+     ak_wpoint_reduce( results+i, wc );
+     if( ak_mpzn_cmp( wr.x, results[i].x, wc->size ) ||
+         ak_mpzn_cmp( wr.y, results[i].y, wc->size ) ||
+         ak_mpzn_cmp( wr.z, results[i].z, wc->size )) errors++;
+  }
+ return errors;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  struct random generator;
+  size_t i = 0, j = 0, errors = 0;
+  int result = EXIT_SUCCESS;
+  struct signkey sk[2];
+  struct verifykey pk[2];
+  struct verify_batch_item items[count];
+  ak_uint8 hash[count][64], sign[count][128];
+  const char *curves[4] = { "id-tc26-gost-3410-2012-256-paramSetA",
+                            "id-rfc4357-gost-3410-2001-paramSetC",
+                            "id-tc26-gost-3410-2012-512-paramSetA",
+                            "id-tc26-gost-3410-2012-512-paramSetC" };
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+  ak_random_context_create_lcg( &generator );
+
+ /* сравниваем одновременные и последовательные вычисления */
+  for( i = 0; i < 4; i++ ) {
+     ak_wcurve wc = ( ak_wcurve ) ak_oid_context_find_by_name( curves[i] )->data;
+     if( !ak_wcurve_lanes_is_available( wc )) {
+       printf("%s: vector implementation is not available\n", curves[i] );
+       continue;
+     }
+     errors = test_lanes( wc, &generator, ak_wpoint_lanes_count );
+     errors += test_lanes( wc, &generator, 5 );
+     printf("%s: %u errors in joint multiplication\n", curves[i], (unsigned int) errors );
+     if( errors ) result = EXIT_FAILURE;
+  }
+  ak_random_context_destroy( &generator );
+
+ /* создаем ключи и вырабатываем подписи */
+  for( i = 0; i < 2; i++ ) {
+     ak_signkey_context_create_str( sk+i, curves[2*i] );
+     ak_signkey_context_set_key_random( sk+i, &sk[i].key.generator );
+     ak_verifykey_context_create_from_signkey( pk+i, sk+i );
+  }
+  for( i = 0; i < count; i++ ) {
+     size_t idx = ( i < 3*count/4 ) ? 0 : 1, hsize = 8*pk[idx].wc->size;
+
+     memset( hash[i], (int)( i+1 ), sizeof( hash[i] ));
+     ak_signkey_context_sign_hash( sk+idx, hash[i], hsize, sign[i], sizeof( sign[i] ));
+     items[i].key = pk+idx;
+     items[i].hash = hash[i];
+     items[i].hsize = hsize;
+     items[i].sign = sign[i];
+  }
+  sign[3][5] ^= 0x04;      /* искаженное значение s */
+  hash[12][0] ^= 0x01;     /* искаженный хеш-код */
+  sign[35][70] ^= 0x10;    /* искаженное значение r */
+
+ /* проверяем пакет с использованием векторной реализации и без нее */
+  for( j = 0; j < 2; j++ ) {
+     ak_libakrypt_set_option( "verify_batch_lanes", ( ak_int64 )( 1-j ));
+     if( ak_verifykey_context_verify_batch( items, count ) != ak_error_ok ) {
+       printf("incorrect verification of signatures batch\n");
+       result = EXIT_FAILURE;
+     }
+     for( i = 0, errors = 0; i < count; i++ ) {
+        bool_t expected = (( i == 3 ) || ( i == 12 ) || ( i == 35 )) ? ak_false : ak_true;
+        if( items[i].result != expected ) errors++;
+     }
+     printf("batch verification (verify_batch_lanes = %u): %u errors in %u signatures\n",
+                        (unsigned int)( 1-j ), (unsigned int) errors, (unsigned int) count );
+     if( errors ) result = EXIT_FAILURE;
+  }
+
+  for( i = 0; i < 2; i++ ) {
+     ak_verifykey_context_destroy( pk+i );
+     ak_signkey_context_destroy( sk+i );
+  }
+  ak_libakrypt_destroy();
+ return result;
+}
@@ -0,0 +1,230 @@
+/* Тестовый пример, в котором сравниваются результаты вычисления кратных образующих точек
+   эллиптических кривых с помощью таблицы гребенки (функция ak_wpoint_pow_base())
+   и с помощью лесенки Монтгомери (функция ak_wpoint_pow()), а также результаты
+   совместного вычисления кратных точек (функции ak_wpoint_pow_joint() и
+   ak_wpoint_pow_joint_table()) и одновременного приведения точек к аффинной форме
+   (функция ak_wpoint_reduce_batch()). Для кривых, допускающих вычисления на эквивалентной
+   кривой Эдвардса, результаты сравниваются с вычислениями в форме Вейерштрасса.
+   Также проверяются смешанное сложение точек (функция ak_wpoint_add_affine()) и удвоение
+   точек для кривых с коэффициентом a = -3 (функция ak_wpoint_double_minus3()) и проверка
+   значения кофактора кривой функцией ak_wcurve_is_ok().
+   Пример использует неэкспортируемые функции.
+
+   test-wcurve01.c
+*/
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_parameters.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+/* сравнение двух точек после приведения к аффинной форме */
+ static int compare( ak_wpoint wp1, ak_wpoint wp2, ak_wcurve wc )
+{
+  ak_wpoint_reduce( wp1, wc );
+  ak_wpoint_reduce( wp2, wc );
+  if( ak_mpzn_cmp( wp1->x, wp2->x, wc->size ) != 0 ) return 1;
+  if( ak_mpzn_cmp( wp1->y, wp2->y, wc->size ) != 0 ) return 1;
+  if( ak_mpzn_cmp( wp1->z, wp2->z, wc->size ) != 0 ) return 1;
+ return 0;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int test_curve( const char *name, ak_wcurve wc, ak_random generator, const size_t count )
+{
+  ak_mpzn512 k, k2;
+  struct wpoint wp1, wp2, wr, table[64], batch[64];
+  size_t i = 0, errors = 0, iterations = 0;
+
+ /* граничные значения степени */
+  for( i = 0; i < 3; i++ ) {
+     ak_mpzn_set_ui( k, wc->size, i );
+     ak_wpoint_pow_base( &wp1, k, wc->size, wc );
+     ak_wpoint_pow( &wp2, &wc->point, k, wc->size, wc );
+     errors += compare( &wp1, &wp2, wc );
+  }
+  ak_mpzn_set_ui( k, wc->size, 1 );
+  ak_mpzn_sub( k, wc->q, k, wc->size );
+  ak_wpoint_pow_base( &wp1, k, wc->size, wc );
+  ak_wpoint_pow( &wp2, &wc->point, k, wc->size, wc );
+  errors += compare( &wp1, &wp2, wc );
+
+ /* случайные значения степени */
+  for( i = 0; i < count; i++ ) {
+     ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+     ak_wpoint_pow_base( &wp1, k, wc->size, wc );
+     ak_wpoint_pow( &wp2, &wc->point, k, wc->size, wc );
+     errors += compare( &wp1, &wp2, wc );
+  }
+
+ /* совместное вычисление [k]P + [k2]R для случайной точки R */
+  for( i = 0; i < count; i++ ) {
+     ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+     ak_wpoint_pow( &wr, &wc->point, k, wc->size, wc );
+     if( i&0x1 ) ak_wpoint_reduce( &wr, wc );
+     ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+     ak_mpzn_set_random_modulo( k2, wc->q, wc->size, generator );
+     if( i == 0 ) ak_mpzn_set_ui( k, wc->size, 0 );
+     if( i == 1 ) ak_mpzn_set_ui( k2, wc->size, 0 );
+
+     ak_wpoint_pow_joint( &wp1, k, &wr, k2, wc->size, wc );
+     ak_wpoint_odd_multiples( table, 1 << ( i%7 ), &wr, i&0x1, wc );
+     ak_wpoint_pow_joint_table( &wp2, k, table, 2 + i%7, k2, wc->size, wc );
+     errors += compare( &wp1, &wp2, wc );
+
+     ak_wpoint_pow( &wp2, &wc->point, k, wc->size, wc );
+     ak_wpoint_pow( &wr, &wr, k2, wc->size, wc );
+     ak_wpoint_add( &wp2, &wr, wc );
+     errors += compare( &wp1, &wp2, wc );
+  }
+
+
+ /* одновременное приведение к аффинной форме, в том числе бесконечно удаленных точек */
+  ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+  ak_wpoint_pow( &wr, &wc->point, k, wc->size, wc );
+  ak_wpoint_odd_multiples( table, 64, &wr, ak_false, wc );
+  ak_wpoint_set_as_unit( table, wc );
+  ak_wpoint_set_as_unit( table+17, wc );
+  ak_wpoint_set_as_unit( table+63, wc );
+  memcpy( batch, table, sizeof( table ));
+  ak_wpoint_reduce_batch( batch, 64, wc );
+  for( i = 0; i < 64; i++ ) {
+     ak_wpoint_reduce( table+i, wc );
+     if(( ak_mpzn_cmp( table[i].x, batch[i].x, wc->size ) != 0 ) ||
+        ( ak_mpzn_cmp( table[i].y, batch[i].y, wc->size ) != 0 ) ||
+        ( ak_mpzn_cmp( table[i].z, batch[i].z, wc->size ) != 0 )) errors++;
+  }
+
+  iterations = 3*count+68;
+
+ /* смешанное сложение и удвоение, учитывающее вид коэффициента a */
+  for( i = 0; i < count; i++ ) {
+     struct wcurve wcg = *wc;
+     wcg.point_double = NULL;
+
+     ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+     ak_mpzn_set_random_modulo( k2, wc->q, wc->size, generator );
+     ak_wpoint_pow( &wr, &wc->point, k2, wc->size, wc );
+     ak_wpoint_odd_multiples( table, 1, &wr, ak_true, wc );
+     if( i == 0 ) ak_wpoint_set_wpoint( &wp1, &wr, wc );     /* P + P */
+      else if( i == 1 ) { /* P + (-P) */
+             ak_wpoint_set_wpoint( &wp1, &wr, wc );
+             ak_mpzn_sub( wp1.y, wc->p, wp1.y, wc->size );
+           }
+            else if( i == 2 ) ak_wpoint_set_as_unit( &wp1, wc ); /* O + P */
+             else ak_wpoint_pow( &wp1, &wc->point, k, wc->size, wc );
+     ak_wpoint_set_wpoint( &wp2, &wp1, wc );
+     ak_wpoint_add_affine( &wp1, table, wc );
+     ak_wpoint_add( &wp2, &wr, wc );
+     errors += compare( &wp1, &wp2, wc );
+
+     ak_wpoint_set_wpoint( &wp2, &wp1, wc );
+     ak_wpoint_double( &wp1, wc );
+     ak_wpoint_double( &wp2, &wcg );
+     errors += compare( &wp1, &wp2, wc );
+  }
+  iterations += 2*count;
+
+ /* сравнение вычислений на кривой Эдвардса с вычислениями в форме Вейерштрасса */
+  if( wc->edwards != NULL ) {
+    struct wcurve wcw = *wc;
+    wcw.edwards = NULL;
+    for( i = 0; i < count; i++ ) {
+       ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+       ak_mpzn_set_random_modulo( k2, wc->q, wc->size, generator );
+       ak_wpoint_pow_base( &wp1, k, wc->size, wc );
+       ak_wpoint_pow_base( &wp2, k, wc->size, &wcw );
+       errors += compare( &wp1, &wp2, wc );
+
+       ak_wpoint_pow( &wr, &wc->point, k2, wc->size, &wcw );
+       ak_wpoint_pow_joint( &wp1, k, &wr, k2, wc->size, wc );
+       ak_wpoint_pow_joint( &wp2, k, &wr, k2, wc->size, &wcw );
+       errors += compare( &wp1, &wp2, wc );
+    }
+
+   /* точка второго порядка (t, 0) и бесконечно удаленная точка */
+    ak_mpzn_set_ui( k, wc->size, 1 );
+    ak_mpzn_set( wr.x, ( ak_uint64 * )wc->edwards->t, wc->size );
+    ak_mpzn_set_ui( wr.y, wc->size, 0 );
+    ak_wcurve_mul( wr.z, k, wc->r2, wc );
+    if( ak_wpoint_is_ok( &wr, wc ) != ak_true ) errors++;
+    ak_mpzn_set_ui( k, wc->size, 3 );
+    ak_wpoint_pow( &wp1, &wr, k, wc->size, wc );
+    errors += compare( &wp1, &wr, wc );
+    ak_mpzn_set_ui( k, wc->size, 2 );
+    ak_wpoint_pow( &wp1, &wr, k, wc->size, wc );
+    if( ak_mpzn_cmp_ui( wp1.z, wc->size, 0 ) != ak_true ) errors++;
+    ak_wpoint_set_as_unit( &wp2, wc );
+    ak_wpoint_pow( &wp1, &wp2, k, wc->size, wc );
+    if( ak_mpzn_cmp_ui( wp1.z, wc->size, 0 ) != ak_true ) errors++;
+
+    ak_wcurve_base_cache_clear();
+    iterations += 2*count+4;
+  }
+
+  printf("%s: %u errors in %u iterations\n",
+                                            name, (unsigned int) errors, (unsigned int) iterations );
+ return ( errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  size_t i = 0;
+  struct wcurve wc;
+  struct random generator;
+  int result = EXIT_SUCCESS;
+  struct { const char *name; ak_wcurve wc; } curves[] = {
+   { "id_tc26_gost_3410_2012_256_paramSetTest",
+                                       ( ak_wcurve ) &id_tc26_gost_3410_2012_256_paramSetTest },
+   { "id_tc26_gost_3410_2012_256_paramSetA", ( ak_wcurve ) &id_tc26_gost_3410_2012_256_paramSetA },
+   { "id_rfc4357_gost_3410_2001_paramSetA", ( ak_wcurve ) &id_rfc4357_gost_3410_2001_paramSetA },
+   { "id_rfc4357_gost_3410_2001_paramSetB", ( ak_wcurve ) &id_rfc4357_gost_3410_2001_paramSetB },
+   { "id_rfc4357_gost_3410_2001_paramSetC", ( ak_wcurve ) &id_rfc4357_gost_3410_2001_paramSetC },
+   { "id_libakrypt_gost_3410_2012_256_paramSet_N0",
+                                   ( ak_wcurve ) &id_libakrypt_gost_3410_2012_256_paramSet_N0 },
+   { "id_tc26_gost_3410_2012_512_paramSetTest",
+                                       ( ak_wcurve ) &id_tc26_gost_3410_2012_512_paramSetTest },
+   { "id_tc26_gost_3410_2012_512_paramSetA", ( ak_wcurve ) &id_tc26_gost_3410_2012_512_paramSetA },
+   { "id_tc26_gost_3410_2012_512_paramSetB", ( ak_wcurve ) &id_tc26_gost_3410_2012_512_paramSetB },
+   { "id_tc26_gost_3410_2012_512_paramSetC", ( ak_wcurve ) &id_tc26_gost_3410_2012_512_paramSetC }
+  };
+
+  ak_random_context_create_lcg( &generator );
+  for( i = 0; i < sizeof( curves )/sizeof( curves[0] ); i++ )
+     if( test_curve( curves[i].name, curves[i].wc, &generator, 50 ) != EXIT_SUCCESS )
+       result = EXIT_FAILURE;
+
+ /* формулы удвоения для a = -3 не должны применяться к кривой с другим коэффициентом */
+  wc = id_tc26_gost_3410_2012_256_paramSetTest;
+  wc.point_double = ak_wpoint_double_minus3;
+  if( ak_wcurve_is_ok( &wc ) == ak_error_ok ) {
+    printf("incorrect check of doubling formulas for curve with a != -3\n");
+    result = EXIT_FAILURE;
+  }
+
+ /* неверное значение кофактора должно обнаруживаться при проверке параметров кривой */
+  wc = id_tc26_gost_3410_2012_256_paramSetA;
+  wc.cofactor = 1;
+  if( ak_wcurve_is_ok( &wc ) == ak_error_ok ) {
+    printf("incorrect check of cofactor for curve with cofactor 4\n");
+    result = EXIT_FAILURE;
+  }
+  wc = id_tc26_gost_3410_2012_512_paramSetA;
+  wc.cofactor = 2;
+  if( ak_wcurve_is_ok( &wc ) == ak_error_ok ) {
+    printf("incorrect check of cofactor for curve with cofactor 1\n");
+    result = EXIT_FAILURE;
+  }
+ /* повторная проверка встроенных параметров использует кэш */
+  for( i = 0; i < 2; i++ )
+     if( ak_wcurve_is_ok(( ak_wcurve ) &id_tc26_gost_3410_2012_512_paramSetA ) != ak_error_ok ) {
+       printf("incorrect check of cached curve parameters\n");
+       result = EXIT_FAILURE;
+     }
+
+  ak_wcurve_base_cache_clear();
+  ak_random_context_destroy( &generator );
+ return result;
+}
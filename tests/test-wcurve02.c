@@ -0,0 +1,118 @@
+/* Тестовый пример, в котором сравниваются результаты вычисления кратных точек
+   эллиптических кривых различными способами: лесенкой Монтгомери (функция ak_wpoint_pow_ladder()),
+   методом фиксированного окна (функция ak_wpoint_pow_window()), с использованием wNAF
+   представления степени (функция ak_wpoint_pow_wnaf()) и методом гребенки, а также
+   для двух кривых выбирается наиболее быстрый способ вычисления кратных точек
+   (функция ak_wcurve_pow_benchmark()).
+   Пример использует неэкспортируемые функции.
+
+   test-wcurve02.c
+*/
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <ak_tools.h>
+ #include <ak_parameters.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+/* сравнение двух точек после приведения к аффинной форме */
+ static int compare( ak_wpoint wp1, ak_wpoint wp2, ak_wcurve wc )
+{
+  ak_wpoint_reduce( wp1, wc );
+  ak_wpoint_reduce( wp2, wc );
+  if( ak_mpzn_cmp( wp1->x, wp2->x, wc->size ) != 0 ) return 1;
+  if( ak_mpzn_cmp( wp1->y, wp2->y, wc->size ) != 0 ) return 1;
+  if( ak_mpzn_cmp( wp1->z, wp2->z, wc->size ) != 0 ) return 1;
+ return 0;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int test_curve( const char *name, ak_wcurve wc, ak_random generator, const size_t count )
+{
+  ak_mpzn512 k;
+  struct wpoint wp, wr, wq;
+  size_t i = 0, width = 0, errors = 0, iterations = 0;
+
+  for( i = 0; i < count; i++ ) {
+    /* граничные и случайные значения степени */
+     if( i < 3 ) ak_mpzn_set_ui( k, wc->size, i );
+      else if( i == 3 ) ak_mpzn_set( k, wc->q, wc->size );
+       else if( i == 4 ) {
+              ak_mpzn_set_ui( k, wc->size, 1 );
+              ak_mpzn_sub( k, wc->q, k, wc->size );
+            }
+             else ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+
+    /* образующая точка и случайная точка кривой */
+     ak_mpzn_set_random_modulo( wr.x, wc->q, wc->size, generator );
+     ak_wpoint_pow_ladder( &wp, &wc->point, wr.x, wc->size, wc );
+     ak_wpoint_pow_ladder( &wr, &wp, k, wc->size, wc );
+     for( width = 1; width <= ak_wpoint_window_max_width; width++ ) {
+        ak_wpoint_pow_window( &wq, &wp, k, wc->size, width, wc );
+        errors += compare( &wq, &wr, wc );
+        iterations++;
+     }
+     for( width = 2; width <= 8; width++ ) {
+        ak_wpoint_pow_wnaf( &wq, &wp, k, wc->size, width, wc );
+        errors += compare( &wq, &wr, wc );
+        iterations++;
+     }
+     ak_wpoint_pow( &wq, &wp, k, wc->size, wc );
+     errors += compare( &wq, &wr, wc );
+
+     ak_wpoint_pow_ladder( &wr, &wc->point, k, wc->size, wc );
+     ak_wpoint_pow_engine( &wq, &wc->point, k, wc->size, wpoint_pow_comb_engine, 4, wc );
+     errors += compare( &wq, &wr, wc );
+     iterations += 2;
+  }
+
+  printf("%s: %u errors in %u iterations\n",
+                                            name, (unsigned int) errors, (unsigned int) iterations );
+ return ( errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  size_t i = 0;
+  struct random generator;
+  int result = EXIT_SUCCESS;
+  struct wcurve_pow_policy policy;
+  struct { const char *name; ak_wcurve wc; } curves[] = {
+   { "id_tc26_gost_3410_2012_256_paramSetTest",
+                                       ( ak_wcurve ) &id_tc26_gost_3410_2012_256_paramSetTest },
+   { "id_tc26_gost_3410_2012_256_paramSetA", ( ak_wcurve ) &id_tc26_gost_3410_2012_256_paramSetA },
+   { "id_rfc4357_gost_3410_2001_paramSetC", ( ak_wcurve ) &id_rfc4357_gost_3410_2001_paramSetC },
+   { "id_tc26_gost_3410_2012_512_paramSetA", ( ak_wcurve ) &id_tc26_gost_3410_2012_512_paramSetA },
+   { "id_tc26_gost_3410_2012_512_paramSetC", ( ak_wcurve ) &id_tc26_gost_3410_2012_512_paramSetC }
+  };
+
+  ak_random_context_create_lcg( &generator );
+  for( i = 0; i < sizeof( curves )/sizeof( curves[0] ); i++ )
+     if( test_curve( curves[i].name, curves[i].wc, &generator, 12 ) != EXIT_SUCCESS )
+       result = EXIT_FAILURE;
+
+ /* подбираем способ вычисления кратных точек для кривых длины 256 и 512 бит */
+  for( i = 2; i < 4; i++ ) {
+     if( ak_wcurve_pow_benchmark( curves[i].wc, 16 ) != ak_error_ok ) result = EXIT_FAILURE;
+  }
+  for( i = 2; i < 4; i++ ) {
+     ak_wcurve_get_pow_policy( curves[i].wc, &policy );
+     printf("%s: engine = %d, width = %d\n",
+                               curves[i].name, (int) policy.engine, (int) policy.width );
+  }
+ /* способ, подобранный для одной кривой, не влияет на другие кривые того же размера */
+  ak_wcurve_get_pow_policy( curves[0].wc, &policy );
+  if(( policy.engine != ( wpoint_pow_engine_t )
+                          ak_libakrypt_get_option_by_index( ak_option_wcurve256_pow_engine )) ||
+     ( policy.width != ( size_t )
+                          ak_libakrypt_get_option_by_index( ak_option_wcurve256_pow_width ))) {
+    printf("%s: unexpected pow policy\n", curves[0].name );
+    result = EXIT_FAILURE;
+  }
+
+  ak_wcurve_base_cache_clear();
+  ak_random_context_destroy( &generator );
+ return result;
+}